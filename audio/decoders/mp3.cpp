@@ -24,8 +24,14 @@
 
 #ifdef USE_MAD
 
+#include "common/array.h"
 #include "common/debug.h"
+#include "common/endian.h"
+#include "common/md5.h"
+#include "common/mutex.h"
 #include "common/ptr.h"
+#include "common/singleton.h"
+#include "common/str.h"
 #include "common/stream.h"
 #include "common/textconsole.h"
 #include "common/util.h"
@@ -40,6 +46,125 @@
 namespace Audio {
 
 
+#pragma mark -
+#pragma mark --- MP3 frame index ---
+#pragma mark -
+
+
+/**
+ * The positions of every kInterval-th frame of an MP3 stream, so seeking does
+ * not need to walk over all frame headers from the start of the stream.
+ */
+struct MP3FrameIndex {
+	enum {
+		kInterval = 16
+	};
+
+	struct Entry {
+		uint32 offset;		// position of the frame in the input stream
+		mad_timer_t time;	// playback time at the start of the frame
+	};
+
+	Common::Array<Entry> entries;
+	mad_timer_t totalTime;
+	bool valid;				// whether the whole stream could be scanned
+
+	/** Returns the last entry starting at or before the given time, or 0. */
+	const Entry *find(const mad_timer_t &time) const {
+		uint low = 0, high = entries.size();
+		while (low < high) {
+			const uint mid = (low + high) / 2;
+			if (mad_timer_compare(entries[mid].time, time) <= 0)
+				low = mid + 1;
+			else
+				high = mid;
+		}
+
+		return low ? &entries[low - 1] : 0;
+	}
+};
+
+typedef Common::SharedPtr<MP3FrameIndex> MP3FrameIndexPtr;
+
+/**
+ * The frame indices of the most recently used MP3 streams. Engines tend to
+ * open the same speech and music files over and over again, which would
+ * need a scan of the whole file each time otherwise.
+ *
+ * Streams might be created and destroyed by different threads, so all copies
+ * of the shared pointers are made while holding the mutex.
+ */
+class MP3FrameIndexCache : public Common::Singleton<MP3FrameIndexCache> {
+public:
+	/** Looks up the index of a stream, and marks it as recently used. */
+	bool find(const Common::String &key, MP3FrameIndexPtr &index) {
+		Common::StackLock lock(_mutex);
+		for (uint i = 0; i < kSize; i++) {
+			if (_items[i].index && _items[i].key == key) {
+				_items[i].lastUsed = ++_time;
+				index = _items[i].index;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	/**
+	 * Adds an index, replacing the one with the same key or else the least
+	 * recently used one.
+	 */
+	void add(const Common::String &key, const MP3FrameIndexPtr &index) {
+		Common::StackLock lock(_mutex);
+		Item *oldest = &_items[0];
+		for (uint i = 0; i < kSize; i++) {
+			if (_items[i].index && _items[i].key == key) {
+				oldest = &_items[i];
+				break;
+			}
+			if (!_items[i].index || (oldest->index && _items[i].lastUsed < oldest->lastUsed))
+				oldest = &_items[i];
+		}
+
+		oldest->key = key;
+		oldest->index = index;
+		oldest->lastUsed = ++_time;
+	}
+
+	/** Drops a reference to an index. */
+	void release(MP3FrameIndexPtr &index) {
+		Common::StackLock lock(_mutex);
+		index.reset();
+	}
+
+private:
+	friend class Common::Singleton<SingletonBaseType>;
+	MP3FrameIndexCache() : _time(0) {}
+
+	enum {
+		kSize = 64
+	};
+
+	struct Item {
+		Common::String key;
+		MP3FrameIndexPtr index;
+		uint32 lastUsed;
+	};
+
+	Common::Mutex _mutex;
+	Item _items[kSize];
+	uint32 _time;
+};
+
+} // End of namespace Audio
+
+namespace Common {
+DECLARE_SINGLETON(Audio::MP3FrameIndexCache);
+}
+
+namespace Audio {
+
+
 #pragma mark -
 #pragma mark --- MP3 (MAD) stream ---
 #pragma mark -
@@ -61,6 +186,21 @@ protected:
 	Timestamp _length;
 	mad_timer_t _totalTime;
 
+	// Built when the stream is scanned for its length, or on the first seek
+	// if the length is known from a Xing or VBRI header
+	MP3FrameIndexPtr _index;
+	Common::String _indexKey;
+
+	enum {
+		// The number of bytes identifying a stream in the MP3FrameIndexCache,
+		// together with its size
+		INDEX_KEY_SIZE = 8192,
+		// Smaller streams are scanned quickly enough, so they are not cached
+		INDEX_CACHE_MIN_SIZE = 256 * 1024,
+		// The number of index entries checked before using a cached index
+		INDEX_CHECK_ENTRIES = 4
+	};
+
 	mad_stream _stream;
 	mad_frame _frame;
 	mad_synth _synth;
@@ -89,9 +229,14 @@ protected:
 	void decodeMP3Data();
 	void readMP3Data();
 
-	void initStream();
+	void initStream(uint32 offset = 0, mad_timer_t time = mad_timer_zero);
 	void readHeader();
 	void deinitStream();
+
+	void findIndex();
+	void buildIndex();
+	bool checkIndex(const MP3FrameIndex &index);
+	bool readVBRFrameCount(uint32 &frames) const;
 };
 
 MP3Stream::MP3Stream(Common::SeekableReadStream *inStream, DisposeAfterUse::Flag dispose) :
@@ -106,22 +251,33 @@ MP3Stream::MP3Stream(Common::SeekableReadStream *inStream, DisposeAfterUse::Flag
 	// may read a few bytes beyond the end of the input buffer).
 	memset(_buf + BUFFER_SIZE, 0, MAD_BUFFER_GUARD);
 
-	// Calculate the length of the stream
-	initStream();
+	// Calculate the length of the stream. It is known if the encoder stored
+	// the number of frames, else the stream has to be scanned, unless that
+	// was done before.
+	mad_timer_t totalTime = mad_timer_zero;
+	bool valid = false;
+	uint32 frames;
 
-	while (_state != MP3_STATE_EOS)
-		readHeader();
+	initStream();
+	readHeader();
 
-	// To rule out any invalid sample rate to be encountered here, say in case the
-	// MP3 stream is invalid, we just check the MAD error code here.
-	// We need to assure this, since else we might trigger an assertion in Timestamp
-	// (When getRate() returns 0 or a negative number to be precise).
-	// Note that we allow "MAD_ERROR_BUFLEN" as error code here, since according
-	// to mad.h it is also set on EOF.
-	if ((_stream.error == MAD_ERROR_NONE || _stream.error == MAD_ERROR_BUFLEN) && getRate() > 0)
-		_length = Timestamp(mad_timer_count(_totalTime, MAD_UNITS_MILLISECONDS), getRate());
+	if (_state == MP3_STATE_READY && readVBRFrameCount(frames)) {
+		// The header frame itself is decoded as silence, too
+		totalTime = _frame.header.duration;
+		mad_timer_multiply(&totalTime, frames + 1);
+		valid = true;
+	}
 
 	deinitStream();
+	_state = MP3_STATE_INIT;
+
+	if (!valid)
+		findIndex();
+
+	if (_index) {
+		totalTime = _index->totalTime;
+		valid = _index->valid;
+	}
 
 	// Reinit stream
 	_state = MP3_STATE_INIT;
@@ -129,10 +285,155 @@ MP3Stream::MP3Stream(Common::SeekableReadStream *inStream, DisposeAfterUse::Flag
 	// Decode the first chunk of data. This is necessary so that _frame
 	// is setup and isStereo() and getRate() return correct results.
 	decodeMP3Data();
+
+	// To rule out any invalid sample rate to be encountered here, say in case the
+	// MP3 stream is invalid, we need to check whether the stream could be
+	// scanned, since else we might trigger an assertion in Timestamp
+	// (When getRate() returns 0 or a negative number to be precise).
+	if (valid && getRate() > 0)
+		_length = Timestamp(mad_timer_count(totalTime, MAD_UNITS_MILLISECONDS), getRate());
 }
 
 MP3Stream::~MP3Stream() {
 	deinitStream();
+
+	if (_index)
+		MP3FrameIndexCache::instance().release(_index);
+}
+
+/**
+ * Takes the index of the stream from the MP3FrameIndexCache if it is there
+ * and fits the stream, else builds it and adds it to the cache.
+ */
+void MP3Stream::findIndex() {
+	const int32 size = _inStream->size();
+	if (size < INDEX_CACHE_MIN_SIZE) {
+		buildIndex();
+		return;
+	}
+
+	if (_indexKey.empty()) {
+		const int32 pos = _inStream->pos();
+		_inStream->seek(0, SEEK_SET);
+		_indexKey = Common::computeStreamMD5AsString(*_inStream, INDEX_KEY_SIZE);
+		_indexKey += Common::String::format(":%d", size);
+		_inStream->seek(pos, SEEK_SET);
+	}
+
+	// Different streams may still start with the same data and have the
+	// same size
+	if (MP3FrameIndexCache::instance().find(_indexKey, _index)) {
+		if (checkIndex(*_index))
+			return;
+		MP3FrameIndexCache::instance().release(_index);
+	}
+
+	buildIndex();
+	MP3FrameIndexCache::instance().add(_indexKey, _index);
+}
+
+/**
+ * Checks whether some of the indexed frames, spread over the whole index,
+ * are at the same offsets in this stream and have the same format.
+ */
+bool MP3Stream::checkIndex(const MP3FrameIndex &index) {
+	const uint entries = index.entries.size();
+	if (!entries)
+		return true;
+
+	const int32 pos = _inStream->pos();
+	bool valid = true;
+	byte first[4];
+
+	for (uint i = 0; i < INDEX_CHECK_ENTRIES && valid; i++) {
+		const uint entry = (INDEX_CHECK_ENTRIES > 1) ? (entries - 1) * i / (INDEX_CHECK_ENTRIES - 1) : 0;
+		byte header[4];
+
+		_inStream->seek(index.entries[entry].offset, SEEK_SET);
+		if (_inStream->read(header, 4) != 4 || header[0] != 0xFF || (header[1] & 0xE0) != 0xE0) {
+			valid = false;
+		} else if (!i) {
+			memcpy(first, header, 4);
+		} else {
+			// The version, layer and sample rate stay the same
+			valid = header[1] == first[1] && (header[2] & 0x0C) == (first[2] & 0x0C);
+		}
+	}
+
+	_inStream->seek(pos, SEEK_SET);
+	return valid;
+}
+
+void MP3Stream::buildIndex() {
+	MP3FrameIndex *index = new MP3FrameIndex();
+	uint32 frame = 0;
+
+	initStream();
+
+	while (_state != MP3_STATE_EOS) {
+		const mad_timer_t start = _totalTime;
+		readHeader();
+		if (_state == MP3_STATE_EOS)
+			break;
+
+		if (frame++ % MP3FrameIndex::kInterval == 0) {
+			MP3FrameIndex::Entry entry;
+			entry.offset = _inStream->pos() - (_stream.bufend - _stream.this_frame);
+			entry.time = start;
+			index->entries.push_back(entry);
+		}
+	}
+
+	// Note that we allow "MAD_ERROR_BUFLEN" as error code here, since according
+	// to mad.h it is also set on EOF.
+	index->totalTime = _totalTime;
+	index->valid = (_stream.error == MAD_ERROR_NONE || _stream.error == MAD_ERROR_BUFLEN) && _frame.header.samplerate > 0;
+
+	deinitStream();
+	_state = MP3_STATE_INIT;
+
+	_index = MP3FrameIndexPtr(index);
+}
+
+bool MP3Stream::readVBRFrameCount(uint32 &frames) const {
+	// Both headers are stored in the data of the first frame, which has just
+	// been read by readHeader()
+	const mad_header &header = _frame.header;
+	const byte *data = _stream.this_frame;
+	const uint32 size = _stream.bufend - _stream.this_frame;
+
+	if (header.layer != MAD_LAYER_III)
+		return false;
+
+	// The Xing header, or the Info header written by LAME for CBR streams,
+	// follows the side information
+	uint32 pos = (header.flags & MAD_FLAG_PROTECTION) ? 6 : 4;
+	if (header.flags & MAD_FLAG_LSF_EXT)
+		pos += (header.mode == MAD_MODE_SINGLE_CHANNEL) ? 9 : 17;
+	else
+		pos += (header.mode == MAD_MODE_SINGLE_CHANNEL) ? 17 : 32;
+
+	if (pos + 12 <= size) {
+		const uint32 tag = READ_BE_UINT32(data + pos);
+		if (tag == MKTAG('X','i','n','g') || tag == MKTAG('I','n','f','o')) {
+			// The frame count is optional
+			if (!(READ_BE_UINT32(data + pos + 4) & 1))
+				return false;
+
+			frames = READ_BE_UINT32(data + pos + 8);
+			return frames != 0;
+		}
+	}
+
+	// The VBRI header written by the Fraunhofer encoder is always at the same
+	// position
+	pos = 4 + 32;
+	if (pos + 18 <= size && READ_BE_UINT32(data + pos) == MKTAG('V','B','R','I')) {
+		frames = READ_BE_UINT32(data + pos + 14);
+		return frames != 0;
+	}
+
+	return false;
 }
 
 void MP3Stream::decodeMP3Data() {
@@ -220,8 +521,19 @@ bool MP3Stream::seek(const Timestamp &where) {
 	mad_timer_t destination;
 	mad_timer_set(&destination, time / 1000, time % 1000, 1000);
 
-	if (_state != MP3_STATE_READY || mad_timer_compare(destination, _totalTime) < 0)
-		initStream();
+	if (!_index)
+		findIndex();
+
+	// Continue from the last indexed frame before the destination, unless
+	// the current position is closer
+	const MP3FrameIndex::Entry *entry = _index->find(destination);
+	if (_state != MP3_STATE_READY || mad_timer_compare(destination, _totalTime) < 0 ||
+	    (entry && mad_timer_compare(entry->time, _totalTime) > 0)) {
+		if (entry)
+			initStream(entry->offset, entry->time);
+		else
+			initStream();
+	}
 
 	while (mad_timer_compare(destination, _totalTime) > 0 && _state != MP3_STATE_EOS)
 		readHeader();
@@ -231,7 +543,7 @@ bool MP3Stream::seek(const Timestamp &where) {
 	return (_state != MP3_STATE_EOS);
 }
 
-void MP3Stream::initStream() {
+void MP3Stream::initStream(uint32 offset, mad_timer_t time) {
 	if (_state != MP3_STATE_INIT)
 		deinitStream();
 
@@ -241,8 +553,8 @@ void MP3Stream::initStream() {
 	mad_synth_init(&_synth);
 
 	// Reset the stream data
-	_inStream->seek(0, SEEK_SET);
-	_totalTime = mad_timer_zero;
+	_inStream->seek(offset, SEEK_SET);
+	_totalTime = time;
 	_posInFrame = 0;
 
 	// Update state
@@ -341,6 +653,10 @@ int MP3Stream::readBuffer(int16 *buffer, const int numSamples) {
 #pragma mark --- MP3 factory functions ---
 #pragma mark -
 
+void destroyMP3FrameIndexCache() {
+	MP3FrameIndexCache::destroy();
+}
+
 SeekableAudioStream *makeMP3Stream(
 	Common::SeekableReadStream *stream,
 	DisposeAfterUse::Flag disposeAfterUse) {
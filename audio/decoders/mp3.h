@@ -65,6 +65,12 @@ SeekableAudioStream *makeMP3Stream(
 	Common::SeekableReadStream *stream,
 	DisposeAfterUse::Flag disposeAfterUse);
 
+/**
+ * Frees the frame indices kept for seeking in recently used MP3 streams.
+ * This is called on shutdown.
+ */
+void destroyMP3FrameIndexCache();
+
 } // End of namespace Audio
 
 #endif // #ifdef USE_MAD
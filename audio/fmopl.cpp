@@ -20,11 +20,14 @@
  */
 
 #include "audio/fmopl.h"
+#include "audio/opldump.h"
 
 #include "audio/softsynth/opl/dosbox.h"
 #include "audio/softsynth/opl/mame.h"
 
 #include "common/config-manager.h"
+#include "common/debug.h"
+#include "common/file.h"
 #include "common/textconsole.h"
 #include "common/translation.h"
 
@@ -38,12 +41,6 @@ enum OplEmulator {
 	kDOSBox = 2
 };
 
-OPL::OPL() {
-	if (_hasInstance)
-		error("There are multiple OPL output instances running");
-	_hasInstance = true;
-}
-
 const Config::EmulatorDescription Config::_drivers[] = {
 	{ "auto", "<default>", kAuto, kFlagOpl2 | kFlagDualOpl2 | kFlagOpl3 },
 	{ "mame", _s("MAME OPL emulator"), kMame, kFlagOpl2 },
@@ -131,28 +128,50 @@ OPL *Config::create(DriverId driver, OplType type) {
 		}
 	}
 
+	OPL *opl = 0;
 	switch (driver) {
 	case kMame:
 		if (type == kOpl2)
-			return new MAME::OPL();
+			opl = new MAME::OPL();
 		else
 			warning("MAME OPL emulator only supports OPL2 emulation");
-			return 0;
+		break;
 
 #ifndef DISABLE_DOSBOX_OPL
 	case kDOSBox:
-		return new DOSBox::OPL(type);
+		opl = new DOSBox::OPL(type);
+		break;
 #endif
 
 	default:
 		warning("Unsupported OPL emulator %d", driver);
 		// TODO: Maybe we should add some dummy emulator too, which just outputs
 		// silence as sound?
-		return 0;
+		break;
 	}
+
+	if (opl && ConfMan.hasKey("opl_capture"))
+		opl = createCapture(opl, type);
+
+	return opl;
 }
 
-bool OPL::_hasInstance = false;
+OPL *Config::createCapture(OPL *opl, OplType type) {
+	// Every emulator created gets a dump of its own, numbered in the order
+	// they were created in
+	static int dumpCount = 0;
+	const Common::String filename = Common::String::format("%s%d.opl", ConfMan.get("opl_capture").c_str(), dumpCount++);
+
+	Common::DumpFile *dump = new Common::DumpFile();
+	if (!dump->open(filename)) {
+		warning("Could not open '%s' for capturing the OPL register writes", filename.c_str());
+		delete dump;
+		return opl;
+	}
+
+	debug(1, "Capturing the OPL register writes to '%s'", filename.c_str());
+	return new CaptureOPL(opl, type, dump);
+}
 
 } // End of namespace OPL
 
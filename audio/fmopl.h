@@ -88,15 +88,22 @@ public:
 	static OPL *create(OplType type = kOpl2);
 
 private:
+	/**
+	 * Wraps an emulator in a CaptureOPL writing to a new file named after
+	 * the "opl_capture" config key.
+	 */
+	static OPL *createCapture(OPL *opl, OplType type);
+
 	static const EmulatorDescription _drivers[];
 };
 
+/**
+ * An OPL emulator. Any number of them can be used at the same time, each one
+ * must only be accessed by one thread at a time though.
+ */
 class OPL {
-private:
-	static bool _hasInstance;
 public:
-	OPL();
-	virtual ~OPL() { _hasInstance = false; }
+	virtual ~OPL() {}
 
 	/**
 	 * Initializes the OPL emulator.
@@ -21,8 +21,10 @@
  */
 
 #include "common/util.h"
+#include "common/perfcounters.h"
 #include "common/system.h"
 #include "common/textconsole.h"
+#include "common/trace.h"
 
 #include "audio/mixer_intern.h"
 #include "audio/rate.h"
@@ -177,6 +179,8 @@ MixerImpl::MixerImpl(OSystem *system, uint sampleRate)
 
 	assert(sampleRate > 0);
 
+	_traceBuffer = TraceMan.createBuffer("mixer");
+
 	for (int i = 0; i != NUM_CHANNELS; i++)
 		_channels[i] = 0;
 }
@@ -267,6 +271,9 @@ void MixerImpl::playStream(
 int MixerImpl::mixCallback(byte *samples, uint len) {
 	assert(samples);
 
+	TRACE_SCOPE_BUFFER(_traceBuffer, "audio", "mixCallback");
+	Common::PerfTimer timer(Common::kPerfMixer);
+
 	Common::StackLock lock(_mutex);
 
 	int16 *buf = (int16 *)samples;
@@ -27,6 +27,10 @@
 #include "common/mutex.h"
 #include "audio/mixer.h"
 
+namespace Common {
+class TraceBuffer;
+}
+
 namespace Audio {
 
 /**
@@ -70,6 +74,9 @@ private:
 	SoundTypeSettings _soundTypeSettings[4];
 	Channel *_channels[NUM_CHANNELS];
 
+	/** The mixer callback runs in its own thread, so it needs its own trace buffer */
+	Common::TraceBuffer *_traceBuffer;
+
 
 public:
 
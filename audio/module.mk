@@ -13,6 +13,7 @@ MODULE_OBJS := \
 	mpu401.o \
 	musicplugin.o \
 	null.o \
+	opldump.o \
 	timestamp.o \
 	decoders/aac.o \
 	decoders/adpcm.o \
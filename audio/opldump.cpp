@@ -0,0 +1,222 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include "audio/opldump.h"
+
+#include "common/endian.h"
+#include "common/stream.h"
+#include "common/util.h"
+
+namespace OPL {
+
+enum {
+	kDumpVersion = 1
+};
+
+CaptureOPL::CaptureOPL(OPL *opl, Config::OplType type, Common::WriteStream *dump, DisposeAfterUse::Flag disposeDump)
+	: _opl(opl), _type(type), _dump(dump), _disposeDump(disposeDump), _wait(0) {
+	_address[0] = _address[1] = 0;
+	_dump->writeUint32BE(MKTAG('O', 'P', 'L', 'D'));
+	_dump->writeByte(kDumpVersion);
+	_dump->writeByte(type);
+}
+
+CaptureOPL::~CaptureOPL() {
+	flushWait();
+	_dump->writeByte(kDumpEnd);
+	_dump->finalize();
+
+	if (_disposeDump == DisposeAfterUse::YES)
+		delete _dump;
+	delete _opl;
+}
+
+bool CaptureOPL::init(int rate) {
+	flushWait();
+	_dump->writeByte(kDumpInit);
+	_dump->writeUint32LE(rate);
+	return _opl->init(rate);
+}
+
+void CaptureOPL::reset() {
+	flushWait();
+	_dump->writeByte(kDumpReset);
+	_opl->reset();
+}
+
+// The timers are only part of the first register set, the registers 0x102 to
+// 0x104 of an OPL3 control other things
+static bool isTimerRegister(uint16 reg) {
+	return reg >= 0x02 && reg <= 0x04;
+}
+
+void CaptureOPL::write(int a, int v) {
+	// The Dual OPL2 has an address latch for each chip, the ports with bit 3
+	// set write to both chips at once
+	const bool dual = _type == Config::kDualOpl2;
+	const bool both = dual && (a & 8);
+	const uint index = dual ? (a & 2) >> 1 : 0;
+
+	if (!(a & 1)) {
+		if (both) {
+			_address[0] = _address[1] = v & 0xFF;
+		} else {
+			_address[index] = v & 0xFF;
+			// Only the OPL3 has a second register set
+			if (_type == Config::kOpl3 && (a & 2))
+				_address[index] |= 0x100;
+		}
+		writeCommand(kDumpWrite, a, v);
+	} else if (both) {
+		// Only leave out the chips which have a timer register selected
+		const bool timer0 = isTimerRegister(_address[0]);
+		const bool timer1 = isTimerRegister(_address[1]);
+		if (!timer0 && !timer1)
+			writeCommand(kDumpWrite, a, v);
+		else if (!timer0)
+			writeCommand(kDumpWrite, a & ~0xA, v);
+		else if (!timer1)
+			writeCommand(kDumpWrite, (a & ~0xA) | 2, v);
+	} else if (!isTimerRegister(_address[index])) {
+		writeCommand(kDumpWrite, a, v);
+	}
+	_opl->write(a, v);
+}
+
+byte CaptureOPL::read(int a) {
+	return _opl->read(a);
+}
+
+void CaptureOPL::writeReg(int r, int v) {
+	// Only the OPL3 has a second register set, the OPL2 ignores the upper
+	// bits and the Dual OPL2 writes to both chips
+	if (!isTimerRegister(_type == Config::kOpl3 ? r : (r & 0xFF)))
+		writeCommand(kDumpWriteReg, r, v);
+	_opl->writeReg(r, v);
+}
+
+void CaptureOPL::readBuffer(int16 *buffer, int length) {
+	// The emulators don't give exactly the same output when the samples are
+	// generated in different chunks, so every call gets its own wait
+	flushWait();
+	_wait = _opl->isStereo() ? length / 2 : length;
+	_opl->readBuffer(buffer, length);
+}
+
+void CaptureOPL::flushWait() {
+	if (!_wait)
+		return;
+
+	_dump->writeByte(kDumpWait);
+	_dump->writeUint32LE(_wait);
+	_wait = 0;
+}
+
+void CaptureOPL::writeCommand(DumpCommand command, uint16 address, uint8 value) {
+	flushWait();
+	_dump->writeByte(command);
+	_dump->writeUint16LE(address);
+	_dump->writeByte(value);
+}
+
+DumpPlayer::DumpPlayer(Common::ReadStream *dump) : _dump(dump), _wait(0), _rate(0), _finished(false) {
+}
+
+bool DumpPlayer::readHeader(Config::OplType &type) {
+	if (_dump->readUint32BE() != MKTAG('O', 'P', 'L', 'D'))
+		return false;
+	if (_dump->readByte() != kDumpVersion)
+		return false;
+
+	type = (Config::OplType)_dump->readByte();
+	return !_dump->err() && !_dump->eos();
+}
+
+int DumpPlayer::play(OPL *opl, int16 *buffer, int length) {
+	const int channels = opl->isStereo() ? 2 : 1;
+	int done = 0;
+
+	while (done < length) {
+		if (!_wait && !executeCommands(opl))
+			break;
+
+		// Keep the recorded calls whole unless the buffer is too small for one
+		if (done && _wait * channels > (uint32)(length - done))
+			break;
+
+		const int samples = MIN<uint32>(_wait, (length - done) / channels) * channels;
+		opl->readBuffer(buffer + done, samples);
+		_wait -= samples / channels;
+		done += samples;
+
+		// Less than a sample per channel left
+		if (!samples)
+			break;
+	}
+
+	return done;
+}
+
+bool DumpPlayer::executeCommands(OPL *opl) {
+	while (!_finished) {
+		const byte command = _dump->readByte();
+		if (_dump->err() || _dump->eos())
+			break;
+
+		switch (command) {
+		case kDumpInit:
+			_rate = _dump->readUint32LE();
+			opl->init(_rate);
+			break;
+
+		case kDumpReset:
+			opl->reset();
+			break;
+
+		case kDumpWrite: {
+			const uint16 port = _dump->readUint16LE();
+			opl->write(port, _dump->readByte());
+			break;
+		}
+
+		case kDumpWriteReg: {
+			const uint16 reg = _dump->readUint16LE();
+			opl->writeReg(reg, _dump->readByte());
+			break;
+		}
+
+		case kDumpWait:
+			_wait = _dump->readUint32LE();
+			if (_wait)
+				return true;
+			break;
+
+		default:
+			_finished = true;
+			break;
+		}
+	}
+
+	_finished = true;
+	return false;
+}
+
+} // End of namespace OPL
@@ -0,0 +1,146 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef AUDIO_OPLDUMP_H
+#define AUDIO_OPLDUMP_H
+
+#include "audio/fmopl.h"
+
+#include "common/types.h"
+
+namespace Common {
+class ReadStream;
+class WriteStream;
+}
+
+namespace OPL {
+
+/**
+ * OPL register dumps store the calls a music driver made to its OPL emulator,
+ * so that they can be rendered again without running the game.
+ *
+ * A dump starts with the magic "OPLD", a version byte and the Config::OplType
+ * byte of the emulator. Every command which follows starts with one of the
+ * DumpCommand bytes. All numbers are little endian.
+ */
+enum DumpCommand {
+	kDumpEnd = 0,		///< End of the dump
+	kDumpInit = 1,		///< OPL::init(), followed by the uint32 sample rate
+	kDumpReset = 2,		///< OPL::reset()
+	kDumpWrite = 3,		///< OPL::write(), followed by the uint16 port and the value byte
+	kDumpWriteReg = 4,	///< OPL::writeReg(), followed by the uint16 register and the value byte
+	kDumpWait = 5		///< OPL::readBuffer(), followed by the uint32 number of samples per channel
+};
+
+/**
+ * An OPL emulator recording all calls to another one into a dump.
+ *
+ * Writes to the timer registers are left out, since they don't change the
+ * output and need a running OSystem. Every readBuffer() call is recorded as a
+ * wait of its own, so that a replay can generate the samples in the same
+ * chunks.
+ */
+class CaptureOPL : public OPL {
+public:
+	/**
+	 * @param opl		the emulator to forward all calls to, which is deleted
+	 *					along with this one
+	 * @param type		the type the emulator was created with
+	 * @param dump		the stream to write the dump to, which is finalized
+	 *					along with this one
+	 * @param disposeDump	whether to delete the stream along with this one
+	 */
+	CaptureOPL(OPL *opl, Config::OplType type, Common::WriteStream *dump,
+	           DisposeAfterUse::Flag disposeDump = DisposeAfterUse::YES);
+	~CaptureOPL();
+
+	bool init(int rate);
+	void reset();
+
+	void write(int a, int v);
+	byte read(int a);
+
+	void writeReg(int r, int v);
+
+	void readBuffer(int16 *buffer, int length);
+	bool isStereo() const { return _opl->isStereo(); }
+
+private:
+	void flushWait();
+	void writeCommand(DumpCommand command, uint16 address, uint8 value);
+
+	OPL *_opl;
+	Config::OplType _type;
+	Common::WriteStream *_dump;
+	DisposeAfterUse::Flag _disposeDump;
+	uint16 _address[2];	///< Registers last selected through write(), one per Dual OPL2 chip
+	uint32 _wait;		///< Samples generated since the last command
+};
+
+/**
+ * Plays a dump recorded by CaptureOPL on another emulator, generating the
+ * samples in between the commands.
+ */
+class DumpPlayer {
+public:
+	/**
+	 * @param dump	the stream to read the dump from, which has to stay valid
+	 *				while playing
+	 */
+	DumpPlayer(Common::ReadStream *dump);
+
+	/**
+	 * Reads the header of the dump.
+	 *
+	 * @param type	set to the type of the recorded emulator
+	 * @return		false if the stream doesn't contain a dump
+	 */
+	bool readHeader(Config::OplType &type);
+
+	/**
+	 * Generates up to length samples like OPL::readBuffer(), executing the
+	 * recorded commands in between. The samples are generated in the chunks
+	 * they were recorded in, which are only split when length is too small
+	 * for one of them.
+	 *
+	 * @return	the number of samples generated, which is less than length
+	 *			when the next chunk doesn't fit or at the end of the dump
+	 */
+	int play(OPL *opl, int16 *buffer, int length);
+
+	/** Returns the sample rate of the last init command, 0 if there was none. */
+	int getRate() const { return _rate; }
+
+	bool isFinished() const { return _finished; }
+
+private:
+	/** Executes commands until reaching a wait, returns false at the end. */
+	bool executeCommands(OPL *opl);
+
+	Common::ReadStream *_dump;
+	uint32 _wait;		///< Samples left to generate before the next command
+	int _rate;
+	bool _finished;
+};
+
+} // End of namespace OPL
+
+#endif
@@ -975,6 +975,7 @@ private:
 
 	void generateSamples(int16 *buf, int len);
 	void onTimer();
+	void applyRegisterWrite(int reg, int value);
 	void partKeyOn(AdLibPart *part, const AdLibInstrument *instr, byte note, byte velocity, const AdLibInstrument *second, byte pan);
 	void partKeyOff(AdLibPart *part, byte note);
 
@@ -1437,6 +1438,10 @@ int MidiDriver_ADLIB::open() {
 
 	_regCache = (byte *)calloc(256, 1);
 
+	// All writes to the OPL go through adlibWrite(), so the OPL can render
+	// whole mixer buffers between the writes of the timer ticks
+	setRegisterQueueEnabled(true);
+
 	adlibWrite(8, 0x40);
 	adlibWrite(0xBD, 0x00);
 #ifdef ENABLE_OPL3
@@ -1470,6 +1475,7 @@ void MidiDriver_ADLIB::close() {
 	}
 
 	// Turn off the OPL emulation
+	setRegisterQueueEnabled(false);
 	delete _opl;
 	_opl = 0;
 
@@ -1596,7 +1602,7 @@ void MidiDriver_ADLIB::adlibWrite(byte reg, byte value) {
 #endif
 	_regCache[reg] = value;
 
-	_opl->writeReg(reg, value);
+	writeRegister(reg, value);
 }
 
 #ifdef ENABLE_OPL3
@@ -1611,10 +1617,14 @@ void MidiDriver_ADLIB::adlibWriteSecondary(byte reg, byte value) {
 #endif
 	_regCacheSecondary[reg] = value;
 
-	_opl->writeReg(reg | 0x100, value);
+	writeRegister(reg | 0x100, value);
 }
 #endif
 
+void MidiDriver_ADLIB::applyRegisterWrite(int reg, int value) {
+	_opl->writeReg(reg, value);
+}
+
 void MidiDriver_ADLIB::generateSamples(int16 *data, int len) {
 	if (_opl->isStereo()) {
 		len *= 2;
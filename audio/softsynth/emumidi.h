@@ -26,6 +26,10 @@
 #include "audio/mididrv.h"
 #include "audio/mixer.h"
 
+#include "common/array.h"
+#include "common/mutex.h"
+#include "common/util.h"
+
 class MidiDriver_Emulated : public Audio::AudioStream, public MidiDriver {
 protected:
 	bool _isOpen;
@@ -43,12 +47,66 @@ private:
 	int _nextTick;
 	int _samplesPerTick;
 
+	struct RegisterWrite {
+		int time;		// sample in the current buffer the write happens at
+		int reg;
+		int value;
+	};
+
+	// Held while the queued writes are rendered, so only the mixer thread
+	// sees _rendering set. Writes from other threads wait until the buffer
+	// is done and are then queued for the next one.
+	Common::Mutex _registerMutex;
+	Common::Array<RegisterWrite> _registerWrites;
+	int _writeTime;
+	bool _queueRegisterWrites;
+	bool _rendering;
+
 protected:
 	int _baseFreq;
 
 	virtual void generateSamples(int16 *buf, int len) = 0;
 	virtual void onTimer() {}
 
+	/**
+	 * Makes writeRegister() queue register writes with the sample they
+	 * happen at, and discards all writes queued so far. readBuffer() then
+	 * runs the timer for the whole buffer first and generates the samples in
+	 * between the writes, instead of in steps of a single tick. Drivers may
+	 * only use this if all changes to the emulated chip they make outside of
+	 * generateSamples() go through writeRegister().
+	 */
+	void setRegisterQueueEnabled(bool enable) {
+		Common::StackLock lock(_registerMutex);
+		_queueRegisterWrites = enable;
+
+		// Writes queued for a chip which was closed meanwhile are stale
+		_registerWrites.clear();
+	}
+
+	/**
+	 * Writes to a register of the emulated chip. The write is passed to
+	 * applyRegisterWrite() right away if the register queue is disabled, or
+	 * if it is called from generateSamples().
+	 */
+	void writeRegister(int reg, int value) {
+		Common::StackLock lock(_registerMutex);
+		if (!_queueRegisterWrites || _rendering) {
+			applyRegisterWrite(reg, value);
+			return;
+		}
+
+		// Writes from other threads are applied at the current tick, but
+		// never before writes queued earlier
+		RegisterWrite write;
+		write.time = _registerWrites.empty() ? _writeTime : MAX(_writeTime, _registerWrites.back().time);
+		write.reg = reg;
+		write.value = value;
+		_registerWrites.push_back(write);
+	}
+
+	virtual void applyRegisterWrite(int reg, int value) {}
+
 public:
 	MidiDriver_Emulated(Audio::Mixer *mixer) :
 		_mixer(mixer),
@@ -57,6 +115,9 @@ public:
 		_timerParam(0),
 		_nextTick(0),
 		_samplesPerTick(0),
+		_writeTime(0),
+		_queueRegisterWrites(false),
+		_rendering(false),
 		_baseFreq(250) {
 	}
 
@@ -92,6 +153,11 @@ public:
 		int len = numSamples / stereoFactor;
 		int step;
 
+		if (_queueRegisterWrites) {
+			readBufferQueued(data, len, stereoFactor);
+			return numSamples;
+		}
+
 		do {
 			step = len;
 			if (step > (_nextTick >> FIXP_SHIFT))
@@ -119,6 +185,60 @@ public:
 	virtual bool endOfData() const {
 		return false;
 	}
+
+private:
+	void readBufferQueued(int16 *data, const int len, const int stereoFactor) {
+		// Run the timer for the whole buffer, which queues the register
+		// writes of each tick with the sample it happens at
+		int pos = 0;
+		int step;
+
+		do {
+			step = len - pos;
+			if (step > (_nextTick >> FIXP_SHIFT))
+				step = (_nextTick >> FIXP_SHIFT);
+
+			pos += step;
+			_nextTick -= step << FIXP_SHIFT;
+			if (!(_nextTick >> FIXP_SHIFT)) {
+				_registerMutex.lock();
+				_writeTime = pos;
+				_registerMutex.unlock();
+
+				if (_timerProc)
+					(*_timerProc)(_timerParam);
+
+				onTimer();
+
+				_nextTick += _samplesPerTick;
+			}
+		} while (pos < len);
+
+		// The mutex is recursive, so generateSamples() can still write
+		Common::StackLock lock(_registerMutex);
+		_rendering = true;
+
+		// Generate the samples in between the writes
+		pos = 0;
+		for (uint i = 0; i < _registerWrites.size(); ++i) {
+			const RegisterWrite &write = _registerWrites[i];
+			if (write.time > pos) {
+				generateSamples(data + pos * stereoFactor, write.time - pos);
+				pos = write.time;
+			}
+
+			applyRegisterWrite(write.reg, write.value);
+		}
+
+		if (pos < len)
+			generateSamples(data + pos * stereoFactor, len - pos);
+
+		// Keep the memory for the next buffer
+		_registerWrites.resize(0);
+		_writeTime = 0;
+
+		_rendering = false;
+	}
 };
 
 #endif
@@ -137,6 +137,23 @@ Bit32u LA32Ramp::nextValue() {
 	return current;
 }
 
+unsigned int LA32Ramp::nextValues(Bit32u *values, unsigned int length) {
+	for (unsigned int i = 0; i < length; i++) {
+		if (interruptCountdown == 0 && largeIncrement == 0) {
+			// The value won't change any more until a new ramp is started
+			for (; i < length; i++) {
+				values[i] = current;
+			}
+			break;
+		}
+		values[i] = nextValue();
+		if (interruptRaised) {
+			return i + 1;
+		}
+	}
+	return length;
+}
+
 bool LA32Ramp::checkInterrupt() {
 	bool wasRaised = interruptRaised;
 	interruptRaised = false;
@@ -34,6 +34,9 @@ public:
 	LA32Ramp();
 	void startRamp(Bit8u target, Bit8u increment);
 	Bit32u nextValue();
+	// Generate the values of up to length samples, stopping after the one which raises an interrupt.
+	// Returns the number of values generated.
+	unsigned int nextValues(Bit32u *values, unsigned int length);
 	bool checkInterrupt();
 	void reset();
 };
@@ -31,11 +31,7 @@ static const Bit32u MAX_CUTOFF_VALUE = 240 << 18;
 static const LogSample SILENCE = {65535, LogSample::POSITIVE};
 
 Bit16u LA32Utilites::interpolateExp(const Bit16u fract) {
-	Bit16u expTabIndex = fract >> 3;
-	Bit16u extraBits = ~fract & 7;
-	Bit16u expTabEntry2 = 8191 - Tables::getInstance().exp9[expTabIndex];
-	Bit16u expTabEntry1 = expTabIndex == 0 ? 8191 : (8191 - Tables::getInstance().exp9[expTabIndex - 1]);
-	return expTabEntry2 + (((expTabEntry1 - expTabEntry2) * extraBits) >> 3);
+	return Tables::getInstance().exp12[fract];
 }
 
 Bit16s LA32Utilites::unlog(const LogSample &logSample) {
@@ -401,6 +397,17 @@ Bit16s LA32PartialPair::nextOutSample() {
 	return unlogAndMixWGOutput(master, NULL) + unlogAndMixWGOutput(slave, NULL);
 }
 
+void LA32PartialPair::generateSamples(Bit16s *buffer, const unsigned long length, const Bit32u *masterAmp, const Bit16u *masterPitch, const Bit32u *masterCutoff,
+	const Bit32u *slaveAmp, const Bit16u *slavePitch, const Bit32u *slaveCutoff) {
+	for (unsigned long i = 0; i < length; i++) {
+		master.generateNextSample(masterAmp[i], masterPitch[i], masterCutoff[i]);
+		if (slaveAmp != NULL) {
+			slave.generateNextSample(slaveAmp[i], slavePitch[i], slaveCutoff[i]);
+		}
+		buffer[i] = nextOutSample();
+	}
+}
+
 void LA32PartialPair::deactivate(const PairType useMaster) {
 	if (useMaster == MASTER) {
 		master.deactivate();
@@ -232,6 +232,11 @@ public:
 	// Perform mixing / ring modulation and return the result
 	Bit16s nextOutSample();
 
+	// Generate and mix length samples, using the TVA, TVP and TVF values given for each of them.
+	// The slave values are only used for the structures with the ring modulation and NULL otherwise.
+	void generateSamples(Bit16s *buffer, const unsigned long length, const Bit32u *masterAmp, const Bit16u *masterPitch, const Bit32u *masterCutoff,
+		const Bit32u *slaveAmp, const Bit16u *slavePitch, const Bit32u *slaveCutoff);
+
 	// Deactivate the WG engine
 	void deactivate(const PairType master);
 
@@ -328,6 +328,17 @@ Bit16s LA32PartialPair::nextOutSample() {
 	return Bit16s(outputSample * 8192.0f);
 }
 
+void LA32PartialPair::generateSamples(Bit16s *buffer, const unsigned long length, const Bit32u *masterAmp, const Bit16u *masterPitch, const Bit32u *masterCutoff,
+	const Bit32u *slaveAmp, const Bit16u *slavePitch, const Bit32u *slaveCutoff) {
+	for (unsigned long i = 0; i < length; i++) {
+		generateNextSample(MASTER, masterAmp[i], masterPitch[i], masterCutoff[i]);
+		if (slaveAmp != NULL) {
+			generateNextSample(SLAVE, slaveAmp[i], slavePitch[i], slaveCutoff[i]);
+		}
+		buffer[i] = nextOutSample();
+	}
+}
+
 void LA32PartialPair::deactivate(const PairType useMaster) {
 	if (useMaster == MASTER) {
 		master.deactivate();
@@ -233,6 +233,31 @@ Bit32u Partial::getCutoffValue() {
 	return (tvf->getBaseCutoff() << 18) + cutoffModifierRampVal;
 }
 
+void Partial::generateCutoffValues(unsigned long length) {
+	// The TVF only uses its own ramp and the key, velocity and sustain state of the poly, which the TVA
+	// and TVP don't change, so its values can be generated after theirs. mt32-render --compare checks
+	// that this gives the same output as generateSamplesSingly().
+	if (isPCM()) {
+		memset(cutoffBuffer, 0, length * sizeof(cutoffBuffer[0]));
+		return;
+	}
+	Bit32u baseCutoffVal = tvf->getBaseCutoff() << 18;
+	unsigned long i = 0;
+	while (i < length) {
+		unsigned long rampSamples = cutoffModifierRamp.nextValues(&cutoffBuffer[i], length - i);
+		for (unsigned long end = i + rampSamples; i < end; i++) {
+			cutoffBuffer[i] += baseCutoffVal;
+		}
+		if (cutoffModifierRamp.checkInterrupt()) {
+			tvf->handleInterrupt();
+		}
+	}
+}
+
+bool Partial::hasEndingWave() const {
+	return pcmWave != NULL && !pcmWave->loop;
+}
+
 unsigned long Partial::generateSamples(Bit16s *partialBuf, unsigned long length) {
 	if (!isActive() || alreadyOutputed) {
 		return 0;
@@ -243,14 +268,95 @@ unsigned long Partial::generateSamples(Bit16s *partialBuf, unsigned long length)
 	}
 	alreadyOutputed = true;
 
+	// The end of a wave which isn't looped has to be noticed before the TVA, TVP and TVF values
+	// of the next sample are generated, so these are rendered one sample at a time
+	if (!synth->isBlockRenderingEnabled() || hasEndingWave() || (hasRingModulatingSlave() && pair->hasEndingWave())) {
+		return generateSamplesSingly(partialBuf, length);
+	}
+
+	unsigned long blockStart = 0;
+	while (blockStart < length) {
+		Partial *slave = hasRingModulatingSlave() ? pair : NULL;
+		unsigned long blockLength = length - blockStart;
+		if (blockLength > PARTIAL_BLOCK_SAMPLES) {
+			blockLength = PARTIAL_BLOCK_SAMPLES;
+		}
+
+		// The values of each sample are generated in the same order as sample by sample:
+		// the TVP first, since it may restart the TVA ramp when sustaining, then the TVA.
+		// The block ends early when the TVA of either partial stops playing.
+		bool stopped = false;
+		bool slaveStopped = false;
+		unsigned long blockSamples = 0;
+		while (blockSamples < blockLength) {
+			sampleNum = blockStart + blockSamples;
+			if (!tva->isPlaying()) {
+				stopped = true;
+				break;
+			}
+			pitchBuffer[blockSamples] = tvp->nextPitch();
+			ampBuffer[blockSamples] = getAmpValue();
+			if (slave != NULL) {
+				slave->pitchBuffer[blockSamples] = slave->tvp->nextPitch();
+				slave->ampBuffer[blockSamples] = slave->getAmpValue();
+				if (!slave->tva->isPlaying()) {
+					slaveStopped = true;
+					blockSamples++;
+					break;
+				}
+			}
+			blockSamples++;
+		}
+		generateCutoffValues(blockSamples);
+		if (slave != NULL) {
+			slave->generateCutoffValues(blockSamples);
+		}
+
+		// The sample in which the slave stops is generated separately, since the slave has to be
+		// deactivated before mixing it
+		unsigned long mixedSamples = slaveStopped ? blockSamples - 1 : blockSamples;
+		if (slave != NULL) {
+			la32Pair.generateSamples(partialBuf, mixedSamples, ampBuffer, pitchBuffer, cutoffBuffer, slave->ampBuffer, slave->pitchBuffer, slave->cutoffBuffer);
+		} else {
+			la32Pair.generateSamples(partialBuf, mixedSamples, ampBuffer, pitchBuffer, cutoffBuffer, NULL, NULL, NULL);
+		}
+		partialBuf += mixedSamples;
+		blockStart += mixedSamples;
+
+		if (slaveStopped) {
+			la32Pair.generateNextSample(LA32PartialPair::MASTER, ampBuffer[mixedSamples], pitchBuffer[mixedSamples], cutoffBuffer[mixedSamples]);
+			la32Pair.generateNextSample(LA32PartialPair::SLAVE, slave->ampBuffer[mixedSamples], slave->pitchBuffer[mixedSamples], slave->cutoffBuffer[mixedSamples]);
+			slave->deactivate();
+			if (mixType == 2) {
+				deactivate();
+				break;
+			}
+			*partialBuf++ = la32Pair.nextOutSample();
+			blockStart++;
+		}
+		if (stopped) {
+			deactivate();
+			break;
+		}
+	}
+	sampleNum = 0;
+	return blockStart;
+}
+
+unsigned long Partial::generateSamplesSingly(Bit16s *partialBuf, unsigned long length) {
 	for (sampleNum = 0; sampleNum < length; sampleNum++) {
 		if (!tva->isPlaying() || !la32Pair.isActive(LA32PartialPair::MASTER)) {
 			deactivate();
 			break;
 		}
-		la32Pair.generateNextSample(LA32PartialPair::MASTER, getAmpValue(), tvp->nextPitch(), getCutoffValue());
+		// Keep the order in which the values have always been generated: TVF, TVP, then TVA
+		Bit32u cutoff = getCutoffValue();
+		Bit16u pitch = tvp->nextPitch();
+		la32Pair.generateNextSample(LA32PartialPair::MASTER, getAmpValue(), pitch, cutoff);
 		if (hasRingModulatingSlave()) {
-			la32Pair.generateNextSample(LA32PartialPair::SLAVE, pair->getAmpValue(), pair->tvp->nextPitch(), pair->getCutoffValue());
+			cutoff = pair->getCutoffValue();
+			pitch = pair->tvp->nextPitch();
+			la32Pair.generateNextSample(LA32PartialPair::SLAVE, pair->getAmpValue(), pitch, cutoff);
 			if (!pair->tva->isPlaying() || !la32Pair.isActive(LA32PartialPair::SLAVE)) {
 				pair->deactivate();
 				if (mixType == 2) {
@@ -298,13 +404,11 @@ bool Partial::produceOutput(float *leftBuf, float *rightBuf, unsigned long lengt
 		return false;
 	}
 	unsigned long numGenerated = generateSamples(myBuffer, length);
-	for (unsigned int i = 0; i < numGenerated; i++) {
-		*leftBuf++ = myBuffer[i] * stereoVolume.leftVol;
-		*rightBuf++ = myBuffer[i] * stereoVolume.rightVol;
-	}
-	for (; numGenerated < length; numGenerated++) {
-		*leftBuf++ = 0.0f;
-		*rightBuf++ = 0.0f;
+	const float leftVol = stereoVolume.leftVol;
+	const float rightVol = stereoVolume.rightVol;
+	for (unsigned long i = 0; i < numGenerated; i++) {
+		leftBuf[i] += myBuffer[i] * leftVol;
+		rightBuf[i] += myBuffer[i] * rightVol;
 	}
 	return true;
 }
@@ -30,6 +30,9 @@ struct StereoVolume {
 	float rightVol;
 };
 
+// The TVA, TVP and TVF values of this many samples are generated at once, before the wave generators process them
+const unsigned int PARTIAL_BLOCK_SAMPLES = 128;
+
 // A partial represents one of up to four waveform generators currently playing within a poly.
 class Partial {
 private:
@@ -63,8 +66,17 @@ private:
 	// TODO: This should be owned by PartialPair
 	LA32PartialPair la32Pair;
 
+	// Values for the wave generator of the block being rendered.
+	// The buffers of a ring modulating slave are filled by its master.
+	Bit32u ampBuffer[PARTIAL_BLOCK_SAMPLES];
+	Bit16u pitchBuffer[PARTIAL_BLOCK_SAMPLES];
+	Bit32u cutoffBuffer[PARTIAL_BLOCK_SAMPLES];
+
 	Bit32u getAmpValue();
 	Bit32u getCutoffValue();
+	void generateCutoffValues(unsigned long length);
+	bool hasEndingWave() const;
+	unsigned long generateSamplesSingly(Bit16s *partialBuf, unsigned long length);
 
 public:
 	const PatchCache *patchCache;
@@ -98,8 +110,8 @@ public:
 	const ControlROMPCMStruct *getControlROMPCMStruct() const;
 	Synth *getSynth() const;
 
-	// Returns true only if data written to buffer
-	// This function (unlike the one below it) returns processed stereo samples
+	// Returns true only if data was mixed into the buffers
+	// This function (unlike the one below it) adds processed stereo samples
 	// made from combining this single partial with its pair, if it has one.
 	bool produceOutput(float *leftBuf, float *rightBuf, unsigned long length);
 
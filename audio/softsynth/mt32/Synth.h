@@ -298,6 +298,9 @@ private:
 	bool reverbEnabled;
 	bool reverbOverridden;
 
+	// Partials render in blocks unless this is cleared, only used to verify the block rendering
+	bool blockRenderingEnabled;
+
 	FloatToBit16sFunc la32FloatToBit16sFunc;
 	FloatToBit16sFunc reverbFloatToBit16sFunc;
 	float outputGain;
@@ -314,8 +317,6 @@ private:
 	// FIXME: We can reorganise things so that we don't need all these separate tmpBuf, tmp and prerender buffers.
 	// This should be rationalised when things have stabilised a bit (if prerender buffers don't die in the mean time).
 
-	float tmpBufPartialLeft[MAX_SAMPLES_PER_RUN];
-	float tmpBufPartialRight[MAX_SAMPLES_PER_RUN];
 	float tmpBufMixLeft[MAX_SAMPLES_PER_RUN];
 	float tmpBufMixRight[MAX_SAMPLES_PER_RUN];
 	float tmpBufReverbOutLeft[MAX_SAMPLES_PER_RUN];
@@ -408,6 +409,10 @@ public:
 	bool isReverbOverridden() const;
 	void setDACInputMode(DACInputMode mode);
 
+	// When disabled, all partials are rendered one sample at a time. The output is the same either way.
+	void setBlockRenderingEnabled(bool blockRenderingEnabled);
+	bool isBlockRenderingEnabled() const;
+
 	// Sets output gain factor. Applied to all output samples and unrelated with the synth's Master volume.
 	void setOutputGain(float);
 
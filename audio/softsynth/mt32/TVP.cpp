@@ -285,7 +285,9 @@ Bit16u TVP::nextPitch() {
 		timeElapsed = timeElapsed & 0x00FFFFFF;
 		process();
 	}
-	counter = (counter + 1) % maxCounter;
+	if (++counter == maxCounter) {
+		counter = 0;
+	}
 	return pitch;
 }
 
@@ -35,7 +35,11 @@ private:
 	Tables(Tables &);
 
 public:
-	static const Tables &getInstance();
+	// Inline, since the wave generators look up their tables for every sample
+	static const Tables &getInstance() {
+		static const Tables instance;
+		return instance;
+	}
 
 	// Constant LUTs
 
@@ -59,6 +63,10 @@ public:
 	Bit16u exp9[512];
 	Bit16u logsin9[512];
 
+	// exp9 with the lower 3 bits of a 12-bit fraction used for the interpolation, like the LA32 does with its table of differences.
+	// Indexed by the whole fraction, so that the wave generators don't have to interpolate for every sample.
+	Bit16u exp12[4096];
+
 	const Bit8u *resAmpDecayFactor;
 };
 
@@ -90,6 +90,10 @@ namespace DBOPL {
 //Has to fit within 16bit lookuptable
 #define MUL_SH		16
 
+//Maximum amount of samples an operator generates at once in the block synth
+#define BLOCK_SH		6
+#define BLOCK_SAMPLES	( 1 << BLOCK_SH )
+
 //Check some ranges
 #if ENV_EXTRA > 3
 #error Too many envelope bits
@@ -595,6 +599,80 @@ INLINE Bits Operator::GetSample( Bits modulation ) {
 	}
 }
 
+//Forward the envelope by up to samples and return the amount of them for which the volume
+//is level + ( ( index + n * add ) >> RATE_SH ) for the nth sample, counting from 1
+Bitu Operator::ForwardEnvelope( Bitu samples, Bit32u& level, Bit32u& index, Bit32u& add ) {
+	//Decay and release linearly increase the attenuation until reaching the next state,
+	//which doesn't need to go through the state handler for every sample. Rates too fast
+	//to keep the index within 32 bits for a whole block are left to the regular handler.
+	bool linear = state == DECAY || state == RELEASE || ( state == SUSTAIN && !( reg20 & MASK_SUSTAIN ) );
+	Bit32u rate = state == DECAY ? decayAdd : releaseAdd;
+	if ( linear && rate < ( 1u << ( 31 - BLOCK_SH ) ) && samples <= BLOCK_SAMPLES ) {
+		Bit32s limit = state == DECAY ? sustainLevel : ENV_MAX;
+		//After n samples the volume increased by ( rateIndex + n * rate ) >> RATE_SH, so the
+		//amount of samples before reaching the next state can be calculated upfront
+		Bitu count = 0;
+		if ( volume < limit ) {
+			Bit32u left = limit - volume;
+			count = samples;
+			if ( ( ( rateIndex + samples * rate ) >> RATE_SH ) >= left ) {
+				Bit32u needed = ( left << RATE_SH ) - rateIndex;
+				count = ( needed + rate - 1 ) / rate - 1;
+			}
+		}
+		if ( count ) {
+			level = currentLevel + volume;
+			index = rateIndex;
+			add = rate;
+			Bit32u total = rateIndex + count * rate;
+			volume += total >> RATE_SH;
+			rateIndex = total & RATE_MASK;
+			return count;
+		}
+	}
+	//Everything else goes through the regular handler one sample at a time
+	Bit8u oldState = state;
+	level = ForwardVolume();
+	index = 0;
+	add = 0;
+	//Without a rate the envelope can only change state on the first sample, after that
+	//it keeps returning the same volume and leaves the rate index alone
+	if ( state == oldState && ( rateZero & ( 1 << state ) ) )
+		return samples;
+	return 1;
+}
+
+//Same as calling GetSample for every sample, modulation and output can be the same buffer
+template< bool modulated >
+void Operator::GenerateBlock( Bitu samples, const Bit32s* modulation, Bit32s* output ) {
+	Bit32u phase = waveIndex;
+	Bit32u step = waveCurrent;
+	Bitu done = 0;
+	while ( done < samples ) {
+		Bit32u level, index, add;
+		Bitu count = ForwardEnvelope( samples - done, level, index, add );
+		//The attenuation only increases within a segment
+		if ( ENV_SILENT( level ) ) {
+			//Simply forward the wave
+			phase += step * count;
+			memset( output + done, 0, sizeof( Bit32s ) * count );
+		} else {
+			for ( Bitu i = done; i < done + count; i++ ) {
+				index += add;
+				phase += step;
+				Bitu vol = level + ( index >> RATE_SH );
+				Bitu wave = phase >> WAVE_SH;
+				if ( modulated ) {
+					wave += modulation[i];
+				}
+				output[i] = ENV_SILENT( vol ) ? 0 : GetWave( wave, vol );
+			}
+		}
+		done += count;
+	}
+	waveIndex = phase;
+}
+
 Operator::Operator() {
 	chanData = 0;
 	freqMul = 0;
@@ -838,6 +916,115 @@ INLINE void Channel::GeneratePercussion( Chip* chip, Bit32s* output ) {
 	}
 }
 
+//Generate the delayed output of the self modulating first operator of several channels,
+//interleaving them hides the latency of the feedback within a single channel
+template< Bitu lanes >
+static void GenerateFeedback( Channel* const* channels, Bitu samples, Bit32s (*outputs)[ BLOCK_SAMPLES ] ) {
+	Operator* modulator[ lanes ];
+	Bit32s old0[ lanes ];
+	Bit32s old1[ lanes ];
+	Bit32u index[ lanes ];
+	Bit32u add[ lanes ];
+	Bit8u feedback[ lanes ];
+	//The envelope segment each lane is in, see Operator::ForwardEnvelope
+	Bitu left[ lanes ];
+	Bit32u level[ lanes ];
+	Bit32u envIndex[ lanes ];
+	Bit32u envAdd[ lanes ];
+	for ( Bitu l = 0; l < lanes; l++ ) {
+		modulator[l] = channels[l]->Op( 0 );
+		old0[l] = channels[l]->old[0];
+		old1[l] = channels[l]->old[1];
+		index[l] = modulator[l]->waveIndex;
+		add[l] = modulator[l]->waveCurrent;
+		feedback[l] = channels[l]->feedback;
+		left[l] = 0;
+	}
+	Bitu done = 0;
+	while ( done < samples ) {
+		//Continue until the first lane reaches the end of its segment
+		Bitu todo = samples - done;
+		for ( Bitu l = 0; l < lanes; l++ ) {
+			if ( !left[l] ) {
+				left[l] = modulator[l]->ForwardEnvelope( samples - done, level[l], envIndex[l], envAdd[l] );
+			}
+			todo = left[l] < todo ? left[l] : todo;
+		}
+		for ( Bitu i = done; i < done + todo; i++ ) {
+			for ( Bitu l = 0; l < lanes; l++ ) {
+				//Do unsigned shift so we can shift out all bits but still stay in 10 bit range otherwise
+				Bit32s mod = (Bit32u)( old0[l] + old1[l] ) >> feedback[l];
+				old0[l] = old1[l];
+				index[l] += add[l];
+				envIndex[l] += envAdd[l];
+				Bitu vol = level[l] + ( envIndex[l] >> RATE_SH );
+				old1[l] = ENV_SILENT( vol ) ? 0 : modulator[l]->GetWave( ( index[l] >> WAVE_SH ) + mod, vol );
+				outputs[l][i] = old0[l];
+			}
+		}
+		for ( Bitu l = 0; l < lanes; l++ ) {
+			left[l] -= todo;
+		}
+		done += todo;
+	}
+	for ( Bitu l = 0; l < lanes; l++ ) {
+		channels[l]->old[0] = old0[l];
+		channels[l]->old[1] = old1[l];
+		modulator[l]->waveIndex = index[l];
+	}
+}
+
+static INLINE void AddBlock( Bitu samples, Bit32s* output, const Bit32s* input ) {
+	for ( Bitu i = 0; i < samples; i++ ) {
+		output[i] += input[i];
+	}
+}
+
+//The operators don't depend on each other besides the modulation, so instead of
+//interleaving them for every sample each one generates a whole block in a tight loop
+template<SynthMode mode>
+void Channel::GenerateOperators( Bitu samples, const Bit32s* out0, Bit32s* output ) {
+	Bit32s next[ BLOCK_SAMPLES ];
+	Bit32s sample[ BLOCK_SAMPLES ];
+	if ( mode == sm2AM || mode == sm3AM ) {
+		Op(1)->GenerateBlock< false >( samples, 0, sample );
+		AddBlock( samples, sample, out0 );
+	} else if ( mode == sm2FM || mode == sm3FM ) {
+		Op(1)->GenerateBlock< true >( samples, out0, sample );
+	} else if ( mode == sm3FMFM ) {
+		Op(1)->GenerateBlock< true >( samples, out0, sample );
+		Op(2)->GenerateBlock< true >( samples, sample, sample );
+		Op(3)->GenerateBlock< true >( samples, sample, sample );
+	} else if ( mode == sm3AMFM ) {
+		Op(1)->GenerateBlock< false >( samples, 0, next );
+		Op(2)->GenerateBlock< true >( samples, next, next );
+		Op(3)->GenerateBlock< true >( samples, next, sample );
+		AddBlock( samples, sample, out0 );
+	} else if ( mode == sm3FMAM ) {
+		Op(1)->GenerateBlock< true >( samples, out0, sample );
+		Op(2)->GenerateBlock< false >( samples, 0, next );
+		Op(3)->GenerateBlock< true >( samples, next, next );
+		AddBlock( samples, sample, next );
+	} else if ( mode == sm3AMAM ) {
+		Op(1)->GenerateBlock< false >( samples, 0, next );
+		Op(2)->GenerateBlock< true >( samples, next, sample );
+		AddBlock( samples, sample, out0 );
+		Op(3)->GenerateBlock< false >( samples, 0, next );
+		AddBlock( samples, sample, next );
+	} else {
+		//Percussion is always generated sample by sample
+		return;
+	}
+	if ( mode == sm2AM || mode == sm2FM ) {
+		AddBlock( samples, output, sample );
+	} else {
+		for ( Bitu i = 0; i < samples; i++ ) {
+			output[ i * 2 + 0 ] += sample[i] & maskLeft;
+			output[ i * 2 + 1 ] += sample[i] & maskRight;
+		}
+	}
+}
+
 template<SynthMode mode>
 Channel* Channel::BlockTemplate( Chip* chip, Bit32u samples, Bit32s* output ) {
 	switch( mode ) {
@@ -911,79 +1098,86 @@ Channel* Channel::BlockTemplate( Chip* chip, Bit32u samples, Bit32s* output ) {
 		Op( 4 )->Prepare( chip );
 		Op( 5 )->Prepare( chip );
 	}
-	for ( Bitu i = 0; i < samples; i++ ) {
-		//Early out for percussion handlers
-		if ( mode == sm2Percussion ) {
-			GeneratePercussion<false>( chip, output + i );
-			continue;	//Prevent some unitialized value bitching
-		} else if ( mode == sm3Percussion ) {
-			GeneratePercussion<true>( chip, output + i * 2 );
-			continue;	//Prevent some unitialized value bitching
-		}
+	if ( mode != sm2Percussion && mode != sm3Percussion && !chip->referenceSynth ) {
+		//Leave it to the chip to generate along with the other channels
+		chip->blockChannel[ chip->blockCount ] = this;
+		chip->blockHandler[ chip->blockCount ] = &Channel::GenerateOperators< mode >;
+		chip->blockCount++;
+	} else {
+		for ( Bitu i = 0; i < samples; i++ ) {
+			//Early out for percussion handlers
+			if ( mode == sm2Percussion ) {
+				GeneratePercussion<false>( chip, output + i );
+				continue;	//Prevent some unitialized value bitching
+			} else if ( mode == sm3Percussion ) {
+				GeneratePercussion<true>( chip, output + i * 2 );
+				continue;	//Prevent some unitialized value bitching
+			}
 
-		//Do unsigned shift so we can shift out all bits but still stay in 10 bit range otherwise
-		Bit32s mod = (Bit32u)((old[0] + old[1])) >> feedback;
-		old[0] = old[1];
-		old[1] = Op(0)->GetSample( mod );
-		Bit32s sample;
-		Bit32s out0 = old[0];
-		if ( mode == sm2AM || mode == sm3AM ) {
-			sample = out0 + Op(1)->GetSample( 0 );
-		} else if ( mode == sm2FM || mode == sm3FM ) {
-			sample = Op(1)->GetSample( out0 );
-		} else if ( mode == sm3FMFM ) {
-			Bits next = Op(1)->GetSample( out0 );
-			next = Op(2)->GetSample( next );
-			sample = Op(3)->GetSample( next );
-		} else if ( mode == sm3AMFM ) {
-			sample = out0;
-			Bits next = Op(1)->GetSample( 0 );
-			next = Op(2)->GetSample( next );
-			sample += Op(3)->GetSample( next );
-		} else if ( mode == sm3FMAM ) {
-			sample = Op(1)->GetSample( out0 );
-			Bits next = Op(2)->GetSample( 0 );
-			sample += Op(3)->GetSample( next );
-		} else if ( mode == sm3AMAM ) {
-			sample = out0;
-			Bits next = Op(1)->GetSample( 0 );
-			sample += Op(2)->GetSample( next );
-			sample += Op(3)->GetSample( 0 );
-		}
-		switch( mode ) {
-		case sm2AM:
-		case sm2FM:
-			output[ i ] += sample;
-			break;
-		case sm3AM:
-		case sm3FM:
-		case sm3FMFM:
-		case sm3AMFM:
-		case sm3FMAM:
-		case sm3AMAM:
-			output[ i * 2 + 0 ] += sample & maskLeft;
-			output[ i * 2 + 1 ] += sample & maskRight;
-			break;
-		case sm2Percussion:
-			// This case was not handled in the DOSBox code either
-			// thus we leave this blank.
-			// TODO: Consider checking this.
-			break;
-		case sm3Percussion:
-			// This case was not handled in the DOSBox code either
-			// thus we leave this blank.
-			// TODO: Consider checking this.
-			break;
-		case sm4Start:
-			// This case was not handled in the DOSBox code either
-			// thus we leave this blank.
-			// TODO: Consider checking this.
-			break;
-		case sm6Start:
-			// This case was not handled in the DOSBox code either
-			// thus we leave this blank.
-			// TODO: Consider checking this.
-			break;
+			//Do unsigned shift so we can shift out all bits but still stay in 10 bit range otherwise
+			Bit32s mod = (Bit32u)((old[0] + old[1])) >> feedback;
+			old[0] = old[1];
+			old[1] = Op(0)->GetSample( mod );
+			Bit32s sample;
+			Bit32s out0 = old[0];
+			if ( mode == sm2AM || mode == sm3AM ) {
+				sample = out0 + Op(1)->GetSample( 0 );
+			} else if ( mode == sm2FM || mode == sm3FM ) {
+				sample = Op(1)->GetSample( out0 );
+			} else if ( mode == sm3FMFM ) {
+				Bits next = Op(1)->GetSample( out0 );
+				next = Op(2)->GetSample( next );
+				sample = Op(3)->GetSample( next );
+			} else if ( mode == sm3AMFM ) {
+				sample = out0;
+				Bits next = Op(1)->GetSample( 0 );
+				next = Op(2)->GetSample( next );
+				sample += Op(3)->GetSample( next );
+			} else if ( mode == sm3FMAM ) {
+				sample = Op(1)->GetSample( out0 );
+				Bits next = Op(2)->GetSample( 0 );
+				sample += Op(3)->GetSample( next );
+			} else if ( mode == sm3AMAM ) {
+				sample = out0;
+				Bits next = Op(1)->GetSample( 0 );
+				sample += Op(2)->GetSample( next );
+				sample += Op(3)->GetSample( 0 );
+			}
+			switch( mode ) {
+			case sm2AM:
+			case sm2FM:
+				output[ i ] += sample;
+				break;
+			case sm3AM:
+			case sm3FM:
+			case sm3FMFM:
+			case sm3AMFM:
+			case sm3FMAM:
+			case sm3AMAM:
+				output[ i * 2 + 0 ] += sample & maskLeft;
+				output[ i * 2 + 1 ] += sample & maskRight;
+				break;
+			case sm2Percussion:
+				// This case was not handled in the DOSBox code either
+				// thus we leave this blank.
+				// TODO: Consider checking this.
+				break;
+			case sm3Percussion:
+				// This case was not handled in the DOSBox code either
+				// thus we leave this blank.
+				// TODO: Consider checking this.
+				break;
+			case sm4Start:
+				// This case was not handled in the DOSBox code either
+				// thus we leave this blank.
+				// TODO: Consider checking this.
+				break;
+			case sm6Start:
+				// This case was not handled in the DOSBox code either
+				// thus we leave this blank.
+				// TODO: Consider checking this.
+				break;
+			}
 		}
 	}
 	switch( mode ) {
@@ -1024,6 +1218,8 @@ Chip::Chip() {
 	regBD = 0;
 	reg104 = 0;
 	opl3Active = 0;
+	referenceSynth = false;
+	blockCount = 0;
 }
 
 INLINE Bit32u Chip::ForwardNoise() {
@@ -1219,6 +1415,29 @@ Bit32u Chip::WriteAddr( Bit32u port, Bit8u val ) {
 	return 0;
 }
 
+void Chip::GenerateChannels( Bitu total, Bit32s* output, bool stereo ) {
+	Bit32s out0[ 18 ][ BLOCK_SAMPLES ];
+	while ( total > 0 ) {
+		Bitu samples = total > BLOCK_SAMPLES ? BLOCK_SAMPLES : total;
+		Bitu c = 0;
+		for ( ; c + 4 <= blockCount; c += 4 ) {
+			GenerateFeedback< 4 >( blockChannel + c, samples, out0 + c );
+		}
+		for ( ; c + 2 <= blockCount; c += 2 ) {
+			GenerateFeedback< 2 >( blockChannel + c, samples, out0 + c );
+		}
+		for ( ; c < blockCount; c++ ) {
+			GenerateFeedback< 1 >( blockChannel + c, samples, out0 + c );
+		}
+		for ( c = 0; c < blockCount; c++ ) {
+			( blockChannel[c]->*blockHandler[c] )( samples, out0[c], output );
+		}
+		total -= samples;
+		output += stereo ? samples * 2 : samples;
+	}
+	blockCount = 0;
+}
+
 void Chip::GenerateBlock2( Bitu total, Bit32s* output ) {
 	while ( total > 0 ) {
 		Bit32u samples = ForwardLFO( total );
@@ -1228,6 +1447,7 @@ void Chip::GenerateBlock2( Bitu total, Bit32s* output ) {
 			count++;
 			ch = (ch->*(ch->synthHandler))( this, samples, output );
 		}
+		GenerateChannels( samples, output, false );
 		total -= samples;
 		output += samples;
 	}
@@ -1242,6 +1462,7 @@ void Chip::GenerateBlock3( Bitu total, Bit32s* output  ) {
 			count++;
 			ch = (ch->*(ch->synthHandler))( this, samples, output );
 		}
+		GenerateChannels( samples, output, true );
 		total -= samples;
 		output += samples * 2;
 	}
@@ -68,6 +68,7 @@ typedef Bits ( DB_FASTCALL *WaveHandler) ( Bitu i, Bitu volume );
 
 typedef Bits ( DBOPL::Operator::*VolumeHandler) ( );
 typedef Channel* ( DBOPL::Channel::*SynthHandler) ( Chip* chip, Bit32u samples, Bit32s* output );
+typedef void ( DBOPL::Channel::*BlockHandler) ( Bitu samples, const Bit32s* out0, Bit32s* output );
 
 //Different synth modes that can generate blocks of data
 typedef enum {
@@ -178,6 +179,11 @@ public:
 
 	Bits GetSample( Bits modulation );
 	Bits GetWave( Bitu index, Bitu vol );
+
+	//Block versions of the above, used when generating one operator at a time
+	Bitu ForwardEnvelope( Bitu samples, Bit32u& level, Bit32u& index, Bit32u& add );
+	template< bool modulated >
+	void GenerateBlock( Bitu samples, const Bit32s* modulation, Bit32s* output );
 public:
 	Operator();
 };
@@ -212,6 +218,11 @@ struct Channel {
 	template< bool opl3Mode >
 	void GeneratePercussion( Chip* chip, Bit32s* output );
 
+	//Generate a block one operator at a time instead of one sample at a time, with
+	//the output of the first operator already generated by the chip
+	template<SynthMode mode>
+	void GenerateOperators( Bitu samples, const Bit32s* out0, Bit32s* output );
+
 	//Generate blocks of data in specific modes
 	template<SynthMode mode>
 	Channel* BlockTemplate( Chip* chip, Bit32u samples, Bit32s* output );
@@ -253,6 +264,12 @@ struct Chip {
 	Bit8u waveFormMask;
 	//0 or -1 when enabled
 	Bit8s opl3Active;
+	//Generate all channels sample by sample, only used to verify the block generation
+	bool referenceSynth;
+	//Channels queued by their synth handler to be generated together
+	Channel* blockChannel[18];
+	BlockHandler blockHandler[18];
+	Bitu blockCount;
 
 	//Return the maximum amount of samples before and LFO change
 	Bit32u ForwardLFO( Bit32u samples );
@@ -263,6 +280,7 @@ struct Chip {
 
 	Bit32u WriteAddr( Bit32u port, Bit8u val );
 
+	void GenerateChannels( Bitu samples, Bit32s* output, bool stereo );
 	void GenerateBlock2( Bitu samples, Bit32s* output );
 	void GenerateBlock3( Bitu samples, Bit32s* output );
 
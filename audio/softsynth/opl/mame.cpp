@@ -240,22 +240,6 @@ static int RATE_0[16]=
 /* lock level of common table */
 static int num_lock = 0;
 
-/* work table */
-static void *cur_chip = NULL;	/* current chip point */
-/* currenct chip state */
-/* static OPLSAMPLE  *bufL,*bufR; */
-static OPL_CH *S_CH;
-static OPL_CH *E_CH;
-OPL_SLOT *SLOT7_1, *SLOT7_2, *SLOT8_1, *SLOT8_2;
-
-static int outd[1];
-static int ams;
-static int vib;
-int *ams_table;
-int *vib_table;
-static int amsIncr;
-static int vibIncr;
-static int feedback2;		/* connect for SLOT 2 */
 
 /* --------------------- rebuild tables ------------------- */
 
@@ -376,7 +360,7 @@ inline void OPL_KEYOFF(OPL_SLOT *SLOT) {
 /* ---------- calcrate Envelope Generator & Phase Generator ---------- */
 
 /* return : envelope output */
-inline uint OPL_CALC_SLOT(OPL_SLOT *SLOT) {
+inline uint OPL_CALC_SLOT(FM_OPL *OPL, OPL_SLOT *SLOT) {
 	/* calcrate envelope generator */
 	if ((SLOT->evc += SLOT->evs) >= SLOT->eve) {
 		switch (SLOT->evm) {
@@ -405,13 +389,13 @@ inline uint OPL_CALC_SLOT(OPL_SLOT *SLOT) {
 		}
 	}
 	/* calcrate envelope */
-	return SLOT->TLL + ENV_CURVE[SLOT->evc>>ENV_BITS] + (SLOT->ams ? ams : 0);
+	return SLOT->TLL + ENV_CURVE[SLOT->evc>>ENV_BITS] + (SLOT->ams ? OPL->ams : 0);
 }
 
 /* set algorythm connection */
-static void set_algorythm(OPL_CH *CH) {
-	int *carrier = &outd[0];
-	CH->connect1 = CH->CON ? carrier : &feedback2;
+static void set_algorythm(FM_OPL *OPL, OPL_CH *CH) {
+	int *carrier = &OPL->outd;
+	CH->connect1 = CH->CON ? carrier : &OPL->feedback2;
 	CH->connect2 = carrier;
 }
 
@@ -498,18 +482,18 @@ inline void set_sl_rr(FM_OPL *OPL, int slot, int v) {
 
 #define OP_OUT(slot,env,con)   slot->wavetable[((slot->Cnt + con)>>(24-SIN_ENT_SHIFT)) & (SIN_ENT-1)][env]
 /* ---------- calcrate one of channel ---------- */
-inline void OPL_CALC_CH(OPL_CH *CH) {
+inline void OPL_CALC_CH(FM_OPL *OPL, OPL_CH *CH) {
 	uint env_out;
 	OPL_SLOT *SLOT;
 
-	feedback2 = 0;
+	OPL->feedback2 = 0;
 	/* SLOT 1 */
 	SLOT = &CH->SLOT[SLOT1];
-	env_out=OPL_CALC_SLOT(SLOT);
+	env_out=OPL_CALC_SLOT(OPL, SLOT);
 	if (env_out < (uint)(EG_ENT - 1)) {
 		/* PG */
 		if (SLOT->vib)
-			SLOT->Cnt += (SLOT->Incr * vib) >> VIB_RATE_SHIFT;
+			SLOT->Cnt += (SLOT->Incr * OPL->vib) >> VIB_RATE_SHIFT;
 		else
 			SLOT->Cnt += SLOT->Incr;
 		/* connection */
@@ -526,15 +510,15 @@ inline void OPL_CALC_CH(OPL_CH *CH) {
 	}
 	/* SLOT 2 */
 	SLOT = &CH->SLOT[SLOT2];
-	env_out=OPL_CALC_SLOT(SLOT);
+	env_out=OPL_CALC_SLOT(OPL, SLOT);
 	if (env_out < (uint)(EG_ENT - 1)) {
 		/* PG */
 		if (SLOT->vib)
-			SLOT->Cnt += (SLOT->Incr * vib) >> VIB_RATE_SHIFT;
+			SLOT->Cnt += (SLOT->Incr * OPL->vib) >> VIB_RATE_SHIFT;
 		else
 			SLOT->Cnt += SLOT->Incr;
 		/* connection */
-		outd[0] += OP_OUT(SLOT, env_out, feedback2);
+		OPL->outd += OP_OUT(SLOT, env_out, OPL->feedback2);
 	}
 }
 
@@ -551,70 +535,74 @@ inline void OPL_CALC_RH(FM_OPL *OPL, OPL_CH *CH) {
 	int tone8;
 
 	OPL_SLOT *SLOT;
+	OPL_SLOT *SLOT7_1 = &CH[7].SLOT[SLOT1];
+	OPL_SLOT *SLOT7_2 = &CH[7].SLOT[SLOT2];
+	OPL_SLOT *SLOT8_1 = &CH[8].SLOT[SLOT1];
+	OPL_SLOT *SLOT8_2 = &CH[8].SLOT[SLOT2];
 	int env_out;
 
 	/* BD : same as FM serial mode and output level is large */
-	feedback2 = 0;
+	OPL->feedback2 = 0;
 	/* SLOT 1 */
 	SLOT = &CH[6].SLOT[SLOT1];
-	env_out = OPL_CALC_SLOT(SLOT);
+	env_out = OPL_CALC_SLOT(OPL, SLOT);
 	if (env_out < EG_ENT-1) {
 		/* PG */
 		if (SLOT->vib)
-			SLOT->Cnt += (SLOT->Incr * vib) >> VIB_RATE_SHIFT;
+			SLOT->Cnt += (SLOT->Incr * OPL->vib) >> VIB_RATE_SHIFT;
 		else
 			SLOT->Cnt += SLOT->Incr;
 		/* connection */
 		if (CH[6].FB) {
 			int feedback1 = (CH[6].op1_out[0] + CH[6].op1_out[1]) >> CH[6].FB;
 			CH[6].op1_out[1] = CH[6].op1_out[0];
-			feedback2 = CH[6].op1_out[0] = OP_OUT(SLOT, env_out, feedback1);
+			OPL->feedback2 = CH[6].op1_out[0] = OP_OUT(SLOT, env_out, feedback1);
 		}
 		else {
-			feedback2 = OP_OUT(SLOT, env_out, 0);
+			OPL->feedback2 = OP_OUT(SLOT, env_out, 0);
 		}
 	} else {
-		feedback2 = 0;
+		OPL->feedback2 = 0;
 		CH[6].op1_out[1] = CH[6].op1_out[0];
 		CH[6].op1_out[0] = 0;
 	}
 	/* SLOT 2 */
 	SLOT = &CH[6].SLOT[SLOT2];
-	env_out = OPL_CALC_SLOT(SLOT);
+	env_out = OPL_CALC_SLOT(OPL, SLOT);
 	if (env_out < EG_ENT-1) {
 		/* PG */
 		if (SLOT->vib)
-			SLOT->Cnt += (SLOT->Incr * vib) >> VIB_RATE_SHIFT;
+			SLOT->Cnt += (SLOT->Incr * OPL->vib) >> VIB_RATE_SHIFT;
 		else
 			SLOT->Cnt += SLOT->Incr;
 		/* connection */
-		outd[0] += OP_OUT(SLOT, env_out, feedback2) * 2;
+		OPL->outd += OP_OUT(SLOT, env_out, OPL->feedback2) * 2;
 	}
 
 	// SD  (17) = mul14[fnum7] + white noise
 	// TAM (15) = mul15[fnum8]
 	// TOP (18) = fnum6(mul18[fnum8]+whitenoise)
 	// HH  (14) = fnum7(mul18[fnum8]+whitenoise) + white noise
-	env_sd = OPL_CALC_SLOT(SLOT7_2) + whitenoise;
-	env_tam =OPL_CALC_SLOT(SLOT8_1);
-	env_top = OPL_CALC_SLOT(SLOT8_2);
-	env_hh = OPL_CALC_SLOT(SLOT7_1) + whitenoise;
+	env_sd = OPL_CALC_SLOT(OPL, SLOT7_2) + whitenoise;
+	env_tam =OPL_CALC_SLOT(OPL, SLOT8_1);
+	env_top = OPL_CALC_SLOT(OPL, SLOT8_2);
+	env_hh = OPL_CALC_SLOT(OPL, SLOT7_1) + whitenoise;
 
 	/* PG */
 	if (SLOT7_1->vib)
-		SLOT7_1->Cnt += (SLOT7_1->Incr * vib) >> (VIB_RATE_SHIFT-1);
+		SLOT7_1->Cnt += (SLOT7_1->Incr * OPL->vib) >> (VIB_RATE_SHIFT-1);
 	else
 		SLOT7_1->Cnt += 2 * SLOT7_1->Incr;
 	if (SLOT7_2->vib)
-		SLOT7_2->Cnt += (CH[7].fc * vib) >> (VIB_RATE_SHIFT-3);
+		SLOT7_2->Cnt += (CH[7].fc * OPL->vib) >> (VIB_RATE_SHIFT-3);
 	else
 		SLOT7_2->Cnt += (CH[7].fc * 8);
 	if (SLOT8_1->vib)
-		SLOT8_1->Cnt += (SLOT8_1->Incr * vib) >> VIB_RATE_SHIFT;
+		SLOT8_1->Cnt += (SLOT8_1->Incr * OPL->vib) >> VIB_RATE_SHIFT;
 	else
 		SLOT8_1->Cnt += SLOT8_1->Incr;
 	if (SLOT8_2->vib)
-		SLOT8_2->Cnt += ((CH[8].fc * 3) * vib) >> (VIB_RATE_SHIFT-4);
+		SLOT8_2->Cnt += ((CH[8].fc * 3) * OPL->vib) >> (VIB_RATE_SHIFT-4);
 	else
 		SLOT8_2->Cnt += (CH[8].fc * 48);
 
@@ -622,16 +610,16 @@ inline void OPL_CALC_RH(FM_OPL *OPL, OPL_CH *CH) {
 
 	/* SD */
 	if (env_sd < (uint)(EG_ENT - 1))
-		outd[0] += OP_OUT(SLOT7_1, env_sd, 0) * 8;
+		OPL->outd += OP_OUT(SLOT7_1, env_sd, 0) * 8;
 	/* TAM */
 	if (env_tam < (uint)(EG_ENT - 1))
-		outd[0] += OP_OUT(SLOT8_1, env_tam, 0) * 2;
+		OPL->outd += OP_OUT(SLOT8_1, env_tam, 0) * 2;
 	/* TOP-CY */
 	if (env_top < (uint)(EG_ENT - 1))
-		outd[0] += OP_OUT(SLOT7_2, env_top, tone8) * 2;
+		OPL->outd += OP_OUT(SLOT7_2, env_top, tone8) * 2;
 	/* HH */
 	if (env_hh  < (uint)(EG_ENT-1))
-		outd[0] += OP_OUT(SLOT7_2, env_hh, tone8) * 2;
+		OPL->outd += OP_OUT(SLOT7_2, env_hh, tone8) * 2;
 }
 
 /* ----------- initialize time tabls ----------- */
@@ -976,7 +964,7 @@ void OPLWriteReg(FM_OPL *OPL, int r, int v) {
 			int feedback = (v >> 1) & 7;
 			CH->FB = feedback ? (8 + 1) - feedback : 0;
 			CH->CON = v & 1;
-			set_algorythm(CH);
+			set_algorythm(OPL, CH);
 		}
 		return;
 	case 0xe0: /* wave type */
@@ -997,7 +985,6 @@ static int OPL_LockTable(void) {
 	if (num_lock>1)
 		return 0;
 	/* first time */
-	cur_chip = NULL;
 	/* allocate total level table (128kb space) */
 	if (!OPLOpenTable()) {
 		num_lock--;
@@ -1012,7 +999,6 @@ static void OPL_UnLockTable(void) {
 	if (num_lock)
 		return;
 	/* last time */
-	cur_chip = NULL;
 	OPLCloseTable();
 }
 
@@ -1030,38 +1016,23 @@ void YM3812UpdateOne(FM_OPL *OPL, int16 *buffer, int length) {
 	uint8 rythm = OPL->rythm & 0x20;
 	OPL_CH *CH, *R_CH;
 
-
-	if ((void *)OPL != cur_chip) {
-		cur_chip = (void *)OPL;
-		/* channel pointers */
-		S_CH = OPL->P_CH;
-		E_CH = &S_CH[9];
-		/* rythm slot */
-		SLOT7_1 = &S_CH[7].SLOT[SLOT1];
-		SLOT7_2 = &S_CH[7].SLOT[SLOT2];
-		SLOT8_1 = &S_CH[8].SLOT[SLOT1];
-		SLOT8_2 = &S_CH[8].SLOT[SLOT2];
-		/* LFO state */
-		amsIncr = OPL->amsIncr;
-		vibIncr = OPL->vibIncr;
-		ams_table = OPL->ams_table;
-		vib_table = OPL->vib_table;
-	}
-	R_CH = rythm ? &S_CH[6] : E_CH;
+	/* all the state lives in the chip, so any number of them can be updated */
+	OPL_CH *S_CH = OPL->P_CH;
+	R_CH = rythm ? &S_CH[6] : &S_CH[9];
 	for (i = 0; i < length; i++) {
 		/*            channel A         channel B         channel C      */
 		/* LFO */
-		ams = ams_table[(amsCnt += amsIncr) >> AMS_SHIFT];
-		vib = vib_table[(vibCnt += vibIncr) >> VIB_SHIFT];
-		outd[0] = 0;
+		OPL->ams = OPL->ams_table[(amsCnt += OPL->amsIncr) >> AMS_SHIFT];
+		OPL->vib = OPL->vib_table[(vibCnt += OPL->vibIncr) >> VIB_SHIFT];
+		OPL->outd = 0;
 		/* FM part */
 		for (CH = S_CH; CH < R_CH; CH++)
-			OPL_CALC_CH(CH);
+			OPL_CALC_CH(OPL, CH);
 		/* Rythn part */
 		if (rythm)
 			OPL_CALC_RH(OPL, S_CH);
 		/* limit check */
-		data = CLIP(outd[0], OPL_MINOUT, OPL_MAXOUT);
+		data = CLIP(OPL->outd, OPL_MINOUT, OPL_MAXOUT);
 		/* store to sound buffer */
 		buf[i] = data >> OPL_OUTSB;
 	}
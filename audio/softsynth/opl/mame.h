@@ -135,6 +135,12 @@ typedef struct fm_opl_f {
 	int amsIncr;
 	int vibCnt;
 	int vibIncr;
+	int ams;			/* LFO output of the current sample */
+	int vib;
+
+	/* outputs of the current sample */
+	int outd;			/* carrier output                    */
+	int feedback2;		/* connect for SLOT 2                */
 
 	/* wave selector enable flag */
 	uint8 wavesel;
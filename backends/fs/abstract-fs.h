@@ -168,6 +168,16 @@ public:
 	 */
 	virtual Common::SeekableReadStream *createReadStream() = 0;
 
+	/**
+	 * Creates a SeekableReadStream instance for a file holding read-only
+	 * data, which nothing changes while the stream exists. Backends may
+	 * map such files into memory once they are at least mapThreshold
+	 * bytes large. The default implementation calls createReadStream().
+	 *
+	 * @return pointer to the stream object, 0 in case of a failure
+	 */
+	virtual Common::SeekableReadStream *createReadStreamForData(uint32 mapThreshold) { return createReadStream(); }
+
 	/**
 	 * Creates a WriteStream instance corresponding to the file
 	 * referred by this node. This assumes that the node actually refers
@@ -30,6 +30,7 @@
 #define FORBIDDEN_SYMBOL_EXCEPTION_exit		//Needed for IRIX's unistd.h
 
 #include "backends/fs/posix/posix-fs.h"
+#include "backends/fs/posix/posix-mmapstream.h"
 #include "backends/fs/stdiostream.h"
 #include "common/algorithm.h"
 
@@ -246,6 +247,20 @@ Common::SeekableReadStream *POSIXFilesystemNode::createReadStream() {
 	return StdioStream::makeFromPath(getPath(), false);
 }
 
+Common::SeekableReadStream *POSIXFilesystemNode::createReadStreamForData(uint32 mapThreshold) {
+#if !defined(DISABLE_MMAP_FILESTREAM) && !defined(PLAYSTATION3)
+	// Large read-only files are mapped into memory, so engines seeking around
+	// in big resource files do not pay for a system call on every read
+	if (!_isDirectory) {
+		Common::SeekableReadStream *stream = PosixMmapStream::makeFromPath(getPath(), mapThreshold);
+		if (stream)
+			return stream;
+	}
+#endif
+
+	return createReadStream();
+}
+
 Common::WriteStream *POSIXFilesystemNode::createWriteStream() {
 	return StdioStream::makeFromPath(getPath(), true);
 }
@@ -71,6 +71,7 @@ public:
 	virtual AbstractFSNode *getParent() const;
 
 	virtual Common::SeekableReadStream *createReadStream();
+	virtual Common::SeekableReadStream *createReadStreamForData(uint32 mapThreshold);
 	virtual Common::WriteStream *createWriteStream();
 
 private:
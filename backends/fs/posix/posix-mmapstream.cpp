@@ -0,0 +1,76 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#if defined(POSIX) && !defined(DISABLE_MMAP_FILESTREAM)
+
+// Disable symbol overrides so that we can use open, mmap etc.
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+#include "backends/fs/posix/posix-mmapstream.h"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+PosixMmapStream::PosixMmapStream(byte *mapping, uint32 mappingSize)
+	: Common::MemoryReadStream(mapping, mappingSize), _mapping(mapping), _mappingSize(mappingSize) {
+}
+
+PosixMmapStream::~PosixMmapStream() {
+	if (_mapping)
+		munmap(_mapping, _mappingSize);
+}
+
+PosixMmapStream *PosixMmapStream::makeFromPath(const Common::String &path, uint32 minSize) {
+	// Check the file before opening it, since most files too small to be
+	// mapped end up being opened via stdio afterwards
+	struct stat st;
+	if (stat(path.c_str(), &st) != 0 || !S_ISREG(st.st_mode) || st.st_size < (off_t)minSize || st.st_size > 0x7FFFFFFF)
+		return 0;
+
+	// Keep big files from using up the address space of 32 bit builds
+	if (sizeof(void *) < 8 && st.st_size > kMaxSize32)
+		return 0;
+
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+		return 0;
+
+	byte *mapping = 0;
+	if (st.st_size > 0) {
+		void *ptr = mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (ptr == MAP_FAILED) {
+			close(fd);
+			return 0;
+		}
+
+		mapping = (byte *)ptr;
+	}
+
+	// The mapping stays valid after the descriptor is closed
+	close(fd);
+
+	return new PosixMmapStream(mapping, (uint32)st.st_size);
+}
+
+#endif
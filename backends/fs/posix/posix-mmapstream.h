@@ -0,0 +1,73 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef BACKENDS_FS_POSIX_MMAPSTREAM_H
+#define BACKENDS_FS_POSIX_MMAPSTREAM_H
+
+#include "common/scummsys.h"
+#include "common/memstream.h"
+#include "common/noncopyable.h"
+#include "common/str.h"
+
+/**
+ * Read only stream for a regular file, mapped into memory in its entirety.
+ *
+ * Reading and seeking do not involve any system calls, and as the stream
+ * is a MemoryReadStream, the data can be accessed directly via getData().
+ */
+class PosixMmapStream : public Common::MemoryReadStream, public Common::NonCopyable {
+protected:
+	/** Start of the mapping, NULL for empty files. */
+	byte *_mapping;
+
+	/** Size of the mapping in bytes. */
+	uint32 _mappingSize;
+
+	PosixMmapStream(byte *mapping, uint32 mappingSize);
+
+public:
+	enum {
+		/** Maximum size of files mapped in builds with 32 bit pointers. */
+		kMaxSize32 = 64 * 1024 * 1024
+	};
+
+	/**
+	 * Maps the file at the given path. Returns NULL in case the file is not
+	 * a regular file, is smaller than minSize bytes, is too large for the
+	 * address space or mapping it failed, in which case the caller should
+	 * fall back to regular file I/O.
+	 *
+	 * The file must not be truncated while it is mapped, since reading the
+	 * missing pages raises SIGBUS instead of a read error. Only use this
+	 * for read-only data.
+	 */
+	static PosixMmapStream *makeFromPath(const Common::String &path, uint32 minSize = 0);
+
+	virtual ~PosixMmapStream();
+
+	/**
+	 * Direct access to the file contents, valid as long as the stream exists.
+	 */
+	const byte *getData() const { return _mapping; }
+};
+
+#endif
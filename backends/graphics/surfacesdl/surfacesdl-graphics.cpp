@@ -29,6 +29,7 @@
 #include "backends/platform/sdl/sdl.h"
 #include "common/config-manager.h"
 #include "common/mutex.h"
+#include "common/perfcounters.h"
 #include "common/textconsole.h"
 #include "common/translation.h"
 #include "common/util.h"
@@ -120,6 +121,7 @@ SurfaceSdlGraphicsManager::SurfaceSdlGraphicsManager(SdlEventSource *sdlEventSou
 	SdlGraphicsManager(sdlEventSource),
 #ifdef USE_OSD
 	_osdSurface(0), _osdAlpha(SDL_ALPHA_TRANSPARENT), _osdFadeStartTime(0),
+	_perfOverlayVisible(false), _perfOverlayUpdateTime(0),
 #endif
 	_hwscreen(0), _screen(0), _tmpscreen(0),
 #ifdef USE_RGB_COLOR
@@ -195,6 +197,10 @@ SurfaceSdlGraphicsManager::~SurfaceSdlGraphicsManager() {
 	if (g_system->getEventManager()->getEventDispatcher() != NULL)
 		g_system->getEventManager()->getEventDispatcher()->unregisterObserver(this);
 
+#ifdef USE_OSD
+	setPerformanceOverlay(false);
+#endif
+
 	unloadGFXMode();
 	if (_mouseSurface)
 		SDL_FreeSurface(_mouseSurface);
@@ -219,6 +225,9 @@ bool SurfaceSdlGraphicsManager::hasFeature(OSystem::Feature f) {
 		(f == OSystem::kFeatureFullscreenMode) ||
 		(f == OSystem::kFeatureAspectRatioCorrection) ||
 		(f == OSystem::kFeatureCursorPalette) ||
+#ifdef USE_OSD
+		(f == OSystem::kFeaturePerformanceOverlay) ||
+#endif
 		(f == OSystem::kFeatureIconifyWindow);
 }
 
@@ -238,6 +247,11 @@ void SurfaceSdlGraphicsManager::setFeatureState(OSystem::Feature f, bool enable)
 		if (enable)
 			SDL_WM_IconifyWindow();
 		break;
+#ifdef USE_OSD
+	case OSystem::kFeaturePerformanceOverlay:
+		setPerformanceOverlay(enable);
+		break;
+#endif
 	default:
 		break;
 	}
@@ -256,6 +270,10 @@ bool SurfaceSdlGraphicsManager::getFeatureState(OSystem::Feature f) {
 		return _videoMode.aspectRatioCorrection;
 	case OSystem::kFeatureCursorPalette:
 		return !_cursorPaletteDisabled;
+#ifdef USE_OSD
+	case OSystem::kFeaturePerformanceOverlay:
+		return _perfOverlayVisible;
+#endif
 	default:
 		return false;
 	}
@@ -1010,6 +1028,14 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 			_forceFull = true;
 		}
 	}
+
+	// Update the performance counter values shown a few times per second,
+	// since they would be unreadable otherwise
+	if (_perfOverlayVisible && (int32)(SDL_GetTicks() - _perfOverlayUpdateTime) >= 0) {
+		_perfOverlayText = PerfMan.formatOverlayText();
+		_perfOverlayUpdateTime = SDL_GetTicks() + kPerfOverlayUpdateDelay;
+		_forceFull = true;
+	}
 #endif
 
 	if (!_overlayVisible) {
@@ -1065,6 +1091,9 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 		srcPitch = srcSurf->pitch;
 		dstPitch = _hwscreen->pitch;
 
+		const bool timeScaler = gPerfCountersEnabled;
+		const uint64 scalerStart = timeScaler ? Common::perfTimerStart() : 0;
+
 		for (r = _dirtyRectList; r != lastRect; ++r) {
 			register int dst_y = r->y + _currentShakePos;
 			register int dst_h = 0;
@@ -1097,6 +1126,10 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 				r->h = stretch200To240((uint8 *) _hwscreen->pixels, dstPitch, r->w, r->h, r->x, r->y, orig_dst_y * scale1);
 #endif
 		}
+
+		if (timeScaler)
+			Common::perfTimerStop(Common::kPerfScaler, scalerStart);
+
 		SDL_UnlockSurface(srcSurf);
 		SDL_UnlockSurface(_hwscreen);
 
@@ -1113,6 +1146,9 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 		if (_osdAlpha != SDL_ALPHA_TRANSPARENT) {
 			SDL_BlitSurface(_osdSurface, 0, _hwscreen, 0);
 		}
+
+		if (_perfOverlayVisible)
+			drawPerformanceOverlay();
 #endif
 
 #ifdef USE_SDL_DEBUG_FOCUSRECT
@@ -2119,6 +2155,74 @@ void SurfaceSdlGraphicsManager::displayMessageOnOSD(const char *msg) {
 	// Ensure a full redraw takes place next time the screen is updated
 	_forceFull = true;
 }
+
+void SurfaceSdlGraphicsManager::setPerformanceOverlay(bool enable) {
+	if (enable == _perfOverlayVisible)
+		return;
+
+	_perfOverlayVisible = enable;
+	if (enable) {
+		PerfMan.enable();
+		_perfOverlayText = PerfMan.formatOverlayText();
+		_perfOverlayUpdateTime = SDL_GetTicks() + kPerfOverlayUpdateDelay;
+	} else {
+		PerfMan.disable();
+	}
+
+	// Draw or remove the overlay
+	_forceFull = true;
+}
+
+void SurfaceSdlGraphicsManager::drawPerformanceOverlay() {
+	const Graphics::Font *font = FontMan.getFontByUsage(Graphics::FontManager::kConsoleFont);
+
+	Common::Array<Common::String> lines;
+	const char *text = _perfOverlayText.c_str();
+	const char *ptr;
+	for (ptr = text; *ptr; ++ptr) {
+		if (*ptr == '\n') {
+			lines.push_back(Common::String(text, ptr - text));
+			text = ptr + 1;
+		}
+	}
+	lines.push_back(Common::String(text, ptr - text));
+
+	const int padding = 2;
+	const int lineHeight = font->getFontHeight();
+	int width = 0;
+	for (uint i = 0; i < lines.size(); i++)
+		width = MAX(width, font->getStringWidth(lines[i]));
+
+	// The box in the top left corner is drawn on every screen update, so the
+	// game can not overwrite it. Its contents only change on a full redraw.
+	SDL_Rect box;
+	box.x = 0;
+	box.y = 0;
+	box.w = MIN<int>(width + 2 * padding, _hwscreen->w);
+	box.h = MIN<int>(lines.size() * lineHeight + 2 * padding, _hwscreen->h);
+	SDL_FillRect(_hwscreen, &box, SDL_MapRGB(_hwscreen->format, 0, 0, 0));
+
+	if (SDL_LockSurface(_hwscreen))
+		error("drawPerformanceOverlay: SDL_LockSurface failed: %s", SDL_GetError());
+
+	Graphics::Surface dst;
+	dst.pixels = _hwscreen->pixels;
+	dst.w = box.w;
+	dst.h = box.h;
+	dst.pitch = _hwscreen->pitch;
+	dst.format = Graphics::PixelFormat(_hwscreen->format->BytesPerPixel,
+	                                   8 - _hwscreen->format->Rloss, 8 - _hwscreen->format->Gloss,
+	                                   8 - _hwscreen->format->Bloss, 8 - _hwscreen->format->Aloss,
+	                                   _hwscreen->format->Rshift, _hwscreen->format->Gshift,
+	                                   _hwscreen->format->Bshift, _hwscreen->format->Ashift);
+
+	for (uint i = 0; i < lines.size(); i++) {
+		font->drawString(&dst, lines[i], padding, padding + i * lineHeight, width,
+		                 SDL_MapRGB(_hwscreen->format, 255, 255, 0));
+	}
+
+	SDL_UnlockSurface(_hwscreen);
+}
 #endif
 
 bool SurfaceSdlGraphicsManager::handleScalerHotkeys(Common::KeyCode key) {
@@ -2270,6 +2374,14 @@ bool SurfaceSdlGraphicsManager::notifyEvent(const Common::Event &event) {
 			return true;
 		}
 
+#ifdef USE_OSD
+		// Ctrl-Alt-p toggles the performance overlay
+		if (event.kbd.hasFlags(Common::KBD_CTRL|Common::KBD_ALT) && event.kbd.keycode == Common::KEYCODE_p) {
+			setPerformanceOverlay(!_perfOverlayVisible);
+			return true;
+		}
+#endif
+
 		// Ctrl-Alt-<key> will change the GFX mode
 		if (event.kbd.hasFlags(Common::KBD_CTRL|Common::KBD_ALT)) {
 			if (handleScalerHotkeys(event.kbd.keycode))
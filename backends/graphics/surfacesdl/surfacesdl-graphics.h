@@ -161,6 +161,19 @@ protected:
 		kOSDColorKey = 1,				/** < Transparent color key */
 		kOSDInitialAlpha = 80			/** < Initial alpha level, in percent */
 	};
+
+	/** Whether the performance counters are shown */
+	bool _perfOverlayVisible;
+	/** When to update the performance counter values shown next */
+	uint32 _perfOverlayUpdateTime;
+	/** The performance counter values shown */
+	Common::String _perfOverlayText;
+	enum {
+		kPerfOverlayUpdateDelay = 500	/** < Delay between updates of the shown values (in milliseconds) */
+	};
+
+	void setPerformanceOverlay(bool enable);
+	void drawPerformanceOverlay();
 #endif
 
 	/** Hardware screen */
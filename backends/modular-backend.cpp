@@ -28,6 +28,7 @@
 #include "backends/mutex/mutex.h"
 
 #include "audio/mixer.h"
+#include "common/perfcounters.h"
 #include "graphics/pixelformat.h"
 
 ModularBackend::ModularBackend()
@@ -141,7 +142,13 @@ void ModularBackend::fillScreen(uint32 col) {
 }
 
 void ModularBackend::updateScreen() {
-	_graphicsManager->updateScreen();
+	{
+		Common::PerfTimer timer(Common::kPerfUpdateScreen);
+		_graphicsManager->updateScreen();
+	}
+
+	if (gPerfCountersEnabled)
+		PerfMan.endFrame();
 }
 
 void ModularBackend::setShakePos(int shakeOffset) {
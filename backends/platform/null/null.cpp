@@ -20,15 +20,30 @@
  *
  */
 
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
 #include "backends/modular-backend.h"
 #include "base/main.h"
 
 #if defined(USE_NULL_DRIVER)
+#include "backends/mutex/null/null-mutex.h"
+#include "backends/events/default/default-events.h"
+#include "backends/graphics/null/null-graphics.h"
 #include "backends/saves/default/default-saves.h"
 #include "backends/timer/default/default-timer.h"
 #include "audio/mixer_intern.h"
+#include "common/algorithm.h"
+#include "common/array.h"
+#include "common/EventRecorder.h"
+#include "common/perfcounters.h"
 #include "common/scummsys.h"
 
+#include <time.h>
+#if defined(POSIX)
+#include <sys/time.h>
+#include <unistd.h>
+#endif
+
 /*
  * Include header files needed for the getFilesystemFactory() method.
  */
@@ -40,7 +55,7 @@
 	#include "backends/fs/windows/windows-fs-factory.h"
 #endif
 
-class OSystem_NULL : public ModularBackend {
+class OSystem_NULL : public ModularBackend, Common::EventSource {
 public:
 	OSystem_NULL();
 	virtual ~OSystem_NULL();
@@ -48,15 +63,39 @@ public:
 	virtual void initBackend();
 
 	virtual bool pollEvent(Common::Event &event);
+	virtual Common::EventSource *getDefaultEventSource() { return this; }
+
+	virtual void updateScreen();
 
 	virtual uint32 getMillis();
+	virtual uint64 getMicros();
 	virtual void delayMillis(uint msecs);
 	virtual void getTimeAndDate(TimeDate &t) const {}
 
 	virtual void logMessage(LogMessageType::Type type, const char *message);
+
+	/**
+	 * Prints the frame time statistics gathered while replaying a recording
+	 * in timedemo mode as a single line of JSON to stdout.
+	 */
+	void printTimedemoReport();
+
+private:
+	uint32 getRealMillis();
+
+#if defined(POSIX)
+	timeval _startTime;
+#endif
+
+	// Timedemo statistics
+	Common::Array<uint32> _frameTimes;	///< CPU time spent on each frame in microseconds
+	bool _hasFrame;
+	clock_t _lastFrameClock;
+	uint32 _firstFrameMillis;
+	uint32 _lastFrameMillis;
 };
 
-OSystem_NULL::OSystem_NULL() {
+OSystem_NULL::OSystem_NULL() : _hasFrame(false), _lastFrameClock(0), _firstFrameMillis(0), _lastFrameMillis(0) {
 	#if defined(__amigaos4__)
 		_fsFactory = new AmigaOSFilesystemFactory();
 	#elif defined(POSIX)
@@ -66,6 +105,10 @@ OSystem_NULL::OSystem_NULL() {
 	#else
 		#error Unknown and unsupported FS backend
 	#endif
+
+#if defined(POSIX)
+	gettimeofday(&_startTime, 0);
+#endif
 }
 
 OSystem_NULL::~OSystem_NULL() {
@@ -89,14 +132,70 @@ void OSystem_NULL::initBackend() {
 }
 
 bool OSystem_NULL::pollEvent(Common::Event &event) {
+	// There is no timer thread, so run the timer callbacks whenever the
+	// engine checks for events
+	((DefaultTimerManager *)_timerManager)->handler();
+
 	return false;
 }
 
+void OSystem_NULL::updateScreen() {
+	ModularBackend::updateScreen();
+
+	if (!g_eventRec.isTimedemo())
+		return;
+
+	clock_t now = clock();
+	uint32 millis = getRealMillis();
+
+	if (!_hasFrame) {
+		_firstFrameMillis = millis;
+		_hasFrame = true;
+	} else {
+		_frameTimes.push_back((uint32)((uint64)(now - _lastFrameClock) * 1000000 / CLOCKS_PER_SEC));
+	}
+
+	_lastFrameClock = now;
+	_lastFrameMillis = millis;
+}
+
+uint32 OSystem_NULL::getRealMillis() {
+#if defined(POSIX)
+	timeval curTime;
+	gettimeofday(&curTime, 0);
+
+	return (uint32)(((curTime.tv_sec - _startTime.tv_sec) * 1000) + ((curTime.tv_usec - _startTime.tv_usec) / 1000));
+#else
+	return (uint32)((uint64)clock() * 1000 / CLOCKS_PER_SEC);
+#endif
+}
+
 uint32 OSystem_NULL::getMillis() {
-	return 0;
+	uint32 millis = getRealMillis();
+	g_eventRec.processMillis(millis);
+	return millis;
+}
+
+uint64 OSystem_NULL::getMicros() {
+#if defined(POSIX)
+	timeval curTime;
+	gettimeofday(&curTime, 0);
+
+	return (uint64)(curTime.tv_sec - _startTime.tv_sec) * 1000000 + curTime.tv_usec - _startTime.tv_usec;
+#else
+	return (uint64)clock() * 1000000 / CLOCKS_PER_SEC;
+#endif
 }
 
 void OSystem_NULL::delayMillis(uint msecs) {
+	Common::PerfTimer timer(Common::kPerfDelay);
+
+	if (g_eventRec.processDelayMillis(msecs))
+		return;
+
+#if defined(POSIX)
+	usleep(msecs * 1000);
+#endif
 }
 
 void OSystem_NULL::logMessage(LogMessageType::Type type, const char *message) {
@@ -111,6 +210,27 @@ void OSystem_NULL::logMessage(LogMessageType::Type type, const char *message) {
 	fflush(output);
 }
 
+void OSystem_NULL::printTimedemoReport() {
+	if (_frameTimes.empty())
+		return;
+
+	Common::Array<uint32> sorted = _frameTimes;
+	Common::sort(sorted.begin(), sorted.end());
+
+	uint64 total = 0;
+	for (uint i = 0; i < sorted.size(); ++i)
+		total += sorted[i];
+
+	const uint count = sorted.size();
+
+	printf("{\"timedemo\":{\"frames\":%u,\"wall_ms\":%u,\"cpu_ms\":%u,"
+	       "\"frame_cpu_us\":{\"mean\":%u,\"min\":%u,\"p50\":%u,\"p90\":%u,\"p99\":%u,\"max\":%u}}}\n",
+	       count, _lastFrameMillis - _firstFrameMillis, (uint32)(total / 1000),
+	       (uint32)(total / count), sorted[0], sorted[count / 2], sorted[count * 90 / 100],
+	       sorted[count * 99 / 100], sorted[count - 1]);
+	fflush(stdout);
+}
+
 OSystem *OSystem_NULL_create() {
 	return new OSystem_NULL();
 }
@@ -121,6 +241,7 @@ int main(int argc, char *argv[]) {
 
 	// Invoke the actual ScummVM main entry point:
 	int res = scummvm_main(argc, argv);
+	((OSystem_NULL *)g_system)->printTimedemoReport();
 	delete (OSystem_NULL *)g_system;
 	return res;
 }
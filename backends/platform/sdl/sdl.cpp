@@ -31,6 +31,7 @@
 #include "backends/platform/sdl/sdl.h"
 #include "common/config-manager.h"
 #include "common/EventRecorder.h"
+#include "common/perfcounters.h"
 #include "common/taskbar.h"
 #include "common/textconsole.h"
 
@@ -56,6 +57,10 @@
 
 #include <time.h>	// for getTimeAndDate()
 
+#ifdef POSIX
+#include <sys/time.h>	// for getMicros()
+#endif
+
 #ifdef USE_DETECTLANG
 #ifndef WIN32
 #include <locale.h>
@@ -472,7 +477,21 @@ uint32 OSystem_SDL::getMillis() {
 	return millis;
 }
 
+uint64 OSystem_SDL::getMicros() {
+#ifdef POSIX
+	// SDL 1.2 has no timer with a better resolution than SDL_GetTicks()
+	timeval curTime;
+	gettimeofday(&curTime, 0);
+	return (uint64)curTime.tv_sec * 1000000 + curTime.tv_usec;
+#else
+	// Unlike getMillis(), bypass the event recorder
+	return (uint64)SDL_GetTicks() * 1000;
+#endif
+}
+
 void OSystem_SDL::delayMillis(uint msecs) {
+	Common::PerfTimer timer(Common::kPerfDelay);
+
 	if (!g_eventRec.processDelayMillis(msecs))
 		SDL_Delay(msecs);
 }
@@ -149,4 +149,16 @@ void POSIXSaveFileManager::checkPath(const Common::FSNode &dir) {
 	}
 }
 
+bool POSIXSaveFileManager::getSavefileInfo(const Common::String &filename, uint32 &size, uint32 &timestamp) {
+	const Common::String path = Common::FSNode(getSavePath()).getChild(filename).getPath();
+
+	struct stat sb;
+	if (stat(path.c_str(), &sb) == -1 || !S_ISREG(sb.st_mode))
+		return false;
+
+	size = (uint32)sb.st_size;
+	timestamp = (uint32)sb.st_mtime;
+	return true;
+}
+
 #endif
@@ -36,6 +36,8 @@ class POSIXSaveFileManager : public DefaultSaveFileManager {
 public:
 	POSIXSaveFileManager();
 
+	virtual bool getSavefileInfo(const Common::String &filename, uint32 &size, uint32 &timestamp);
+
 protected:
 	/**
 	 * Checks the given path for read access, existence, etc.
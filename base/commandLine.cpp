@@ -115,9 +115,16 @@ static const char HELP_STRING[] =
 	"  --enable-gs              Enable Roland GS mode for MIDI playback\n"
 	"  --output-rate=RATE       Select output sample rate in Hz (e.g. 22050)\n"
 	"  --opl-driver=DRIVER      Select AdLib (OPL) emulator (db, mame)\n"
+	"  --opl-capture=PREFIX     Record the OPL register writes to PREFIX0.opl,\n"
+	"                           PREFIX1.opl, ... (one file per emulator)\n"
 	"  --aspect-ratio           Enable aspect ratio correction\n"
 	"  --render-mode=MODE       Enable additional render modes (cga, ega, hercGreen,\n"
 	"                           hercAmber, amiga)\n"
+	"  --record-mode=MODE       Record or replay input events (record, playback,\n"
+	"                           timedemo). timedemo replays as fast as possible\n"
+	"                           and reports frame times (null backend only)\n"
+	"  --record-file-name=FILE  Name of the recording (default: record.bin)\n"
+	"  --perf-csv=FILE          Write the performance counters to FILE on exit\n"
 	"\n"
 #if defined(ENABLE_SKY) || defined(ENABLE_QUEEN)
 	"  --alt-intro              Use alternative intro for CD versions of Beneath a\n"
@@ -231,6 +238,7 @@ void registerDefaults() {
 	ConfMan.registerDefault("joystick_num", -1);
 	ConfMan.registerDefault("confirm_exit", false);
 	ConfMan.registerDefault("disable_sdl_parachute", false);
+	ConfMan.registerDefault("mmap_threshold", 256);
 
 	ConfMan.registerDefault("record_mode", "none");
 	ConfMan.registerDefault("record_file_name", "record.bin");
@@ -423,6 +431,9 @@ Common::String parseCommandLine(Common::StringMap &settings, int argc, const cha
 			DO_LONG_OPTION("opl-driver")
 			END_OPTION
 
+			DO_LONG_OPTION("opl-capture")
+			END_OPTION
+
 			DO_OPTION('g', "gfx-mode")
 			END_OPTION
 
@@ -577,6 +588,9 @@ Common::String parseCommandLine(Common::StringMap &settings, int argc, const cha
 			DO_LONG_OPTION("record-time-file-name")
 			END_OPTION
 
+			DO_LONG_OPTION("perf-csv")
+			END_OPTION
+
 #ifdef IPHONE
 			// This is automatically set when launched from the Springboard.
 			DO_LONG_OPTION_OPT("launchedFromSB", 0)
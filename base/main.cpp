@@ -39,11 +39,14 @@
 
 #include "common/archive.h"
 #include "common/config-manager.h"
+#include "common/coroutines.h"
 #include "common/debug.h"
 #include "common/debug-channels.h" /* for debug manager */
 #include "common/events.h"
 #include "common/EventRecorder.h"
+#include "common/file.h"
 #include "common/fs.h"
+#include "common/perfcounters.h"
 #include "common/system.h"
 #include "common/textconsole.h"
 #include "common/tokenizer.h"
@@ -52,6 +55,7 @@
 #include "gui/gui-manager.h"
 #include "gui/error.h"
 
+#include "audio/decoders/mp3.h"
 #include "audio/mididrv.h"
 #include "audio/musicplugin.h"  /* for music manager */
 
@@ -180,8 +184,11 @@ static Common::Error runGame(const EnginePlugin *plugin, OSystem &system, const
 	// Setup various paths in the SearchManager
 	//
 
-	// Add the game path to the directory search list
-	SearchMan.addDirectory(dir.getPath(), dir, 0, 4);
+	// Add the game path to the directory search list. The game data is only
+	// read, so the backend may map large files of it into memory.
+	Common::FSDirectory *gameDir = new Common::FSDirectory(dir, 4);
+	gameDir->setMapThreshold(MAX(ConfMan.getInt("mmap_threshold"), 0) * 1024);
+	SearchMan.add(dir.getPath(), gameDir, 0);
 
 	// Add extrapath (if any) to the directory search list
 	if (ConfMan.hasKey("extrapath")) {
@@ -430,6 +437,13 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 	// the whole API for that ;-).
 	g_eventRec.init();
 
+	// Gather the performance counters of the whole session if requested. The
+	// option has to be read now, since command line options are discarded
+	// after running a game.
+	const Common::String perfCSVFile = ConfMan.get("perf_csv");
+	if (!perfCSVFile.empty())
+		PerfMan.enable();
+
 	// Now as the event manager is created, setup the keymapper
 	setupKeymapper(system);
 
@@ -496,6 +510,18 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 		setupGraphics(system);
 		launcherDialog();
 	}
+
+	if (!perfCSVFile.empty()) {
+		Common::DumpFile file;
+		if (file.open(perfCSVFile)) {
+			PerfMan.writeCSV(file);
+			file.finalize();
+		} else {
+			warning("Could not write the performance counters to '%s'", perfCSVFile.c_str());
+		}
+		PerfMan.disable();
+	}
+
 	PluginManager::instance().unloadAllPlugins();
 	PluginManager::destroy();
 	GUI::GuiManager::destroy();
@@ -503,10 +529,14 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 	Common::DebugManager::destroy();
 	Common::EventRecorder::destroy();
 	Common::SearchManager::destroy();
+	Common::CoroutineScheduler::destroy();
 #ifdef USE_TRANSLATION
 	Common::TranslationManager::destroy();
 #endif
 	MusicManager::destroy();
+#ifdef USE_MAD
+	Audio::destroyMP3FrameIndexCache();
+#endif
 	Graphics::CursorManager::destroy();
 	Graphics::FontManager::destroy();
 #ifdef USE_FREETYPE2
@@ -130,6 +130,8 @@ EventRecorder::EventRecorder() {
 	_lastEventMillis = 0;
 
 	_recordMode = kPassthrough;
+	_timedemo = false;
+	_timedemoQuit = false;
 }
 
 EventRecorder::~EventRecorder() {
@@ -149,6 +151,10 @@ void EventRecorder::init() {
 		if (recordModeString.compareToIgnoreCase("playback") == 0) {
 			_recordMode = kRecorderPlayback;
 			debug(3, "EventRecorder: playback");
+		} else if (recordModeString.compareToIgnoreCase("timedemo") == 0) {
+			_recordMode = kRecorderPlayback;
+			_timedemo = true;
+			debug(3, "EventRecorder: timedemo");
 		} else {
 			_recordMode = kPassthrough;
 			debug(3, "EventRecorder: passthrough");
@@ -194,6 +200,9 @@ void EventRecorder::init() {
 			warning("Cannot open playback time file %s. Playback was switched off", _recordTimeFileName.c_str());
 			_recordMode = kPassthrough;
 		}
+
+		if (_recordMode == kPassthrough)
+			_timedemo = false;
 	}
 
 	if (_recordMode == kRecorderPlayback) {
@@ -325,7 +334,7 @@ void EventRecorder::processMillis(uint32 &millis) {
 		if (_recordTimeCount > _playbackTimeCount) {
 			d = readTime(_playbackTimeFile);
 
-			while ((_lastMillis + d > millis) && (_lastMillis + d - millis > 50)) {
+			while (!_timedemo && (_lastMillis + d > millis) && (_lastMillis + d - millis > 50)) {
 				_recordMode = kPassthrough;
 				g_system->delayMillis(50);
 				millis = g_system->getMillis();
@@ -334,6 +343,10 @@ void EventRecorder::processMillis(uint32 &millis) {
 
 			millis = _lastMillis + d;
 			_playbackTimeCount++;
+		} else if (_timedemo) {
+			// Keep the virtual clock running until the quit event got processed
+			millis = _lastMillis + 10;
+			_timedemoQuit = true;
 		}
 	}
 
@@ -343,6 +356,9 @@ void EventRecorder::processMillis(uint32 &millis) {
 
 bool EventRecorder::processDelayMillis(uint &msecs) {
 	if (_recordMode == kRecorderPlayback) {
+		if (_timedemo)
+			return true;
+
 		_recordMode = kPassthrough;
 
 		uint32 millis = g_system->getMillis();
@@ -397,6 +413,11 @@ bool EventRecorder::pollEvent(Event &ev) {
 			readRecord(_playbackFile, const_cast<uint32&>(_playbackDiff), _playbackEvent, millis);
 			_playbackCount++;
 			_hasPlaybackEvent = true;
+		} else if (_timedemo && _timedemoQuit) {
+			// The recording is over, end the session
+			_timedemoQuit = false;
+			ev.type = EVENT_QUIT;
+			return true;
 		}
 	}
 
@@ -59,6 +59,14 @@ public:
 	/** TODO: Add documentation, this is only used by the backend */
 	bool processDelayMillis(uint &msecs);
 
+	/**
+	 * Returns whether a recording is replayed in timedemo mode. In this mode
+	 * the recorded time is used as is, without waiting for it to pass, and
+	 * all delays are skipped. Once the recording is exhausted, a quit event is
+	 * sent to end the session.
+	 */
+	bool isTimedemo() const { return _timedemo; }
+
 private:
 	bool notifyEvent(const Event &ev);
 	bool notifyPoll();
@@ -100,6 +108,8 @@ private:
 		kRecorderPlayback = 2
 	};
 	volatile RecordMode _recordMode;
+	bool _timedemo;
+	bool _timedemoQuit;
 	String _recordFileName;
 	String _recordTempFileName;
 	String _recordTimeFileName;
@@ -22,6 +22,7 @@
 
 #include "common/archive.h"
 #include "common/fs.h"
+#include "common/perfcounters.h"
 #include "common/system.h"
 #include "common/textconsole.h"
 
@@ -92,6 +93,9 @@ void SearchSet::insert(const Node &node) {
 			break;
 	}
 	_list.insert(it, node);
+
+	if (_memberIndexValid)
+		indexArchive(*--it);
 }
 
 void SearchSet::add(const String &name, Archive *archive, int priority, bool autoFree) {
@@ -171,6 +175,8 @@ void SearchSet::addSubDirectoriesMatching(const FSNode &directory, String origPa
 void SearchSet::remove(const String &name) {
 	ArchiveNodeList::iterator it = find(name);
 	if (it != _list.end()) {
+		if (_memberIndexValid)
+			unindexArchive(*it);
 		if (it->_autoFree)
 			delete it->_arc;
 		_list.erase(it);
@@ -188,6 +194,8 @@ void SearchSet::clear() {
 	}
 
 	_list.clear();
+
+	invalidateIndex();
 }
 
 void SearchSet::setPriority(const String &name, int priority) {
@@ -200,23 +208,153 @@ void SearchSet::setPriority(const String &name, int priority) {
 	if (priority == it->_priority)
 		return;
 
+	if (_memberIndexValid)
+		unindexArchive(*it);
+
 	Node node(*it);
 	_list.erase(it);
 	node._priority = priority;
 	insert(node);
 }
 
-bool SearchSet::hasFile(const String &name) const {
-	if (name.empty())
+void SearchSet::invalidateIndex() {
+	_memberIndex.clear();
+	_memberIndexValid = false;
+}
+
+void SearchSet::buildIndex() const {
+	_memberIndex.clear();
+
+	ArchiveNodeList::const_iterator it = _list.begin();
+	for ( ; it != _list.end(); ++it)
+		indexArchive(*it);
+
+	_memberIndexValid = true;
+}
+
+/**
+ * Adds the members of an archive to the index, once it is in the list.
+ * Archives inserted later come after those of the same priority, so they
+ * only take over members from archives with a lower priority.
+ */
+void SearchSet::indexArchive(const Node &node) const {
+	ArchiveMemberList members;
+
+	// Archives which do not list any members are always asked directly,
+	// since they might still be able to provide some.
+	node._indexed = node._arc->listMembers(members) > 0;
+
+	for (ArchiveMemberList::const_iterator m = members.begin(); m != members.end(); ++m) {
+		const String name = (*m)->getName();
+		MemberIndex::iterator i = _memberIndex.find(name);
+		if (i == _memberIndex.end())
+			_memberIndex[name] = &node;
+		else if (i->_value->_priority < node._priority)
+			i->_value = &node;
+	}
+}
+
+/**
+ * Removes the members of an archive still in the list from the index.
+ * Its members are handed to the next indexed archive containing them.
+ */
+void SearchSet::unindexArchive(const Node &node) const {
+	if (!node._indexed)
+		return;
+
+	ArchiveMemberList members;
+	node._arc->listMembers(members);
+
+	for (ArchiveMemberList::const_iterator m = members.begin(); m != members.end(); ++m) {
+		const String name = (*m)->getName();
+		MemberIndex::iterator i = _memberIndex.find(name);
+		if (i == _memberIndex.end() || i->_value != &node)
+			continue;
+
+		ArchiveNodeList::const_iterator it = _list.begin();
+		for ( ; it != _list.end(); ++it) {
+			if (&*it != &node && it->_indexed && it->_arc->hasFile(name))
+				break;
+		}
+
+		if (it != _list.end())
+			i->_value = &*it;
+		else
+			_memberIndex.erase(i);
+	}
+}
+
+/**
+ * Looks up the archive which should provide the given member. Returns
+ * false in case the index can not be used for the name, in which case all
+ * archives have to be asked.
+ */
+bool SearchSet::lookupIndex(const String &name, const Node *&candidate) const {
+	candidate = 0;
+
+	// The index only knows about plain member names, while some archives
+	// also accept paths to members in sub directories.
+	if (name.contains('/') || name.contains('\\') || name.contains(':'))
 		return false;
 
+	if (!_memberIndexValid)
+		buildIndex();
+
+	MemberIndex::const_iterator i = _memberIndex.find(name);
+	if (i != _memberIndex.end())
+		candidate = i->_value;
+
+	return true;
+}
+
+/**
+ * Decides whether an archive needs to be asked for a member. With the
+ * index, only the archive it points to and archives not covered by it are
+ * asked. In case the archive from the index turns out not to have the
+ * member after all, the remaining archives are asked in a fallback pass.
+ */
+bool SearchSet::shouldProbe(const Node &node, bool useIndex, const Node *candidate, bool fallback) const {
+	if (!useIndex)
+		return true;
+
+	const bool skippedBefore = node._indexed && &node != candidate;
+	return fallback ? skippedBefore : !skippedBefore;
+}
+
+bool SearchSet::probeFile(const Node &node, const String &name) const {
+	node._lookups++;
+	if (node._arc->hasFile(name))
+		return true;
+
+	node._misses++;
+	return false;
+}
+
+const SearchSet::Node *SearchSet::findMember(const String &name) const {
+	const Node *candidate;
+	const bool useIndex = lookupIndex(name, candidate);
+
 	ArchiveNodeList::const_iterator it = _list.begin();
 	for ( ; it != _list.end(); ++it) {
-		if (it->_arc->hasFile(name))
-			return true;
+		if (shouldProbe(*it, useIndex, candidate, false) && probeFile(*it, name))
+			return &*it;
 	}
 
-	return false;
+	if (candidate) {
+		for (it = _list.begin(); it != _list.end(); ++it) {
+			if (shouldProbe(*it, useIndex, candidate, true) && probeFile(*it, name))
+				return &*it;
+		}
+	}
+
+	return 0;
+}
+
+bool SearchSet::hasFile(const String &name) const {
+	if (name.empty())
+		return false;
+
+	return findMember(name) != 0;
 }
 
 int SearchSet::listMatchingMembers(ArchiveMemberList &list, const String &pattern) const {
@@ -243,11 +381,9 @@ const ArchiveMemberPtr SearchSet::getMember(const String &name) const {
 	if (name.empty())
 		return ArchiveMemberPtr();
 
-	ArchiveNodeList::const_iterator it = _list.begin();
-	for ( ; it != _list.end(); ++it) {
-		if (it->_arc->hasFile(name))
-			return it->_arc->getMember(name);
-	}
+	const Node *node = findMember(name);
+	if (node)
+		return node->_arc->getMember(name);
 
 	return ArchiveMemberPtr();
 }
@@ -256,16 +392,49 @@ SeekableReadStream *SearchSet::createReadStreamForMember(const String &name) con
 	if (name.empty())
 		return 0;
 
+	const Node *candidate;
+	const bool useIndex = lookupIndex(name, candidate);
+
+	for (int pass = 0; pass < (candidate ? 2 : 1); ++pass) {
+		ArchiveNodeList::const_iterator it = _list.begin();
+		for ( ; it != _list.end(); ++it) {
+			if (!shouldProbe(*it, useIndex, candidate, pass == 1))
+				continue;
+
+			it->_lookups++;
+			SeekableReadStream *stream = it->_arc->createReadStreamForMember(name);
+			if (stream)
+				return stream;
+			it->_misses++;
+		}
+	}
+
+	return 0;
+}
+
+Array<SearchSet::ArchiveStats> SearchSet::getArchiveStats() const {
+	Array<ArchiveStats> stats;
+
 	ArchiveNodeList::const_iterator it = _list.begin();
 	for ( ; it != _list.end(); ++it) {
-		SeekableReadStream *stream = it->_arc->createReadStreamForMember(name);
-		if (stream)
-			return stream;
+		ArchiveStats s;
+		s.name = it->_name;
+		s.priority = it->_priority;
+		s.lookups = it->_lookups;
+		s.misses = it->_misses;
+		stats.push_back(s);
 	}
 
-	return 0;
+	return stats;
 }
 
+void SearchSet::resetArchiveStats() {
+	ArchiveNodeList::iterator it = _list.begin();
+	for ( ; it != _list.end(); ++it) {
+		it->_lookups = 0;
+		it->_misses = 0;
+	}
+}
 
 SearchManager::SearchManager() {
 	clear();	// Force a reset
@@ -285,6 +454,12 @@ void SearchManager::clear() {
 	addDirectory(".", ".", -2);
 }
 
+SeekableReadStream *SearchManager::createReadStreamForMember(const String &name) const {
+	perfCount(kPerfArchiveOpen);
+	PerfTimer timer(kPerfArchiveOpenTime);
+	return SearchSet::createReadStreamForMember(name);
+}
+
 DECLARE_SINGLETON(SearchManager);
 
 } // namespace Common
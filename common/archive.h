@@ -24,6 +24,9 @@
 #define COMMON_ARCHIVE_H
 
 #include "common/str.h"
+#include "common/array.h"
+#include "common/hash-str.h"
+#include "common/hashmap.h"
 #include "common/list.h"
 #include "common/ptr.h"
 #include "common/singleton.h"
@@ -133,20 +136,58 @@ class SearchSet : public Archive {
 		String	_name;
 		Archive	*_arc;
 		bool	_autoFree;
+
+		// Whether the members of the archive are part of the member index
+		mutable bool	_indexed;
+
+		// Lookup statistics
+		mutable uint32	_lookups;
+		mutable uint32	_misses;
+
 		Node(int priority, const String &name, Archive *arc, bool autoFree)
-			: _priority(priority), _name(name), _arc(arc), _autoFree(autoFree) {
+			: _priority(priority), _name(name), _arc(arc), _autoFree(autoFree),
+			  _indexed(false), _lookups(0), _misses(0) {
 		}
 	};
 	typedef List<Node> ArchiveNodeList;
 	ArchiveNodeList _list;
 
+	/**
+	 * Maps the member names of all archives to the archive with the
+	 * highest priority containing them. It is built lazily on the first
+	 * lookup, and then kept up to date when archives are added or removed.
+	 */
+	typedef HashMap<String, const Node *, IgnoreCase_Hash, IgnoreCase_EqualTo> MemberIndex;
+	mutable MemberIndex _memberIndex;
+	mutable bool _memberIndexValid;
+
 	ArchiveNodeList::iterator find(const String &name);
 	ArchiveNodeList::const_iterator find(const String &name) const;
 
 	// Add an archive keeping the list sorted by descending priority.
 	void insert(const Node& node);
 
+	void invalidateIndex();
+	void buildIndex() const;
+	void indexArchive(const Node &node) const;
+	void unindexArchive(const Node &node) const;
+	bool lookupIndex(const String &name, const Node *&candidate) const;
+	bool shouldProbe(const Node &node, bool useIndex, const Node *candidate, bool fallback) const;
+	bool probeFile(const Node &node, const String &name) const;
+	const Node *findMember(const String &name) const;
+
 public:
+	/**
+	 * Lookup statistics of a single archive.
+	 */
+	struct ArchiveStats {
+		String name;
+		int priority;
+		uint32 lookups;		///< How often the archive was asked for a member
+		uint32 misses;		///< How often it did not contain the member
+	};
+
+	SearchSet() : _memberIndexValid(false) {}
 	virtual ~SearchSet() { clear(); }
 
 	/**
@@ -241,6 +282,16 @@ public:
 	 * opening the first file encountered that matches the name.
 	 */
 	virtual SeekableReadStream *createReadStreamForMember(const String &name) const;
+
+	/**
+	 * Returns the lookup statistics of all archives, in search order.
+	 */
+	Array<ArchiveStats> getArchiveStats() const;
+
+	/**
+	 * Resets the lookup statistics of all archives.
+	 */
+	void resetArchiveStats();
 };
 
 
@@ -253,6 +304,12 @@ public:
 	 */
 	virtual void clear();
 
+	/**
+	 * Same as SearchSet::createReadStreamForMember(), but also counts the
+	 * files opened for the performance counters.
+	 */
+	virtual SeekableReadStream *createReadStreamForMember(const String &name) const;
+
 private:
 	friend class Singleton<SingletonBaseType>;
 	SearchManager();
@@ -24,6 +24,7 @@
 #include "common/debug.h"
 #include "common/hashmap.h"
 #include "common/hash-str.h"
+#include "common/memorypool.h"
 #include "common/system.h"
 #include "common/textconsole.h"
 
@@ -71,6 +72,70 @@ static void displayCoroStats() {
 } // End of anonymous namespace
 #endif
 
+namespace {
+
+enum {
+	// Contexts are pooled in size classes of this granularity (in bytes) ...
+	kContextSizeGranularity = 16,
+	// ... up to this number of size classes. Larger ones use malloc.
+	kContextSizeClasses = 32
+};
+
+/** Memory pools for coroutine contexts, created on demand */
+static MemoryPool *s_contextPools[kContextSizeClasses];
+
+/** Coroutine context allocation statistics */
+static uint s_contextsLive = 0;
+static uint s_contextsPeak = 0;
+static uint32 s_contextsAllocated = 0;
+
+/** Frees the memory pools, which must not have any live contexts left */
+static void freeContextPools() {
+	for (uint i = 0; i < kContextSizeClasses; i++) {
+		delete s_contextPools[i];
+		s_contextPools[i] = 0;
+	}
+}
+
+} // End of anonymous namespace
+
+void *CoroBaseContext::operator new(size_t size) {
+	const size_t sizeClass = (size + kContextSizeGranularity - 1) / kContextSizeGranularity - 1;
+
+	void *ptr;
+	if (sizeClass < kContextSizeClasses) {
+		if (!s_contextPools[sizeClass])
+			s_contextPools[sizeClass] = new MemoryPool((sizeClass + 1) * kContextSizeGranularity);
+		ptr = s_contextPools[sizeClass]->allocChunk();
+	} else {
+		ptr = malloc(size);
+	}
+
+	if (!ptr)
+		error("Cannot allocate memory for coroutine context");
+
+	++s_contextsAllocated;
+	if (++s_contextsLive > s_contextsPeak)
+		s_contextsPeak = s_contextsLive;
+
+	return ptr;
+}
+
+void CoroBaseContext::operator delete(void *ptr, size_t size) {
+	if (!ptr)
+		return;
+
+	const size_t sizeClass = (size + kContextSizeGranularity - 1) / kContextSizeGranularity - 1;
+	if (sizeClass < kContextSizeClasses) {
+		assert(s_contextPools[sizeClass]);
+		s_contextPools[sizeClass]->freeChunk(ptr);
+	} else {
+		free(ptr);
+	}
+
+	--s_contextsLive;
+}
+
 CoroBaseContext::CoroBaseContext(const char *func)
 	: _line(0), _sleep(0), _subctx(0) {
 #ifdef COROUTINE_DEBUG
@@ -107,6 +172,12 @@ CoroutineScheduler::CoroutineScheduler() {
 	pRCfunction = NULL;
 	pidCounter = 0;
 
+	_numTicks = 0;
+	_numDispatches = 0;
+	_numWakeups = 0;
+	_lastTickDispatches = 0;
+	_maxTickDispatches = 0;
+
 	active = new PROCESS;
 	active->pPrevious = NULL;
 	active->pNext = NULL;
@@ -130,9 +201,12 @@ CoroutineScheduler::~CoroutineScheduler() {
 	active = 0;
 
 	// Clear the event list
-	Common::List<EVENT *>::iterator i;
-	for (i = _events.begin(); i != _events.end(); ++i)
-		delete *i;
+	for (EventMap::iterator i = _events.begin(); i != _events.end(); ++i)
+		delete i->_value;
+
+	// The pools can only go once the contexts allocated from them are gone
+	if (s_contextsLive == 0)
+		freeContextPools();
 }
 
 void CoroutineScheduler::reset() {
@@ -165,6 +239,8 @@ void CoroutineScheduler::reset() {
 
 	// no active processes
 	pCurrent = active->pNext = NULL;
+	_processCounts.clear();
+	_waiters.clear();
 
 	// place first process on free list
 	pFreeProcesses = processList;
@@ -177,11 +253,16 @@ void CoroutineScheduler::reset() {
 }
 
 
-#ifdef DEBUG
 void CoroutineScheduler::printStats() {
+#ifdef DEBUG
 	debug("%i process of %i used", maxProcs, CORO_NUM_PROCESS);
-}
 #endif
+	debug("%u ticks, %u dispatches (%.2f per tick, %u last tick, %u max), %u waiter wakeups",
+	      _numTicks, _numDispatches, _numTicks ? (double)_numDispatches / _numTicks : 0.0,
+	      _lastTickDispatches, _maxTickDispatches, _numWakeups);
+	debug("%u coroutine contexts live, %u peak, %u allocated in total",
+	      s_contextsLive, s_contextsPeak, s_contextsAllocated);
+}
 
 #ifdef DEBUG
 void CoroutineScheduler::checkStack() {
@@ -219,6 +300,8 @@ void CoroutineScheduler::checkStack() {
 #endif
 
 void CoroutineScheduler::schedule() {
+	uint dispatches = 0;
+
 	// start dispatching active process list
 	PROCESS *pNext;
 	PROCESS *pProc = active->pNext;
@@ -229,6 +312,7 @@ void CoroutineScheduler::schedule() {
 			// process is ready for dispatch, activate it
 			pCurrent = pProc;
 			pProc->coroAddr(pProc->state, pProc->param);
+			++dispatches;
 
 			if (!pProc->state || pProc->state->_sleep <= 0) {
 				// Coroutine finished
@@ -247,13 +331,18 @@ void CoroutineScheduler::schedule() {
 	}
 
 	// Disable any events that were pulsed
-	Common::List<EVENT *>::iterator i;
-	for (i = _events.begin(); i != _events.end(); ++i) {
-		EVENT *evt = *i;
-		if (evt->pulsing) {
+	for (Common::Array<uint32>::const_iterator i = _pulsedEvents.begin(); i != _pulsedEvents.end(); ++i) {
+		EVENT *evt = getEvent(*i);
+		if (evt && evt->pulsing) {
 			evt->pulsing = evt->signalled = false;
 		}
 	}
+	_pulsedEvents.clear();
+
+	++_numTicks;
+	_numDispatches += dispatches;
+	_lastTickDispatches = dispatches;
+	_maxTickDispatches = MAX(_maxTickDispatches, dispatches);
 }
 
 void CoroutineScheduler::rescheduleAll() {
@@ -347,13 +436,14 @@ void CoroutineScheduler::waitForSingleObject(CORO_PARAM, int pid, uint32 duratio
 
 	CORO_BEGIN_CONTEXT;
 		uint32 endTime;
-		PROCESS *pProcess;
+		bool processActive;
 		EVENT *pEvent;
 	CORO_END_CONTEXT(_ctx);
 
 	CORO_BEGIN_CODE(_ctx);
 
 	// Signal the process Id this process is now waiting for
+	Common::fill(&pCurrent->pidWaiting[0], &pCurrent->pidWaiting[CORO_MAX_PID_WAITING], 0);
 	pCurrent->pidWaiting[0] = pid;
 
 	_ctx->endTime = (duration == CORO_INFINITE) ? CORO_INFINITE : g_system->getMillis() + duration;
@@ -364,12 +454,12 @@ void CoroutineScheduler::waitForSingleObject(CORO_PARAM, int pid, uint32 duratio
 	// Outer loop for doing checks until expiry
 	while (g_system->getMillis() <= _ctx->endTime) {
 		// Check to see if a process or event with the given Id exists
-		_ctx->pProcess = getProcess(pid);
-		_ctx->pEvent = !_ctx->pProcess ? getEvent(pid) : NULL;
+		_ctx->processActive = isProcessActive(pid);
+		_ctx->pEvent = !_ctx->processActive ? getEvent(pid) : NULL;
 
 		// If there's no active process or event, presume it's a process that's finished,
 		// so the waiting can immediately exit
-		if ((_ctx->pProcess == NULL) && (_ctx->pEvent == NULL)) {
+		if (!_ctx->processActive && (_ctx->pEvent == NULL)) {
 			if (expired)
 				*expired = false;
 			break;
@@ -387,8 +477,15 @@ void CoroutineScheduler::waitForSingleObject(CORO_PARAM, int pid, uint32 duratio
 			break;
 		}
 
-		// Sleep until the next cycle
-		CORO_SLEEP(1);
+		if (duration == CORO_INFINITE && pid != CORO_INVALID_PID_VALUE) {
+			// Without a timeout there is nothing to check until the process
+			// or event changes, so sleep until it wakes us up.
+			parkCurrentProcess();
+			CORO_SLEEP(CORO_PARKED_SLEEP);
+		} else {
+			// Sleep until the next cycle
+			CORO_SLEEP(1);
+		}
 	}
 
 	// Signal waiting is done
@@ -406,8 +503,9 @@ void CoroutineScheduler::waitForMultipleObjects(CORO_PARAM, int nCount, uint32 *
 		uint32 endTime;
 		bool signalled;
 		bool pidSignalled;
+		bool canPark;
 		int i;
-		PROCESS *pProcess;
+		bool processActive;
 		EVENT *pEvent;
 	CORO_END_CONTEXT(_ctx);
 
@@ -415,8 +513,15 @@ void CoroutineScheduler::waitForMultipleObjects(CORO_PARAM, int nCount, uint32 *
 
 	// Signal the waiting events
 	assert(nCount < CORO_MAX_PID_WAITING);
+	Common::fill(&pCurrent->pidWaiting[0], &pCurrent->pidWaiting[CORO_MAX_PID_WAITING], 0);
 	Common::copy(pidList, pidList + nCount, pCurrent->pidWaiting);
 
+	_ctx->canPark = (duration == CORO_INFINITE);
+	for (_ctx->i = 0; _ctx->i < nCount; ++_ctx->i) {
+		if (pidList[_ctx->i] == CORO_INVALID_PID_VALUE)
+			_ctx->canPark = false;
+	}
+
 	_ctx->endTime = (duration == CORO_INFINITE) ? CORO_INFINITE : g_system->getMillis() + duration;
 	if (expired)
 		// Presume that delay will expire
@@ -427,11 +532,11 @@ void CoroutineScheduler::waitForMultipleObjects(CORO_PARAM, int nCount, uint32 *
 		_ctx->signalled = bWaitAll;
 
 		for (_ctx->i = 0; _ctx->i < nCount; ++_ctx->i) {
-			_ctx->pProcess = getProcess(pidList[_ctx->i]);
-			_ctx->pEvent = !_ctx->pProcess ? getEvent(pidList[_ctx->i]) : NULL;
+			_ctx->processActive = isProcessActive(pidList[_ctx->i]);
+			_ctx->pEvent = !_ctx->processActive ? getEvent(pidList[_ctx->i]) : NULL;
 
 			// Determine the signalled state
-			_ctx->pidSignalled = (_ctx->pProcess) || !_ctx->pEvent ? false : _ctx->pEvent->signalled;
+			_ctx->pidSignalled = _ctx->processActive || !_ctx->pEvent ? false : _ctx->pEvent->signalled;
 
 			if (bWaitAll && !_ctx->pidSignalled)
 				_ctx->signalled = false;
@@ -454,8 +559,15 @@ void CoroutineScheduler::waitForMultipleObjects(CORO_PARAM, int nCount, uint32 *
 			break;
 		}
 
-		// Sleep until the next cycle
-		CORO_SLEEP(1);
+		if (_ctx->canPark) {
+			// Nothing to check until one of the processes or events
+			// changes, so sleep until we are woken up.
+			parkCurrentProcess();
+			CORO_SLEEP(CORO_PARKED_SLEEP);
+		} else {
+			// Sleep until the next cycle
+			CORO_SLEEP(1);
+		}
 	}
 
 	// Signal waiting is done
@@ -538,6 +650,10 @@ PROCESS *CoroutineScheduler::createProcess(uint32 pid, CORO_ADDR coroAddr, const
 
 	// set new process id
 	pProc->pid = pid;
+	++_processCounts[pid];
+
+	// not waiting for anything yet, the free list may still hold garbage
+	Common::fill(&pProc->pidWaiting[0], &pProc->pidWaiting[CORO_MAX_PID_WAITING], 0);
 
 	// set new process specific info
 	if (sizeParam) {
@@ -580,6 +696,11 @@ void CoroutineScheduler::killProcess(PROCESS *pKillProc) {
 	delete pKillProc->state;
 	pKillProc->state = 0;
 
+	unparkProcess(pKillProc);
+	Common::fill(&pKillProc->pidWaiting[0], &pKillProc->pidWaiting[CORO_MAX_PID_WAITING], 0);
+	if (--_processCounts[pKillProc->pid] == 0)
+		_processCounts.erase(pKillProc->pid);
+
 	// Take the process out of the active chain list
 	pKillProc->pPrevious->pNext = pKillProc->pNext;
 	if (pKillProc->pNext)
@@ -593,6 +714,9 @@ void CoroutineScheduler::killProcess(PROCESS *pKillProc) {
 
 	// make pKillProc the first free process
 	pFreeProcesses = pKillProc;
+
+	// Let anybody waiting for the process check again
+	wakeWaiters(pKillProc->pid);
 }
 
 PROCESS *CoroutineScheduler::getCurrentProcess() {
@@ -629,6 +753,12 @@ int CoroutineScheduler::killMatchingProcess(uint32 pidKill, int pidMask) {
 				delete pProc->state;
 				pProc->state = 0;
 
+				unparkProcess(pProc);
+				Common::fill(&pProc->pidWaiting[0], &pProc->pidWaiting[CORO_MAX_PID_WAITING], 0);
+				if (--_processCounts[pProc->pid] == 0)
+					_processCounts.erase(pProc->pid);
+				wakeWaiters(pProc->pid);
+
 				// make prev point to next to unlink pProc
 				pPrev->pNext = pProc->pNext;
 				if (pProc->pNext)
@@ -662,23 +792,64 @@ void CoroutineScheduler::setResourceCallback(VFPTRPP pFunc) {
 	pRCfunction = pFunc;
 }
 
-PROCESS *CoroutineScheduler::getProcess(uint32 pid) {
-	PROCESS *pProc = active->pNext;
-	while ((pProc != NULL) && (pProc->pid != pid))
-		pProc = pProc->pNext;
-
-	return pProc;
+bool CoroutineScheduler::isProcessActive(uint32 pid) const {
+	return _processCounts.contains(pid);
 }
 
 EVENT *CoroutineScheduler::getEvent(uint32 pid) {
-	Common::List<EVENT *>::iterator i;
-	for (i = _events.begin(); i != _events.end(); ++i) {
-		EVENT *evt = *i;
-		if (evt->pid == pid)
-			return evt;
+	EventMap::const_iterator i = _events.find(pid);
+	return (i != _events.end()) ? i->_value : NULL;
+}
+
+void CoroutineScheduler::parkCurrentProcess() {
+	assert(pCurrent);
+
+	for (int i = 0; i < CORO_MAX_PID_WAITING; ++i) {
+		if (pCurrent->pidWaiting[i] != CORO_INVALID_PID_VALUE)
+			_waiters[pCurrent->pidWaiting[i]].push_back(pCurrent);
+	}
+}
+
+void CoroutineScheduler::unparkProcess(PROCESS *pProc) {
+	for (int i = 0; i < CORO_MAX_PID_WAITING; ++i) {
+		const uint32 pid = pProc->pidWaiting[i];
+		if (pid == CORO_INVALID_PID_VALUE)
+			continue;
+
+		WaiterMap::iterator waiters = _waiters.find(pid);
+		if (waiters == _waiters.end())
+			continue;
+
+		Common::Array<PROCESS *> &list = waiters->_value;
+		for (uint j = 0; j < list.size(); ) {
+			if (list[j] == pProc)
+				list.remove_at(j);
+			else
+				++j;
+		}
+
+		if (list.empty())
+			_waiters.erase(pid);
 	}
+}
+
+void CoroutineScheduler::wakeWaiters(uint32 pid) {
+	WaiterMap::iterator waiters = _waiters.find(pid);
+	if (waiters == _waiters.end())
+		return;
 
-	return NULL;
+	// Unparking modifies the wait lists, thus work on a copy
+	const Common::Array<PROCESS *> list = waiters->_value;
+	for (Common::Array<PROCESS *>::const_iterator i = list.begin(); i != list.end(); ++i) {
+		PROCESS *pProc = *i;
+		unparkProcess(pProc);
+
+		// Dispatch the process the next time the scheduler reaches it, just
+		// like it would have been when polling every cycle
+		if (pProc->sleepTime > 1)
+			pProc->sleepTime = 1;
+		++_numWakeups;
+	}
 }
 
 
@@ -689,22 +860,27 @@ uint32 CoroutineScheduler::createEvent(bool bManualReset, bool bInitialState) {
 	evt->signalled = bInitialState;
 	evt->pulsing = false;
 
-	_events.push_back(evt);
+	_events[evt->pid] = evt;
 	return evt->pid;
 }
 
 void CoroutineScheduler::closeEvent(uint32 pidEvent) {
 	EVENT *evt = getEvent(pidEvent);
 	if (evt) {
-		_events.remove(evt);
+		_events.erase(pidEvent);
 		delete evt;
+
+		// Waiting for a closed event ends the wait
+		wakeWaiters(pidEvent);
 	}
 }
 
 void CoroutineScheduler::setEvent(uint32 pidEvent) {
 	EVENT *evt = getEvent(pidEvent);
-	if (evt)
+	if (evt) {
 		evt->signalled = true;
+		wakeWaiters(pidEvent);
+	}
 }
 
 void CoroutineScheduler::resetEvent(uint32 pidEvent) {
@@ -721,6 +897,8 @@ void CoroutineScheduler::pulseEvent(uint32 pidEvent) {
 	// Set the event as signalled and pulsing
 	evt->signalled = true;
 	evt->pulsing = true;
+	_pulsedEvents.push_back(pidEvent);
+	wakeWaiters(pidEvent);
 
 	// If there's an active process, and it's not the first in the queue, then reschedule all
 	// the other prcoesses in the queue to run again this frame
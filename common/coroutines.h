@@ -24,6 +24,8 @@
 
 #include "common/scummsys.h"
 #include "common/util.h"    // for SCUMMVM_CURRENT_FUNCTION
+#include "common/array.h"
+#include "common/hashmap.h"
 #include "common/list.h"
 #include "common/singleton.h"
 
@@ -65,6 +67,13 @@ struct CoroBaseContext {
 	 * Destructor for coroutine context
 	 */
 	virtual ~CoroBaseContext();
+
+	/**
+	 * Coroutine contexts are created and destroyed at a high rate, thus
+	 * they are allocated from memory pools, one for each size class.
+	 */
+	static void *operator new(size_t size);
+	static void operator delete(void *ptr, size_t size);
 };
 
 typedef CoroBaseContext *CoroContext;
@@ -292,6 +301,10 @@ public:
 #define CORO_INFINITE 0xffffffff
 #define CORO_INVALID_PID_VALUE 0
 
+// the sleep time of processes parked on a wait list, i.e. processes which
+// are only woken up again by the object they are waiting for
+#define CORO_PARKED_SLEEP 0x7fffffff
+
 /** Coroutine parameter for methods converted to coroutines */
 typedef void (*CORO_ADDR)(CoroContext &, const void *);
 
@@ -357,8 +370,28 @@ private:
 	/** Auto-incrementing process Id */
 	int pidCounter;
 
-	/** Event list */
-	Common::List<EVENT *> _events;
+	typedef Common::HashMap<uint32, EVENT *> EventMap;
+	typedef Common::HashMap<uint32, int> ProcessCountMap;
+	typedef Common::HashMap<uint32, Common::Array<PROCESS *> > WaiterMap;
+
+	/** Events indexed by their Id */
+	EventMap _events;
+
+	/** Events pulsed during the current tick */
+	Common::Array<uint32> _pulsedEvents;
+
+	/** Number of active processes per process Id */
+	ProcessCountMap _processCounts;
+
+	/** Processes parked until the process or event with the given Id changes */
+	WaiterMap _waiters;
+
+	// scheduler statistics
+	uint32 _numTicks;
+	uint32 _numDispatches;
+	uint32 _numWakeups;
+	uint _lastTickDispatches;
+	uint _maxTickDispatches;
 
 #ifdef DEBUG
 	// diagnostic process counters
@@ -378,20 +411,36 @@ private:
 	 */
 	VFPTRPP pRCfunction;
 
-	PROCESS *getProcess(uint32 pid);
+	bool isProcessActive(uint32 pid) const;
 	EVENT *getEvent(uint32 pid);
+
+	/**
+	 * Adds the current process to the wait lists of all Ids in its
+	 * pidWaiting list. The process then has to sleep for CORO_PARKED_SLEEP.
+	 */
+	void parkCurrentProcess();
+
+	/**
+	 * Removes the given process from all wait lists it is on.
+	 */
+	void unparkProcess(PROCESS *pProc);
+
+	/**
+	 * Wakes up all processes waiting for the given process or event Id,
+	 * so that they are dispatched again on the next opportunity.
+	 */
+	void wakeWaiters(uint32 pid);
 public:
 	/**
 	 * Kills all processes and places them on the free list.
 	 */
 	void reset();
 
-#ifdef DEBUG
 	/**
-	 * Shows the maximum number of process used at once.
+	 * Shows scheduler statistics, like the number of dispatches per tick and
+	 * (in debug builds) the maximum number of process used at once.
 	 */
 	void printStats();
-#endif
 
 	/**
 	 * Give all active processes a chance to run
@@ -115,10 +115,9 @@ private:
 	typedef HashMap<String, DebugChannel, IgnoreCase_Hash, IgnoreCase_EqualTo> DebugChannelMap;
 
 	DebugChannelMap gDebugChannels;
-	uint32 gDebugChannelsEnabled;
 
 	friend class Singleton<SingletonBaseType>;
-	DebugManager() : gDebugChannelsEnabled(0) {}
+	DebugManager() {}
 };
 
 /** Shortcut for accessing the debug manager. */
@@ -29,6 +29,7 @@
 
 // TODO: Move gDebugLevel into namespace Common.
 int gDebugLevel = -1;
+uint32 gDebugChannelsEnabled = 0;
 
 namespace Common {
 
@@ -161,10 +162,8 @@ void debugN(int level, const char *s, ...) {
 void debugC(int level, uint32 debugChannels, const char *s, ...) {
 	va_list va;
 
-	// Debug level 11 turns on all special debug level messages
-	if (gDebugLevel != 11)
-		if (level > gDebugLevel || !(DebugMan.isDebugChannelEnabled(debugChannels)))
-			return;
+	if (!debugChannelSet(level, debugChannels))
+		return;
 
 	va_start(va, s);
 	debugHelper(s, va);
@@ -174,10 +173,8 @@ void debugC(int level, uint32 debugChannels, const char *s, ...) {
 void debugCN(int level, uint32 debugChannels, const char *s, ...) {
 	va_list va;
 
-	// Debug level 11 turns on all special debug level messages
-	if (gDebugLevel != 11)
-		if (level > gDebugLevel || !(DebugMan.isDebugChannelEnabled(debugChannels)))
-			return;
+	if (!debugChannelSet(level, debugChannels))
+		return;
 
 	va_start(va, s);
 	debugHelper(s, va, false);
@@ -187,10 +184,8 @@ void debugCN(int level, uint32 debugChannels, const char *s, ...) {
 void debugC(uint32 debugChannels, const char *s, ...) {
 	va_list va;
 
-	// Debug level 11 turns on all special debug level messages
-	if (gDebugLevel != 11)
-		if (!(DebugMan.isDebugChannelEnabled(debugChannels)))
-			return;
+	if (!debugChannelSet(-1, debugChannels))
+		return;
 
 	va_start(va, s);
 	debugHelper(s, va);
@@ -200,10 +195,8 @@ void debugC(uint32 debugChannels, const char *s, ...) {
 void debugCN(uint32 debugChannels, const char *s, ...) {
 	va_list va;
 
-	// Debug level 11 turns on all special debug level messages
-	if (gDebugLevel != 11)
-		if (!(DebugMan.isDebugChannelEnabled(debugChannels)))
-			return;
+	if (!debugChannelSet(-1, debugChannels))
+		return;
 
 	va_start(va, s);
 	debugHelper(s, va, false);
@@ -117,5 +117,32 @@ void debugCN(uint32 debugChannels, const char *s, ...) GCC_PRINTF(2, 3);
  */
 extern int gDebugLevel;
 
+/**
+ * The mask of all enabled engine debug channels. It is kept up to date by the
+ * DebugManager, and only exists separately so it can be checked inline.
+ */
+extern uint32 gDebugChannelsEnabled;
+
+/**
+ * Test whether debugC/debugCN would print a message with the given level and
+ * debug channels. Hot code paths can guard their debug output with this: a
+ * disabled channel then costs a single inline check, instead of a varargs
+ * call with all its arguments evaluated.
+ *
+ * @param level			the debug level, -1 to only check the channels
+ * @param debugChannels	the debug channels
+ */
+#ifdef DISABLE_TEXT_CONSOLE
+inline bool debugChannelSet(int level, uint32 debugChannels) { return false; }
+#else
+inline bool debugChannelSet(int level, uint32 debugChannels) {
+	// Debug level 11 turns on all special debug level messages
+	if (gDebugLevel == 11)
+		return true;
+
+	return (gDebugChannelsEnabled & debugChannels) != 0 && level <= gDebugLevel;
+}
+#endif
+
 
 #endif
@@ -125,6 +125,10 @@ bool FSNode::isWritable() const {
 }
 
 SeekableReadStream *FSNode::createReadStream() const {
+	return createReadStreamForData(0);
+}
+
+SeekableReadStream *FSNode::createReadStreamForData(uint32 mapThreshold) const {
 	if (_realNode == 0)
 		return 0;
 
@@ -136,6 +140,8 @@ SeekableReadStream *FSNode::createReadStream() const {
 		return 0;
 	}
 
+	if (mapThreshold)
+		return _realNode->createReadStreamForData(mapThreshold);
 	return _realNode->createReadStream();
 }
 
@@ -152,21 +158,21 @@ WriteStream *FSNode::createWriteStream() const {
 }
 
 FSDirectory::FSDirectory(const FSNode &node, int depth, bool flat)
-  : _node(node), _cached(false), _depth(depth), _flat(flat) {
+  : _node(node), _cached(false), _depth(depth), _flat(flat), _mapThreshold(0) {
 }
 
 FSDirectory::FSDirectory(const String &prefix, const FSNode &node, int depth, bool flat)
-  : _node(node), _cached(false), _depth(depth), _flat(flat) {
+  : _node(node), _cached(false), _depth(depth), _flat(flat), _mapThreshold(0) {
 
 	setPrefix(prefix);
 }
 
 FSDirectory::FSDirectory(const String &name, int depth, bool flat)
-  : _node(name), _cached(false), _depth(depth), _flat(flat) {
+  : _node(name), _cached(false), _depth(depth), _flat(flat), _mapThreshold(0) {
 }
 
 FSDirectory::FSDirectory(const String &prefix, const String &name, int depth, bool flat)
-  : _node(name), _cached(false), _depth(depth), _flat(flat) {
+  : _node(name), _cached(false), _depth(depth), _flat(flat), _mapThreshold(0) {
 
 	setPrefix(prefix);
 }
@@ -229,7 +235,7 @@ SeekableReadStream *FSDirectory::createReadStreamForMember(const String &name) c
 	FSNode *node = lookupCache(_fileCache, name);
 	if (!node)
 		return 0;
-	SeekableReadStream *stream = node->createReadStream();
+	SeekableReadStream *stream = node->createReadStreamForData(_mapThreshold);
 	if (!stream)
 		warning("FSDirectory::createReadStreamForMember: Can't create stream for file '%s'", name.c_str());
 
@@ -248,7 +254,9 @@ FSDirectory *FSDirectory::getSubDirectory(const String &prefix, const String &na
 	if (!node)
 		return 0;
 
-	return new FSDirectory(prefix, *node, depth, flat);
+	FSDirectory *dir = new FSDirectory(prefix, *node, depth, flat);
+	dir->setMapThreshold(_mapThreshold);
+	return dir;
 }
 
 void FSDirectory::cacheDirectoryRecursive(FSNode node, int depth, const String& prefix) const {
@@ -214,6 +214,16 @@ public:
 	 */
 	virtual SeekableReadStream *createReadStream() const;
 
+	/**
+	 * Creates a SeekableReadStream instance for a file holding read-only
+	 * data, like the files of a game, which must not change while the
+	 * stream exists. Files of at least mapThreshold bytes may be mapped
+	 * into memory by the backend, 0 never maps them.
+	 *
+	 * @return pointer to the stream object, 0 in case of a failure
+	 */
+	SeekableReadStream *createReadStreamForData(uint32 mapThreshold) const;
+
 	/**
 	 * Creates a WriteStream instance corresponding to the file
 	 * referred by this node. This assumes that the node actually refers
@@ -271,6 +281,7 @@ class FSDirectory : public Archive {
 	mutable bool _cached;
 	mutable int	_depth;
 	mutable bool _flat;
+	uint32 _mapThreshold;
 
 	// look for a match
 	FSNode *lookupCache(NodeCache &cache, const String &name) const;
@@ -306,6 +317,14 @@ public:
 	 */
 	FSNode getFSNode() const;
 
+	/**
+	 * Declares the files of the directory to be read-only data, so that
+	 * files of at least threshold bytes may be mapped into memory when
+	 * opened. 0, the default, never maps them. Sub directories created
+	 * afterwards inherit the threshold.
+	 */
+	void setMapThreshold(uint32 threshold) { _mapThreshold = threshold; }
+
 	/**
 	 * Create a new FSDirectory pointing to a sub directory of the instance. See class comment
 	 * for an explanation of the prefix parameter.
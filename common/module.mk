@@ -23,6 +23,7 @@ MODULE_OBJS := \
 	memorypool.o \
 	md5.o \
 	mutex.o \
+	perfcounters.o \
 	platform.o \
 	quicktime.o \
 	random.o \
@@ -33,6 +34,7 @@ MODULE_OBJS := \
 	system.o \
 	textconsole.o \
 	tokenizer.o \
+	trace.o \
 	translation.o \
 	unarj.o \
 	unzip.o \
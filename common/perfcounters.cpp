@@ -0,0 +1,182 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/perfcounters.h"
+#include "common/stream.h"
+#include "common/system.h"
+#include "common/util.h"
+
+volatile bool gPerfCountersEnabled = false;
+
+namespace Common {
+
+DECLARE_SINGLETON(PerfCounterManager);
+
+static const struct {
+	const char *name;
+	PerfCounterManager::Type type;
+} s_standardCounters[kPerfStandardCounters] = {
+	{ "frame",         PerfCounterManager::kTypeTimer },
+	{ "engine",        PerfCounterManager::kTypeTimer },
+	{ "delay",         PerfCounterManager::kTypeTimer },
+	{ "updateScreen",  PerfCounterManager::kTypeTimer },
+	{ "scaler",        PerfCounterManager::kTypeTimer },
+	{ "mixer",         PerfCounterManager::kTypeTimer },
+	{ "videoDecode",   PerfCounterManager::kTypeTimer },
+	{ "archiveOpens",  PerfCounterManager::kTypeCount },
+	{ "archiveOpen",   PerfCounterManager::kTypeTimer }
+};
+
+PerfCounterManager::PerfCounterManager() : _numCounters(0), _users(0), _frames(0), _windowFrames(0), _lastFrameTime(0) {
+	for (uint i = 0; i < kPerfStandardCounters; ++i)
+		registerCounter(s_standardCounters[i].name, s_standardCounters[i].type);
+}
+
+int PerfCounterManager::registerCounter(const char *name, Type type) {
+	StackLock lock(_mutex);
+
+	if (_numCounters == kMaxCounters)
+		return -1;
+
+	Counter &counter = _counters[_numCounters];
+	counter.name = name;
+	counter.type = type;
+	counter.frameValue = 0;
+	counter.maxFrameValue = 0;
+	counter.total = 0;
+	counter.windowTotal = 0;
+
+	return _numCounters++;
+}
+
+void PerfCounterManager::enable() {
+	if (!_users++) {
+		reset();
+		gPerfCountersEnabled = true;
+	}
+}
+
+void PerfCounterManager::disable() {
+	assert(_users);
+	if (!--_users)
+		gPerfCountersEnabled = false;
+}
+
+void PerfCounterManager::reset() {
+	StackLock lock(_mutex);
+
+	for (uint i = 0; i < _numCounters; ++i) {
+		Counter &counter = _counters[i];
+		counter.frameValue = 0;
+		counter.maxFrameValue = 0;
+		counter.total = 0;
+		counter.windowTotal = 0;
+	}
+
+	_frames = 0;
+	_windowFrames = 0;
+	_lastFrameTime = 0;
+}
+
+void PerfCounterManager::endFrame() {
+	if (!gPerfCountersEnabled)
+		return;
+
+	// The first call only marks the start of the first frame
+	const uint64 now = g_system->getMicros();
+	StackLock lock(_mutex);
+	if (_lastFrameTime) {
+		const uint32 frameTime = (uint32)(now - _lastFrameTime);
+		const uint32 knownTime = _counters[kPerfUpdateScreen].frameValue + _counters[kPerfDelay].frameValue;
+		_counters[kPerfFrame].frameValue += frameTime;
+		_counters[kPerfEngine].frameValue += frameTime > knownTime ? frameTime - knownTime : 0;
+
+		for (uint i = 0; i < _numCounters; ++i) {
+			Counter &counter = _counters[i];
+			const uint32 value = counter.frameValue;
+			counter.frameValue = 0;
+
+			counter.maxFrameValue = MAX(counter.maxFrameValue, value);
+			counter.total += value;
+			counter.windowTotal += value;
+		}
+
+		++_frames;
+		++_windowFrames;
+	} else {
+		for (uint i = 0; i < _numCounters; ++i)
+			_counters[i].frameValue = 0;
+	}
+
+	_lastFrameTime = now;
+}
+
+void PerfCounterManager::add(uint id, uint32 value) {
+	StackLock lock(_mutex);
+	_counters[id].frameValue += value;
+}
+
+String PerfCounterManager::formatOverlayText() {
+	StackLock lock(_mutex);
+	const uint32 frameTime = _windowFrames ? _counters[kPerfFrame].windowTotal / _windowFrames : 0;
+	String text = String::format("%u fps", frameTime ? (uint)(1000000 / frameTime) : 0);
+
+	for (uint i = 0; i < _numCounters; ++i) {
+		Counter &counter = _counters[i];
+		const uint32 average = _windowFrames ? counter.windowTotal / _windowFrames : 0;
+
+		if (counter.type == kTypeTimer)
+			text += String::format("\n%s: %u.%02u ms", counter.name, average / 1000, average % 1000 / 10);
+		else
+			text += String::format("\n%s: %u", counter.name, average);
+
+		counter.windowTotal = 0;
+	}
+
+	_windowFrames = 0;
+	return text;
+}
+
+void PerfCounterManager::writeCSV(WriteStream &stream) const {
+	StackLock lock(_mutex);
+	stream.writeString("counter,unit,frames,total,average,max\n");
+
+	for (uint i = 0; i < _numCounters; ++i) {
+		const Counter &counter = _counters[i];
+		const uint32 average = _frames ? counter.total / _frames : 0;
+
+		// Not all our compilers support printing 64 bit integers
+		stream.writeString(String::format("%s,%s,%u,%.0f,%u,%u\n", counter.name,
+		                                  counter.type == kTypeTimer ? "us" : "count", _frames,
+		                                  (double)counter.total, average, counter.maxFrameValue));
+	}
+}
+
+uint64 perfTimerStart() {
+	return g_system->getMicros();
+}
+
+void perfTimerStop(uint id, uint64 start) {
+	PerfMan.add(id, (uint32)(g_system->getMicros() - start));
+}
+
+} // End of namespace Common
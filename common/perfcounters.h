@@ -0,0 +1,181 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_PERFCOUNTERS_H
+#define COMMON_PERFCOUNTERS_H
+
+#include "common/scummsys.h"
+#include "common/mutex.h"
+#include "common/singleton.h"
+#include "common/str.h"
+
+/**
+ * Whether the performance counters are currently updated. Only the
+ * PerfCounterManager should change this, it is exposed so that the counters
+ * can be checked inline.
+ */
+extern volatile bool gPerfCountersEnabled;
+
+namespace Common {
+
+class WriteStream;
+
+/**
+ * The counters every backend and the common code update. Engines can
+ * register additional ones with PerfCounterManager::registerCounter().
+ */
+enum PerfCounterId {
+	kPerfFrame = 0,			///< Time between two screen updates
+	kPerfEngine,			///< Frame time not spent in updateScreen or delayMillis
+	kPerfDelay,				///< Time spent in OSystem::delayMillis
+	kPerfUpdateScreen,		///< Time spent in OSystem::updateScreen
+	kPerfScaler,			///< Time spent scaling the screen, part of kPerfUpdateScreen
+	kPerfMixer,				///< Time spent in the mixer callback
+	kPerfVideoDecode,		///< Time spent in VideoDecoder::decodeNextFrame
+	kPerfArchiveOpen,		///< Number of files opened through SearchMan
+	kPerfArchiveOpenTime,	///< Time spent opening files through SearchMan
+
+	kPerfStandardCounters
+};
+
+/**
+ * A registry of named per frame counters and timers.
+ *
+ * Every counter accumulates values during a frame, which ends whenever the
+ * backend calls endFrame() from its updateScreen implementation. The total
+ * and the maximum value per frame are kept for each counter.
+ * Timers are counters which accumulate microseconds.
+ *
+ * Counters may be updated from any thread, like the mixer one, while the
+ * main thread rolls them over at the end of a frame. A mutex serializes all
+ * of this, which is only taken while the counters are enabled.
+ */
+class PerfCounterManager : public Singleton<PerfCounterManager> {
+public:
+	enum Type {
+		kTypeCount,
+		kTypeTimer
+	};
+
+	/**
+	 * Registers an additional counter.
+	 *
+	 * @param name	the name used in the overlay and in the CSV file, which
+	 *				has to stay valid
+	 * @return the id of the new counter, or -1 if there is no free one left
+	 */
+	int registerCounter(const char *name, Type type);
+
+	/**
+	 * Starts updating the counters. Calls to enable() and disable() nest,
+	 * so the overlay and the CSV dump can request the counters independently.
+	 */
+	void enable();
+	void disable();
+
+	bool isEnabled() const { return gPerfCountersEnabled; }
+
+	/** Resets all counters. */
+	void reset();
+
+	void add(uint id, uint32 value);
+
+	/** Ends the current frame. This is called by the backends. */
+	void endFrame();
+
+	uint32 getFrameCount() const { return _frames; }
+
+	/**
+	 * Returns a text for displaying the counters on screen, one line per
+	 * counter. The values are averaged over the frames since the last call.
+	 */
+	String formatOverlayText();
+
+	/** Writes the totals, averages and maxima of all counters as CSV. */
+	void writeCSV(WriteStream &stream) const;
+
+private:
+	friend class Singleton<SingletonBaseType>;
+	PerfCounterManager();
+
+	enum {
+		kMaxCounters = 32
+	};
+
+	struct Counter {
+		const char *name;
+		Type type;
+		uint32 frameValue;
+		uint32 maxFrameValue;
+		uint64 total;
+		uint64 windowTotal;		///< Sum since the last formatOverlayText() call
+	};
+
+	Mutex _mutex;				///< Guards the counters
+	Counter _counters[kMaxCounters];
+	uint _numCounters;
+	uint _users;
+	uint32 _frames;
+	uint32 _windowFrames;
+	uint64 _lastFrameTime;
+};
+
+/** Shortcut for accessing the performance counter manager. */
+#define PerfMan		Common::PerfCounterManager::instance()
+
+/** Adds to a counter, which costs a single inline check while disabled. */
+inline void perfCount(uint id, uint32 value = 1) {
+	if (gPerfCountersEnabled)
+		PerfMan.add(id, value);
+}
+
+/** Returns the current time for PerfTimer. */
+uint64 perfTimerStart();
+
+/** Adds the time since start to a timer. */
+void perfTimerStop(uint id, uint64 start);
+
+/**
+ * Adds the lifetime of the object to a timer. While the counters are
+ * disabled, this costs a single inline check.
+ */
+class PerfTimer {
+public:
+	PerfTimer(uint id) : _id(id), _running(gPerfCountersEnabled), _start(0) {
+		if (_running)
+			_start = perfTimerStart();
+	}
+
+	~PerfTimer() {
+		if (_running)
+			perfTimerStop(_id, _start);
+	}
+
+private:
+	uint _id;
+	bool _running;
+	uint64 _start;
+};
+
+} // End of namespace Common
+
+#endif
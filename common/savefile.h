@@ -161,6 +161,19 @@ public:
 	 * @see Common::matchString()
 	 */
 	virtual StringArray listSavefiles(const String &pattern) = 0;
+
+	/**
+	 * Query the size and the last modification time of a savefile without
+	 * opening it. This is used to validate cached savefile meta data.
+	 *
+	 * The default implementation does not support this and always fails.
+	 *
+	 * @param name		the name of the savefile
+	 * @param size		receives the size of the savefile in bytes
+	 * @param timestamp	receives the last modification time of the savefile
+	 * @return true if the information could be obtained, false otherwise.
+	 */
+	virtual bool getSavefileInfo(const String &name, uint32 &size, uint32 &timestamp) { return false; }
 };
 
 } // End of namespace Common
@@ -314,7 +314,14 @@ public:
 		 *
 		 * This feature has no associated state.
 		 */
-		kFeatureDisplayLogFile
+		kFeatureDisplayLogFile,
+
+		/**
+		 * If supported, this feature flag can be used to show the values of
+		 * the performance counters (see common/perfcounters.h) on top of the
+		 * screen.
+		 */
+		kFeaturePerformanceOverlay
 	};
 
 	/**
@@ -893,6 +900,17 @@ public:
 	/** Get the number of milliseconds since the program was started. */
 	virtual uint32 getMillis() = 0;
 
+	/**
+	 * Get a timestamp in microseconds, for profiling purposes. Only the
+	 * difference between two timestamps is meaningful. Unlike getMillis()
+	 * this is not affected by the event recorder.
+	 *
+	 * The default implementation is based on getMillis(), and so does not
+	 * live up to this. Backends should override it with a timer of their
+	 * own, preferably a more precise one.
+	 */
+	virtual uint64 getMicros() { return (uint64)getMillis() * 1000; }
+
 	/** Delay/sleep for the specified amount of milliseconds. */
 	virtual void delayMillis(uint msecs) = 0;
 
@@ -0,0 +1,153 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/trace.h"
+#include "common/stream.h"
+#include "common/system.h"
+
+volatile bool gTraceEnabled = false;
+
+namespace Common {
+
+DECLARE_SINGLETON(TraceManager);
+
+TraceBuffer::TraceBuffer(const String &threadName, uint threadId, uint size)
+	: _threadName(threadName), _threadId(threadId), _mask(size - 1), _events(0), _written(0) {
+	assert(size && !(size & (size - 1)));
+}
+
+TraceBuffer::~TraceBuffer() {
+	release();
+}
+
+void TraceBuffer::reset() {
+	if (!_events)
+		_events = new TraceEvent[_mask + 1];
+	_written = 0;
+}
+
+void TraceBuffer::release() {
+	delete[] _events;
+	_events = 0;
+	_written = 0;
+}
+
+TraceManager::TraceManager() {
+	_buffers.push_back(new TraceBuffer("main", 1, kDefaultBufferSize));
+}
+
+TraceManager::~TraceManager() {
+	gTraceEnabled = false;
+
+	for (uint i = 0; i < _buffers.size(); ++i)
+		delete _buffers[i];
+}
+
+void TraceManager::start() {
+	gTraceEnabled = false;
+
+	// The buffers are only allocated once tracing is used for the first time
+	for (uint i = 0; i < _buffers.size(); ++i)
+		_buffers[i]->reset();
+
+	gTraceEnabled = true;
+}
+
+void TraceManager::stop() {
+	gTraceEnabled = false;
+}
+
+TraceBuffer *TraceManager::createBuffer(const String &threadName, uint size) {
+	TraceBuffer *buffer = new TraceBuffer(threadName, _buffers.size() + 1, size);
+	_buffers.push_back(buffer);
+	return buffer;
+}
+
+static void writeJSONString(WriteStream &stream, const char *str) {
+	stream.writeByte('"');
+	for (; *str; ++str) {
+		if (*str == '"' || *str == '\\')
+			stream.writeByte('\\');
+		stream.writeByte(*str);
+	}
+	stream.writeByte('"');
+}
+
+// Formats a timestamp in microseconds, which may not fit into 32 bits. Not
+// every supported compiler knows a printf format for 64 bit values.
+static String formatMicros(uint64 micros) {
+	const uint32 seconds = (uint32)(micros / 1000000);
+	if (!seconds)
+		return String::format("%u", (uint32)micros);
+	return String::format("%u%06u", seconds, (uint32)(micros % 1000000));
+}
+
+void TraceManager::exportChromeJSON(WriteStream &stream) const {
+	bool haveStart = false;
+	uint64 startTime = 0;
+	for (uint i = 0; i < _buffers.size(); ++i) {
+		const TraceBuffer *buffer = _buffers[i];
+		if (buffer->getCount() && (!haveStart || buffer->getEvent(0).timestamp < startTime)) {
+			startTime = buffer->getEvent(0).timestamp;
+			haveStart = true;
+		}
+	}
+
+	stream.writeString("{\"traceEvents\":[");
+
+	for (uint i = 0; i < _buffers.size(); ++i) {
+		const TraceBuffer *buffer = _buffers[i];
+
+		// Name the thread, so the viewer can show it
+		stream.writeString(String::format("%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":",
+		                                  i ? "," : "", buffer->getThreadId()));
+		writeJSONString(stream, buffer->getThreadName().c_str());
+		stream.writeString("}}");
+
+		for (uint j = 0; j < buffer->getCount(); ++j) {
+			const TraceEvent &event = buffer->getEvent(j);
+
+			stream.writeString(",\n{\"name\":");
+			writeJSONString(stream, event.name);
+			stream.writeString(",\"cat\":");
+			writeJSONString(stream, event.category);
+			stream.writeString(String::format(",\"ph\":\"%c\",\"ts\":%s,\"pid\":1,\"tid\":%u}",
+			                                  event.phase, formatMicros(event.timestamp - startTime).c_str(), buffer->getThreadId()));
+		}
+	}
+
+	stream.writeString("\n]}\n");
+}
+
+TraceBuffer *traceBegin(TraceBuffer *buffer, const char *category, const char *name) {
+	if (!buffer)
+		buffer = TraceMan.getMainBuffer();
+
+	buffer->add(category, name, 'B', g_system->getMicros());
+	return buffer;
+}
+
+void traceEnd(TraceBuffer *buffer, const char *category, const char *name) {
+	buffer->add(category, name, 'E', g_system->getMicros());
+}
+
+} // End of namespace Common
@@ -0,0 +1,199 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_TRACE_H
+#define COMMON_TRACE_H
+
+#include "common/scummsys.h"
+#include "common/array.h"
+#include "common/singleton.h"
+#include "common/str.h"
+#include "common/util.h"
+
+/**
+ * Whether trace events are currently recorded. Only the TraceManager should
+ * change this, it is exposed so that TraceScope can check it inline.
+ */
+extern volatile bool gTraceEnabled;
+
+namespace Common {
+
+class WriteStream;
+
+/**
+ * A single begin or end event of a traced scope. The category and the name
+ * are not copied, so they have to be string literals.
+ */
+struct TraceEvent {
+	uint64 timestamp;		///< in microseconds, see OSystem::getMicros()
+	const char *category;
+	const char *name;
+	char phase;				///< 'B' for begin or 'E' for end, as in the Chrome trace format
+};
+
+/**
+ * A fixed size ring buffer of trace events, belonging to a single thread.
+ *
+ * Only the owning thread may add events, which needs no locking. Once the
+ * buffer is full, the oldest events are overwritten. The events should only
+ * be read while tracing is stopped.
+ */
+class TraceBuffer {
+public:
+	/**
+	 * @param threadName	the thread name shown in the exported trace
+	 * @param threadId		the thread id used in the exported trace
+	 * @param size			the number of events, must be a power of two
+	 */
+	TraceBuffer(const String &threadName, uint threadId, uint size);
+	~TraceBuffer();
+
+	const String &getThreadName() const { return _threadName; }
+	uint getThreadId() const { return _threadId; }
+
+	/** Allocates the events if necessary and discards all recorded ones. */
+	void reset();
+
+	/** Frees the memory used by the events. */
+	void release();
+
+	void add(const char *category, const char *name, char phase, uint64 timestamp) {
+		if (!_events)
+			return;
+
+		TraceEvent &event = _events[_written & _mask];
+		event.timestamp = timestamp;
+		event.category = category;
+		event.name = name;
+		event.phase = phase;
+		_written = _written + 1;
+	}
+
+	/** Returns the number of events available, at most the buffer size. */
+	uint getCount() const { return MIN<uint32>(_written, _mask + 1); }
+
+	/** Returns the number of events which were overwritten. */
+	uint32 getDropped() const { return _written - getCount(); }
+
+	/** Returns an event, 0 being the oldest one still available. */
+	const TraceEvent &getEvent(uint index) const { return _events[(_written - getCount() + index) & _mask]; }
+
+private:
+	String _threadName;
+	uint _threadId;
+	uint32 _mask;
+	TraceEvent *_events;
+	volatile uint32 _written;
+};
+
+/**
+ * Records the begin and end of scopes in the TraceBuffers of all threads,
+ * and exports them in the Chrome trace event format. The result can be
+ * viewed with chrome://tracing or any compatible viewer.
+ */
+class TraceManager : public Singleton<TraceManager> {
+public:
+	TraceManager();
+	~TraceManager();
+
+	/** Discards all recorded events and starts recording new ones. */
+	void start();
+
+	/** Stops recording, so the events can be exported. */
+	void stop();
+
+	bool isEnabled() const { return gTraceEnabled; }
+
+	/** The buffer of the main thread, which is used by TRACE_SCOPE. */
+	TraceBuffer *getMainBuffer() { return _buffers[0]; }
+
+	/**
+	 * Creates a buffer for another thread, which is owned by the TraceManager.
+	 * This must be called from the main thread while tracing is stopped, the
+	 * easiest being when the thread is set up.
+	 */
+	TraceBuffer *createBuffer(const String &threadName, uint size = kDefaultBufferSize);
+
+	/**
+	 * Writes all recorded events as a Chrome trace event JSON document.
+	 * Timestamps are relative to the first recorded event.
+	 */
+	void exportChromeJSON(WriteStream &stream) const;
+
+	enum {
+		kDefaultBufferSize = 1 << 16
+	};
+
+private:
+	Array<TraceBuffer *> _buffers;
+};
+
+/**
+ * Adds a begin event to the buffer (the main thread buffer if none is given)
+ * and returns the buffer used. Use TraceScope instead of calling this.
+ */
+TraceBuffer *traceBegin(TraceBuffer *buffer, const char *category, const char *name);
+
+/** Adds the end event matching traceBegin(). */
+void traceEnd(TraceBuffer *buffer, const char *category, const char *name);
+
+/**
+ * Traces the lifetime of the object as a scope. While tracing is disabled,
+ * this costs a single inline check.
+ */
+class TraceScope {
+public:
+	TraceScope(const char *category, const char *name, TraceBuffer *buffer = 0) : _buffer(0), _category(category), _name(name) {
+		if (gTraceEnabled)
+			_buffer = traceBegin(buffer, category, name);
+	}
+
+	~TraceScope() {
+		// Always end a scope which was begun, even if tracing was stopped
+		// in the meantime
+		if (_buffer)
+			traceEnd(_buffer, _category, _name);
+	}
+
+private:
+	TraceBuffer *_buffer;
+	const char *_category;
+	const char *_name;
+};
+
+} // End of namespace Common
+
+#define TRACE_CONCAT_(a, b) a ## b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+
+/** Traces the rest of the current block in the main thread buffer. */
+#define TRACE_SCOPE(category, name) \
+	Common::TraceScope TRACE_CONCAT(traceScope, __LINE__)(category, name)
+
+/** Traces the rest of the current block in the given buffer. */
+#define TRACE_SCOPE_BUFFER(buffer, category, name) \
+	Common::TraceScope TRACE_CONCAT(traceScope, __LINE__)(category, name, buffer)
+
+/** Shortcut for accessing the trace manager. */
+#define TraceMan		Common::TraceManager::instance()
+
+#endif
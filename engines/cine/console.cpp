@@ -22,6 +22,7 @@
 
 #include "cine/console.h"
 #include "cine/cine.h"
+#include "cine/gfx.h"
 
 namespace Cine {
 
@@ -30,6 +31,7 @@ bool labyrinthCheat;
 CineConsole::CineConsole(CineEngine *vm) : GUI::Debugger(), _vm(vm) {
 	assert(_vm);
 	DCmd_Register("labyrinthCheat", WRAP_METHOD(CineConsole, Cmd_LabyrinthCheat));
+	DCmd_Register("fullUpdates", WRAP_METHOD(CineConsole, Cmd_FullUpdates));
 
 	labyrinthCheat = false;
 }
@@ -44,4 +46,16 @@ bool CineConsole::Cmd_LabyrinthCheat(int argc, const char **argv) {
 	return true;
 }
 
+// Copy the whole frame to the screen instead of only its changed parts.
+// Useful for finding out whether a graphics glitch is caused by missed updates.
+bool CineConsole::Cmd_FullUpdates(int argc, const char **argv) {
+	if (argc != 2 || (strcmp(argv[1], "on") && strcmp(argv[1], "off"))) {
+		DebugPrintf("Usage: %s [on | off]\n", argv[0]);
+		return true;
+	}
+
+	renderer->setFullScreenUpdates(!strcmp(argv[1], "on"));
+	return true;
+}
+
 } // End of namespace Cine
@@ -40,6 +40,7 @@ private:
 	CineEngine *_vm;
 
 	bool Cmd_LabyrinthCheat(int argc, const char **argv);
+	bool Cmd_FullUpdates(int argc, const char **argv);
 };
 
 } // End of namespace Cine
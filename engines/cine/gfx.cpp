@@ -108,12 +108,18 @@ static const byte cursorPalette[] = {
  */
 FWRenderer::FWRenderer() : _background(NULL), _backupPal(), _cmd(""),
 	_cmdY(0), _messageBg(0), _backBuffer(new byte[_screenSize]),
-	_activePal(), _changePal(0), _showCollisionPage(false) {
+	_activePal(), _changePal(0), _showCollisionPage(false), _frontBuffer(new byte[_screenSize]),
+	_dirtyRegion(_screenWidth, _screenHeight), _fullScreenUpdates(false) {
 
 	assert(_backBuffer);
+	assert(_frontBuffer);
 
 	memset(_backBuffer, 0, _screenSize);
+	memset(_frontBuffer, 0, _screenSize);
 	memset(_bgName, 0, sizeof(_bgName));
+
+	// Nothing was shown yet, so the first frame has to be copied completely
+	_dirtyRegion.invalidate();
 }
 
 
@@ -123,6 +129,7 @@ FWRenderer::FWRenderer() : _background(NULL), _backupPal(), _cmd(""),
 FWRenderer::~FWRenderer() {
 	delete[] _background;
 	delete[] _backBuffer;
+	delete[] _frontBuffer;
 
 	clearMenuStack();
 }
@@ -681,14 +688,53 @@ void FWRenderer::showCollisionPage(bool state) {
 	_showCollisionPage = state;
 }
 
+/**
+ * Turn on or off copying the whole frame to the screen.
+ * If turned off, only the parts which changed since the last frame are copied.
+ * @note Useful for debugging screen update problems.
+ */
+void FWRenderer::setFullScreenUpdates(bool state) {
+	_fullScreenUpdates = state;
+}
+
 /**
  * Update screen
  */
 void FWRenderer::blit() {
 	// Show the back buffer or the collision page. Normally the back
 	// buffer but showing the collision page is useful for debugging.
-	byte *source = (_showCollisionPage ? collisionPage : _backBuffer);
-	g_system->copyRectToScreen(source, 320, 0, 0, 320, 200);
+	const byte *source = (_showCollisionPage ? collisionPage : _backBuffer);
+
+	if (_fullScreenUpdates)
+		_dirtyRegion.invalidate();
+
+	// Every frame is drawn from scratch, so find the changed parts by
+	// comparing it to the previous one in short horizontal spans
+	if (!_dirtyRegion.isFullyDirty()) {
+		const int spanWidth = 16;
+		for (int y = 0; y < _screenHeight; ++y) {
+			const byte *src = source + y * _screenWidth;
+			const byte *dst = _frontBuffer + y * _screenWidth;
+			for (int x = 0; x < _screenWidth; x += spanWidth) {
+				const int width = MIN(spanWidth, _screenWidth - x);
+				if (memcmp(src + x, dst + x, width))
+					_dirtyRegion.addRect(Common::Rect(x, y, x + width, y + 1));
+			}
+		}
+	}
+
+	const Common::Array<Common::Rect> &rects = _dirtyRegion.getRects();
+	for (uint i = 0; i < rects.size(); ++i) {
+		const Common::Rect &r = rects[i];
+		const int offset = r.top * _screenWidth + r.left;
+
+		for (int y = 0; y < r.height(); ++y)
+			memcpy(_frontBuffer + offset + y * _screenWidth, source + offset + y * _screenWidth, r.width());
+
+		g_system->copyRectToScreen(source + offset, _screenWidth, r.left, r.top, r.width(), r.height());
+	}
+
+	_dirtyRegion.clear();
 }
 
 /**
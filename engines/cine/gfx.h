@@ -29,6 +29,8 @@
 #include "cine/object.h"
 #include "cine/bg_list.h"
 
+#include "graphics/dirtyregion.h"
+
 namespace Cine {
 
 extern byte *collisionPage;
@@ -140,6 +142,9 @@ protected:
 	Common::Stack<Menu *> _menuStack; ///< All displayed menus
 	int _changePal; ///< Load active palette to video backend on next frame
 	bool _showCollisionPage; ///< Should we show the collision page instead of the back buffer? Used for debugging.
+	byte *_frontBuffer; ///< Copy of the frame currently shown on screen
+	Graphics::DirtyRegion _dirtyRegion; ///< Parts of the screen which changed since the last frame
+	bool _fullScreenUpdates; ///< Should we copy the whole frame to the screen? Used for debugging.
 
 	void fillSprite(const ObjectStruct &obj, uint8 color = 0);
 	void drawMaskedSprite(const ObjectStruct &obj, const byte *mask);
@@ -207,6 +212,7 @@ public:
 
 	virtual void fadeToBlack();
 	void showCollisionPage(bool state);
+	void setFullScreenUpdates(bool state);
 
 	void drawString(const char *string, byte param);
 	int getStringWidth(const char *str);
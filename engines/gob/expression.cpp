@@ -23,6 +23,8 @@
 #include "common/endian.h"
 #include "common/str.h"
 
+#include "common/perfcounters.h"
+
 #include "gob/gob.h"
 #include "gob/expression.h"
 #include "gob/global.h"
@@ -32,6 +34,55 @@
 
 namespace Gob {
 
+// The performance counter of saved parses, shared by all scripts
+static int s_cacheHitsCounter = -1;
+
+ExpressionCache::ExpressionCache() : _hits(0) {
+	if (s_cacheHitsCounter < 0)
+		s_cacheHitsCounter = PerfMan.registerCounter("gobExprCacheHits", Common::PerfCounterManager::kTypeCount);
+}
+
+ExpressionCache::Entry *ExpressionCache::find(int32 offset) {
+	EntryMap::iterator it = _entries.find(offset);
+	if (it == _entries.end())
+		return 0;
+
+	return &it->_value;
+}
+
+ExpressionCache::Entry &ExpressionCache::add(int32 offset, byte stopToken) {
+	if (!_entries.contains(offset)) {
+		Entry &entry = _entries[offset];
+
+		entry.stopToken = stopToken;
+		entry.parseEnd = 0;
+		entry.skipEnd = 0;
+		entry.firstToken = 0;
+		entry.tokenCount = 0;
+
+		return entry;
+	}
+
+	return _entries[offset];
+}
+
+void ExpressionCache::clear() {
+	if (!_entries.empty())
+		debugC(1, kDebugExpression, "Expression cache: %d expressions, %d tokens, %d hits",
+				_entries.size(), _tokens.size(), _hits);
+
+	_entries.clear(true);
+	_tokens.clear();
+	_hits = 0;
+}
+
+void ExpressionCache::addHit() {
+	_hits++;
+
+	if (s_cacheHitsCounter >= 0)
+		Common::perfCount(s_cacheHitsCounter);
+}
+
 Expression::Stack::Stack(size_t size) {
 	opers  = new byte[size];
 	values = new int32[size];
@@ -106,6 +157,26 @@ byte *Expression::decodePtr(int32 n) {
 }
 
 void Expression::skipExpr(char stopToken) {
+	Script &script = *_vm->_game->_script;
+	ExpressionCache &cache = script.getExpressionCache();
+	const int32 start = script.pos();
+
+	const ExpressionCache::Entry *entry = cache.find(start);
+	if (entry && (entry->stopToken == (byte)stopToken) && (entry->skipEnd > 0)) {
+		seekExprEnd(script, entry->skipEnd);
+		cache.addHit();
+		return;
+	}
+
+	skipExpr_internal(stopToken);
+
+	// Skipping might have added entries for nested expressions, so look it up again
+	ExpressionCache::Entry &newEntry = cache.add(start, stopToken);
+	if (newEntry.stopToken == (byte)stopToken)
+		newEntry.skipEnd = script.pos();
+}
+
+void Expression::skipExpr_internal(char stopToken) {
 	int16 dimCount;
 	byte operation;
 	int16 num;
@@ -996,11 +1067,113 @@ void Expression::getResult(byte operation, int32 value, byte *type) {
 	}
 }
 
+// Apply a preceding negation or logical NOT to the value just loaded
+void Expression::applyUnary(StackFrame &stackFrame) {
+	if ((stackFrame.pos > 0) && ((stackFrame.opers[-1] == OP_NEG) || (stackFrame.opers[-1] == OP_NOT))) {
+		stackFrame.pop();
+
+		if (*stackFrame.opers == OP_NEG) {
+			*stackFrame.opers = OP_LOAD_IMM_INT16;
+			stackFrame.values[0] = -stackFrame.values[1];
+		} else
+			*stackFrame.opers = (stackFrame.opers[1] == GOB_FALSE) ? GOB_TRUE : GOB_FALSE;
+	}
+}
+
+// Reduce the stack at the end of an expression, a bracket or an operand of a logical operator
+void Expression::reduceStack(Stack &stack, StackFrame &stackFrame, byte operation, byte stopToken) {
+	int16 brackStart;
+
+	while (stackFrame.pos >= 2) {
+		if ((stackFrame.opers[-2] == OP_BEGIN_EXPR) &&
+				((operation == OP_END_EXPR) || (operation == stopToken))) {
+			stackFrame.opers[-2] = stackFrame.opers[-1];
+			if ((stackFrame.opers[-2] == OP_LOAD_IMM_INT16) || (stackFrame.opers[-2] == OP_LOAD_IMM_STR))
+				stackFrame.values[-2] = stackFrame.values[-1];
+
+			stackFrame.pop();
+
+			simpleArithmetic2(stackFrame);
+
+			if (operation != stopToken)
+				return;
+		}	// if ((stackFrame.opers[-2] == OP_BEGIN_EXPR) && ...)
+
+		for (brackStart = (stackFrame.pos - 2); (brackStart > 0) &&
+		    (stack.opers[brackStart] < OP_OR) && (stack.opers[brackStart] != OP_BEGIN_EXPR);
+				brackStart--)
+			;
+
+		if ((stack.opers[brackStart] >= OP_OR) || (stack.opers[brackStart] == OP_BEGIN_EXPR))
+			brackStart++;
+
+		if (complexArithmetic(stack, stackFrame, brackStart))
+			return;
+
+	}	// while (stackFrame.pos >= 2)
+}
+
+// Is the result of a logical operator already decided by its left operand?
+bool Expression::isShortCircuit(StackFrame &stackFrame, byte operation) {
+	if (stackFrame.opers[-1] == OP_LOAD_IMM_INT16) {
+		if (stackFrame.values[-1] != 0)
+			stackFrame.opers[-1] = GOB_TRUE;
+		else
+			stackFrame.opers[-1] = GOB_FALSE;
+	}
+
+	return ((operation == OP_OR) && (stackFrame.opers[-1] == GOB_TRUE)) ||
+	       ((operation == OP_AND) && (stackFrame.opers[-1] == GOB_FALSE));
+}
+
+// Apply a logical NOT in front of a short circuited expression
+void Expression::endShortCircuit(StackFrame &stackFrame) {
+	if ((stackFrame.pos > 0) && (stackFrame.opers[-1] == OP_NOT)) {
+		if (stackFrame.opers[0] == GOB_FALSE)
+			stackFrame.opers[-1] = GOB_TRUE;
+		else
+			stackFrame.opers[-1] = GOB_FALSE;
+
+		stackFrame.pop();
+	}
+}
+
+void Expression::pushOperator(StackFrame &stackFrame, byte operation) {
+	if ((operation >= OP_LESS) && (operation <= OP_NEQ) && (stackFrame.pos > 2)) {
+		if (stackFrame.opers[-2] == OP_ADD) {
+			if (stackFrame.opers[-3] == OP_LOAD_IMM_INT16) {
+				stackFrame.values[-3] += stackFrame.values[-1];
+			} else if (stackFrame.opers[-3] == OP_LOAD_IMM_STR) {
+				if ((char *)decodePtr(stackFrame.values[-3]) != _resultStr) {
+					Common::strlcpy(_resultStr, (char *)decodePtr(stackFrame.values[-3]), sizeof(_resultStr));
+					stackFrame.values[-3] = encodePtr((byte *)_resultStr, kResStr);
+				}
+				Common::strlcat(_resultStr, (char *)decodePtr(stackFrame.values[-1]), sizeof(_resultStr));
+			}
+			stackFrame.pop(2);
+
+		} else if (stackFrame.opers[-2] == OP_SUB) {
+			stackFrame.values[-3] -= stackFrame.values[-1];
+			stackFrame.pop(2);
+		} else if (stackFrame.opers[-2] == OP_BITOR) {
+			stackFrame.values[-3] |= stackFrame.values[-1];
+			stackFrame.pop(2);
+		}
+	}
+
+	*stackFrame.opers = operation;
+}
+
 int16 Expression::parseExpr(byte stopToken, byte *type) {
+	const ExpressionCache::Entry *compiled = getCompiledExpr(stopToken);
+	if (compiled) {
+		evalCompiledExpr(*compiled, stopToken, type);
+		return 0;
+	}
+
 	Stack stack;
 	StackFrame stackFrame(stack);
 	byte operation;
-	int16 brackStart;
 	uint32 varBase;
 
 	while (true) {
@@ -1012,16 +1185,7 @@ int16 Expression::parseExpr(byte stopToken, byte *type) {
 		if ((operation >= OP_ARRAY_INT8) && (operation <= OP_FUNC)) {
 
 			loadValue(operation, varBase, stackFrame);
-
-			if ((stackFrame.pos > 0) && ((stackFrame.opers[-1] == OP_NEG) || (stackFrame.opers[-1] == OP_NOT))) {
-				stackFrame.pop();
-
-				if (*stackFrame.opers == OP_NEG) {
-					*stackFrame.opers = OP_LOAD_IMM_INT16;
-					stackFrame.values[0] = -stackFrame.values[1];
-				} else
-					*stackFrame.opers = (stackFrame.opers[1] == GOB_FALSE) ? GOB_TRUE : GOB_FALSE;
-			}
+			applyUnary(stackFrame);
 
 			if (stackFrame.pos <= 0)
 				continue;
@@ -1033,44 +1197,10 @@ int16 Expression::parseExpr(byte stopToken, byte *type) {
 
 		if ((operation == stopToken) || (operation == OP_OR) ||
 				(operation == OP_AND) || (operation == OP_END_EXPR)) {
-			while (stackFrame.pos >= 2) {
-				if ((stackFrame.opers[-2] == OP_BEGIN_EXPR) &&
-						((operation == OP_END_EXPR) || (operation == stopToken))) {
-					stackFrame.opers[-2] = stackFrame.opers[-1];
-					if ((stackFrame.opers[-2] == OP_LOAD_IMM_INT16) || (stackFrame.opers[-2] == OP_LOAD_IMM_STR))
-						stackFrame.values[-2] = stackFrame.values[-1];
-
-					stackFrame.pop();
-
-					simpleArithmetic2(stackFrame);
-
-					if (operation != stopToken)
-						break;
-				}	// if ((stackFrame.opers[-2] == OP_BEGIN_EXPR) && ...)
-
-				for (brackStart = (stackFrame.pos - 2); (brackStart > 0) &&
-				    (stack.opers[brackStart] < OP_OR) && (stack.opers[brackStart] != OP_BEGIN_EXPR);
-						brackStart--)
-					;
-
-				if ((stack.opers[brackStart] >= OP_OR) || (stack.opers[brackStart] == OP_BEGIN_EXPR))
-					brackStart++;
-
-				if (complexArithmetic(stack, stackFrame, brackStart))
-					break;
-
-			}	// while (stackFrame.pos >= 2)
+			reduceStack(stack, stackFrame, operation, stopToken);
 
 			if ((operation == OP_OR) || (operation == OP_AND)) {
-				if (stackFrame.opers[-1] == OP_LOAD_IMM_INT16) {
-					if (stackFrame.values[-1] != 0)
-						stackFrame.opers[-1] = GOB_TRUE;
-					else
-						stackFrame.opers[-1] = GOB_FALSE;
-				}
-
-				if (((operation == OP_OR) && (stackFrame.opers[-1] == GOB_TRUE)) ||
-				    ((operation == OP_AND) && (stackFrame.opers[-1] == GOB_FALSE))) {
+				if (isShortCircuit(stackFrame, operation)) {
 					if ((stackFrame.pos > 1) && (stackFrame.opers[-2] == OP_BEGIN_EXPR)) {
 						skipExpr(OP_END_EXPR);
 						stackFrame.opers[-2] = stackFrame.opers[-1];
@@ -1079,14 +1209,7 @@ int16 Expression::parseExpr(byte stopToken, byte *type) {
 						skipExpr(stopToken);
 					}
 					operation = _vm->_game->_script->peekByte(-1);
-					if ((stackFrame.pos > 0) && (stackFrame.opers[-1] == OP_NOT)) {
-						if (stackFrame.opers[0] == GOB_FALSE)
-							stackFrame.opers[-1] = GOB_TRUE;
-						else
-							stackFrame.opers[-1] = GOB_FALSE;
-
-						stackFrame.pop();
-					}
+					endShortCircuit(stackFrame);
 				} else
 					stackFrame.opers[0] = operation;
 			} else
@@ -1100,36 +1223,235 @@ int16 Expression::parseExpr(byte stopToken, byte *type) {
 			return 0;
 		}		// (operation == stopToken) || (operation == OP_OR) || (operation == OP_AND) || (operation == OP_END_EXPR)
 
-		if ((operation < OP_NEG) || (operation > OP_NOT)) {
-			if ((operation < OP_LESS) || (operation > OP_NEQ))
+		if (((operation < OP_NEG) || (operation > OP_NOT)) && ((operation < OP_LESS) || (operation > OP_NEQ)))
+			continue;
+
+		pushOperator(stackFrame, operation);
+	}
+}
+
+// Look up the compiled form of the expression at the current position,
+// compiling it if it wasn't seen before
+const ExpressionCache::Entry *Expression::getCompiledExpr(byte stopToken) {
+	Script &script = *_vm->_game->_script;
+	ExpressionCache::Entry *entry = script.getExpressionCache().find(script.pos());
+
+	if (!entry)
+		entry = compileExpr(script, stopToken);
+	else if (entry->parseEnd == 0 && entry->stopToken == stopToken)
+		entry = compileExpr(script, stopToken);
+
+	if (!entry || (entry->stopToken != stopToken) || (entry->parseEnd < 0))
+		return 0;
+
+	return entry;
+}
+
+ExpressionCache::Entry *Expression::compileExpr(Script &script, byte stopToken) {
+	ExpressionCache &cache = script.getExpressionCache();
+	Common::Array<ExpressionCache::Token> &tokens = cache.getTokens();
+
+	const int32 start = script.pos();
+	const int32 size = script.getSize();
+	const byte *data = script.getData();
+
+	ExpressionCache::Entry &entry = cache.add(start, stopToken);
+	entry.parseEnd = -1;
+
+	// Only function arguments end with a bracket, and functions aren't
+	// compiled anyway
+	if (stopToken == OP_END_EXPR)
+		return &entry;
+
+	const uint32 firstToken = tokens.size();
+
+	int32 pos = start;
+	while (pos < size) {
+		ExpressionCache::Token token;
+		token.operation = data[pos++];
+		token.value = 0;
+
+		int operandSize = 0;
+		switch (token.operation) {
+		case OP_LOAD_VAR_INT16:
+		case OP_LOAD_VAR_INT8:
+		case OP_LOAD_VAR_INT32:
+		case OP_LOAD_VAR_INT32_AS_INT16:
+		case OP_LOAD_IMM_INT16:
+			operandSize = 2;
+			break;
+		case OP_LOAD_IMM_INT32:
+			operandSize = 4;
+			break;
+		case OP_LOAD_IMM_INT8:
+			operandSize = 1;
+			break;
+		default:
+			if ((token.operation == stopToken) ||
+			    ((token.operation >= OP_NEG) && (token.operation <= OP_NOT)) ||
+			    ((token.operation >= OP_OR) && (token.operation <= OP_NEQ)))
+				break;
+
+			// Strings, arrays, functions and variable base offsets
+			tokens.resize(firstToken);
+			return &entry;
+		}
+
+		if (pos + operandSize > size)
+			break;
+
+		switch (token.operation) {
+		case OP_LOAD_VAR_INT16:
+			token.value = READ_LE_UINT16(data + pos) * 2;
+			break;
+		case OP_LOAD_VAR_INT8:
+			token.value = READ_LE_UINT16(data + pos);
+			break;
+		case OP_LOAD_VAR_INT32:
+		case OP_LOAD_VAR_INT32_AS_INT16:
+			token.value = READ_LE_UINT16(data + pos) * 4;
+			break;
+		case OP_LOAD_IMM_INT16:
+			token.value = (int16)READ_LE_UINT16(data + pos);
+			break;
+		case OP_LOAD_IMM_INT32:
+			token.value = (int32)READ_LE_UINT32(data + pos);
+			break;
+		case OP_LOAD_IMM_INT8:
+			token.value = (int8)data[pos];
+			break;
+		default:
+			break;
+		}
+
+		pos += operandSize;
+		tokens.push_back(token);
+
+		if (token.operation == stopToken) {
+			if (pos >= size)
+				break;
+
+			entry.parseEnd = pos;
+			entry.firstToken = firstToken;
+			entry.tokenCount = tokens.size() - firstToken;
+			return &entry;
+		}
+	}
+
+	// Ran off the end of the script
+	tokens.resize(firstToken);
+	return &entry;
+}
+
+// Same as parseExpr(), but working on the compiled form of the expression
+void Expression::evalCompiledExpr(const ExpressionCache::Entry &entry, byte stopToken, byte *type) {
+	Script &script = *_vm->_game->_script;
+	const ExpressionCache::Token *token = &script.getExpressionCache().getTokens()[entry.firstToken];
+	const ExpressionCache::Token *end = token + entry.tokenCount;
+
+	Stack stack;
+	StackFrame stackFrame(stack);
+
+	while (true) {
+		stackFrame.push();
+
+		byte operation = token->operation;
+		const int32 value = token->value;
+		token++;
+
+		if ((operation >= OP_ARRAY_INT8) && (operation <= OP_FUNC)) {
+			*stackFrame.opers = OP_LOAD_IMM_INT16;
+
+			switch (operation) {
+			case OP_LOAD_VAR_INT16:
+			case OP_LOAD_VAR_INT32_AS_INT16:
+				*stackFrame.values = (int16) READ_VARO_UINT16(value);
+				break;
+			case OP_LOAD_VAR_INT8:
+				*stackFrame.values = (int8) READ_VARO_UINT8(value);
+				break;
+			case OP_LOAD_VAR_INT32:
+				*stackFrame.values = READ_VARO_UINT32(value);
+				break;
+			default:
+				*stackFrame.values = value;
+				break;
+			}
+
+			applyUnary(stackFrame);
+
+			if (stackFrame.pos <= 0)
 				continue;
 
-			if (stackFrame.pos > 2) {
-				if (stackFrame.opers[-2] == OP_ADD) {
-					if (stackFrame.opers[-3] == OP_LOAD_IMM_INT16) {
-						stackFrame.values[-3] += stackFrame.values[-1];
-					} else if (stackFrame.opers[-3] == OP_LOAD_IMM_STR) {
-						if ((char *)decodePtr(stackFrame.values[-3]) != _resultStr) {
-							Common::strlcpy(_resultStr, (char *)decodePtr(stackFrame.values[-3]), sizeof(_resultStr));
-							stackFrame.values[-3] = encodePtr((byte *)_resultStr, kResStr);
-						}
-						Common::strlcat(_resultStr, (char *)decodePtr(stackFrame.values[-1]), sizeof(_resultStr));
+			simpleArithmetic1(stackFrame);
+
+			continue;
+		}
+
+		if ((operation == stopToken) || (operation == OP_OR) ||
+				(operation == OP_AND) || (operation == OP_END_EXPR)) {
+			reduceStack(stack, stackFrame, operation, stopToken);
+
+			if ((operation == OP_OR) || (operation == OP_AND)) {
+				if (isShortCircuit(stackFrame, operation)) {
+					if ((stackFrame.pos > 1) && (stackFrame.opers[-2] == OP_BEGIN_EXPR)) {
+						token = skipCompiledExpr(token, end, OP_END_EXPR);
+						stackFrame.opers[-2] = stackFrame.opers[-1];
+						stackFrame.pop(2);
+					} else {
+						token = skipCompiledExpr(token, end, stopToken);
 					}
-					stackFrame.pop(2);
-
-				} else if (stackFrame.opers[-2] == OP_SUB) {
-					stackFrame.values[-3] -= stackFrame.values[-1];
-					stackFrame.pop(2);
-				} else if (stackFrame.opers[-2] == OP_BITOR) {
-					stackFrame.values[-3] |= stackFrame.values[-1];
-					stackFrame.pop(2);
-				}
-			}
+					operation = token[-1].operation;
+					endShortCircuit(stackFrame);
+				} else
+					stackFrame.opers[0] = operation;
+			} else
+				stackFrame.pop();
+
+			if (operation != stopToken)
+				continue;
+
+			getResult(stack.opers[0], stack.values[0], type);
+
+			seekExprEnd(script, entry.parseEnd);
+			script.getExpressionCache().addHit();
+			return;
 		}
-		*stackFrame.opers = operation;
+
+		pushOperator(stackFrame, operation);
 	}
 }
 
+const ExpressionCache::Token *Expression::skipCompiledExpr(const ExpressionCache::Token *token,
+		const ExpressionCache::Token *end, byte stopToken) {
+
+	// Compiled expressions end with their stop token, so this never runs off the end
+	int16 num = 0;
+	while (token < end) {
+		const byte operation = (token++)->operation;
+
+		if (operation == OP_BEGIN_EXPR)
+			num++;
+		else if (operation == OP_END_EXPR)
+			num--;
+
+		if (operation != stopToken)
+			continue;
+
+		if ((stopToken != OP_END_EXPR) || (num < 0))
+			break;
+	}
+
+	return token;
+}
+
+// Move behind a cached expression, without the side effects of a seek
+void Expression::seekExprEnd(Script &script, int32 end) {
+	const bool finished = script.isFinished();
+	script.seek(end);
+	script.setFinished(finished);
+}
+
 int32 Expression::getResultInt() {
 	return _resultInt;
 }
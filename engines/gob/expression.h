@@ -24,10 +24,13 @@
 #define GOB_EXPRESSION_H
 
 #include "common/scummsys.h"
+#include "common/array.h"
+#include "common/hashmap.h"
 
 namespace Gob {
 
 class GobEngine;
+class Script;
 
 enum {
 	OP_NEG        =  1,
@@ -106,6 +109,52 @@ enum {
 	GOB_FALSE = 23
 };
 
+/**
+ * Parsed expressions of a script, keyed by their offset.
+ *
+ * Expressions which only consist of immediates, plain variables and
+ * operators are stored in a compiled form, with the variable offsets
+ * already resolved. For all expressions, the position skipExpr() ends at is
+ * remembered. The cache belongs to a script and is cleared when the script
+ * is unloaded.
+ */
+class ExpressionCache {
+public:
+	struct Token {
+		byte operation;
+		int32 value; ///< The immediate value or the variable offset
+	};
+
+	struct Entry {
+		byte stopToken;
+		int32 parseEnd;     ///< Position after the expression, 0 if not yet compiled, -1 if not compilable
+		int32 skipEnd;      ///< Position skipExpr() ends at, 0 if not yet known
+		uint32 firstToken;
+		uint32 tokenCount;
+	};
+
+	ExpressionCache();
+
+	Entry *find(int32 offset);
+	Entry &add(int32 offset, byte stopToken);
+
+	Common::Array<Token> &getTokens() { return _tokens; }
+
+	void clear();
+
+	/** Number of times a parse or a skip was saved. */
+	uint32 getHits() const { return _hits; }
+	void addHit();
+
+private:
+	typedef Common::HashMap<int32, Entry> EntryMap;
+
+	EntryMap _entries;
+	Common::Array<Token> _tokens;
+
+	uint32 _hits;
+};
+
 class Expression {
 public:
 	Expression(GobEngine *vm);
@@ -158,15 +207,28 @@ private:
 	byte *decodePtr(int32 n);
 
 	void printExpr_internal(char stopToken);
+	void skipExpr_internal(char stopToken);
+
+	const ExpressionCache::Entry *getCompiledExpr(byte stopToken);
+	ExpressionCache::Entry *compileExpr(Script &script, byte stopToken);
+	void evalCompiledExpr(const ExpressionCache::Entry &entry, byte stopToken, byte *type);
+	const ExpressionCache::Token *skipCompiledExpr(const ExpressionCache::Token *token,
+			const ExpressionCache::Token *end, byte stopToken);
+	void seekExprEnd(Script &script, int32 end);
 
 	bool getVarBase(uint32 &varBase, bool mindStop = false,
 			uint16 *size = 0, uint16 *type = 0);
 	int cmpHelper(const StackFrame &stackFrame);
 	void loadValue(byte operation, uint32 varBase, const StackFrame &stackFrame);
 
+	void applyUnary(StackFrame &stackFrame);
 	void simpleArithmetic1(StackFrame &stackFrame);
 	void simpleArithmetic2(StackFrame &stackFrame);
 	bool complexArithmetic(Stack &stack, StackFrame &stackFrame, int16 brackStart);
+	void reduceStack(Stack &stack, StackFrame &stackFrame, byte operation, byte stopToken);
+	bool isShortCircuit(StackFrame &stackFrame, byte operation);
+	void endShortCircuit(StackFrame &stackFrame);
+	void pushOperator(StackFrame &stackFrame, byte operation);
 	void getResult(byte operation, int32 value, byte *type);
 };
 
@@ -33,6 +33,7 @@ namespace Gob {
 
 Script::Script(GobEngine *vm) : _vm(vm) {
 	_expression = new Expression(vm);
+	_expressionCache = new ExpressionCache;
 
 	_finished = true;
 
@@ -49,6 +50,7 @@ Script::~Script() {
 	unload();
 
 	delete _expression;
+	delete _expressionCache;
 }
 
 uint32 Script::read(byte *data, int32 size) {
@@ -336,6 +338,10 @@ char *Script::getResultStr() const {
 	return _expression->getResultStr();
 }
 
+ExpressionCache &Script::getExpressionCache() {
+	return *_expressionCache;
+}
+
 bool Script::load(const Common::String &fileName) {
 	unload();
 
@@ -415,6 +421,9 @@ void Script::unloadTOT() {
 
 	delete[] _totData;
 
+	// The cached expressions are only valid for this script
+	_expressionCache->clear();
+
 	_totData = 0;
 	_totSize = 0;
 	_totPtr = 0;
@@ -32,6 +32,7 @@ namespace Gob {
 
 class GobEngine;
 class Expression;
+class ExpressionCache;
 
 class Script {
 public:
@@ -91,6 +92,9 @@ public:
 	int32 getResultInt() const;
 	char *getResultStr() const;
 
+	/** The expressions of this script parsed so far. */
+	ExpressionCache &getExpressionCache();
+
 	/** Returns the offset the specified pointer is within the script data. */
 	int32 getOffset(byte *ptr) const;
 	/** Returns the data pointer to the offset. */
@@ -142,6 +146,7 @@ private:
 
 	GobEngine *_vm;
 	Expression *_expression;
+	ExpressionCache *_expressionCache;
 
 	bool _finished;
 
@@ -32,6 +32,7 @@ Debugger::Debugger(HopkinsEngine *vm) : GUI::Debugger() {
 	_vm = vm;
 	DCmd_Register("continue", WRAP_METHOD(Debugger, Cmd_Exit));
 	DCmd_Register("rects", WRAP_METHOD(Debugger, cmd_DirtyRects));
+	DCmd_Register("fullupdates", WRAP_METHOD(Debugger, cmd_FullUpdates));
 	DCmd_Register("teleport", WRAP_METHOD(Debugger, cmd_Teleport));
 	DCmd_Register("show_room", WRAP_METHOD(Debugger, cmd_ShowCurrentRoom));
 }
@@ -47,6 +48,17 @@ bool Debugger::cmd_DirtyRects(int argc, const char **argv) {
 	}
 }
 
+// Turns copying the whole screen on every update on or off
+bool Debugger::cmd_FullUpdates(int argc, const char **argv) {
+	if (argc != 2) {
+		DebugPrintf("%s: [on | off]\n", argv[0]);
+		return true;
+	} else {
+		_vm->_graphicsMan->_fullScreenUpdates = !strcmp(argv[1], "on");
+		return false;
+	}
+}
+
 // Change room number
 bool Debugger::cmd_Teleport(int argc, const char **argv) {
 	if (argc != 2) {
@@ -39,6 +39,7 @@ public:
 	virtual ~Debugger() {}
 
 	bool cmd_DirtyRects(int argc, const char **argv);
+	bool cmd_FullUpdates(int argc, const char **argv);
 	bool cmd_Teleport(int argc, const char **argv);
 	bool cmd_ShowCurrentRoom(int argc, const char **argv);
 };
@@ -35,7 +35,7 @@
 
 namespace Hopkins {
 
-GraphicsManager::GraphicsManager(HopkinsEngine *vm) {
+GraphicsManager::GraphicsManager(HopkinsEngine *vm) : _refreshRegion(SCREEN_WIDTH, SCREEN_HEIGHT) {
 	_vm = vm;
 
 	_lockCounter = 0;
@@ -54,6 +54,7 @@ GraphicsManager::GraphicsManager(HopkinsEngine *vm) {
 	_screenBuffer = NULL;
 	_backupScreen = NULL;
 	_showDirtyRects = false;
+	_fullScreenUpdates = false;
 
 	_lineNbr2 = 0;
 	_enlargedX = _enlargedY = 0;
@@ -1033,7 +1034,7 @@ void GraphicsManager::resetDirtyRects() {
 }
 
 void GraphicsManager::resetRefreshRects() {
-	_refreshRects.clear();
+	_refreshRegion.clear();
 }
 
 // Add a game area dirty rectangle
@@ -1055,7 +1056,7 @@ void GraphicsManager::addRefreshRect(int x1, int y1, int x2, int y2) {
 	y2 = MIN(y2, SCREEN_HEIGHT);
 
 	if ((x2 > x1) && (y2 > y1))
-		addRectToArray(_refreshRects, Common::Rect(x1, y1, x2, y2));
+		_refreshRegion.addRect(Common::Rect(x1, y1, x2, y2));
 }
 
 void GraphicsManager::addRectToArray(Common::Array<Common::Rect> &rects, const Common::Rect &newRect) {
@@ -1127,7 +1128,7 @@ void GraphicsManager::displayDirtyRects() {
 
 		// If it's a valid rect, then add it to the list of areas to refresh on the screen
 		if (dstRect.isValidRect() && dstRect.width() > 0 && dstRect.height() > 0)
-			addRectToArray(_refreshRects, dstRect);
+			_refreshRegion.addRect(dstRect);
 	}
 
 	unlockScreen();
@@ -1135,14 +1136,19 @@ void GraphicsManager::displayDirtyRects() {
 }
 
 void GraphicsManager::displayRefreshRects() {
+	// Copy the whole screen every frame when debugging the refresh rects
+	if (_fullScreenUpdates)
+		_refreshRegion.invalidate();
+
 	Graphics::Surface *screenSurface = NULL;
 	if (_showDirtyRects) {
 		screenSurface = g_system->lockScreen();
 		g_system->copyRectToScreen(_screenBuffer, _screenLineSize, 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
 	}
 	// Loop through copying over any  specified rects to the screen
-	for (uint idx = 0; idx < _refreshRects.size(); ++idx) {
-		const Common::Rect &r = _refreshRects[idx];
+	const Common::Array<Common::Rect> &refreshRects = _refreshRegion.getRects();
+	for (uint idx = 0; idx < refreshRects.size(); ++idx) {
+		const Common::Rect &r = refreshRects[idx];
 
 		byte *srcP = _screenBuffer + _screenLineSize * r.top + (r.left * 2);
 		g_system->copyRectToScreen(srcP, _screenLineSize, r.left, r.top, r.width(), r.height());
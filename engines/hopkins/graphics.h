@@ -28,6 +28,7 @@
 #include "common/endian.h"
 #include "common/rect.h"
 #include "common/str.h"
+#include "graphics/dirtyregion.h"
 #include "graphics/surface.h"
 
 namespace Hopkins {
@@ -112,12 +113,13 @@ public:
 
 	/**
 	 * The _dirtyRects list contains paletted game areas that need to be redrawn.
-	 * The _dstrect array is the list of areas of the screen that ScummVM needs to be redrawn.
-	 * Some areas, such as the animation managers, skip the _dirtyRects and use _dstrec directly.
+	 * The _refreshRegion contains the areas of the screen that ScummVM needs to be redrawn.
+	 * Some areas, such as the animation managers, skip the _dirtyRects and use _refreshRegion directly.
 	 */
 	Common::Array<Common::Rect> _dirtyRects;
-	Common::Array<Common::Rect> _refreshRects;
+	Graphics::DirtyRegion _refreshRegion;
 	bool _showDirtyRects;
+	bool _fullScreenUpdates;
 
 	byte *_palettePixels;
 public:
@@ -22,6 +22,7 @@
 
 #include "hugo/console.h"
 #include "hugo/hugo.h"
+#include "hugo/display.h"
 #include "hugo/object.h"
 #include "hugo/parser.h"
 #include "hugo/schedule.h"
@@ -36,6 +37,7 @@ HugoConsole::HugoConsole(HugoEngine *vm) : GUI::Debugger(), _vm(vm) {
 	DCmd_Register("getallobjects", WRAP_METHOD(HugoConsole, Cmd_getAllObjects));
 	DCmd_Register("gotoscreen",    WRAP_METHOD(HugoConsole, Cmd_gotoScreen));
 	DCmd_Register("Boundaries",    WRAP_METHOD(HugoConsole, Cmd_boundaries));
+	DCmd_Register("fullupdates",   WRAP_METHOD(HugoConsole, Cmd_fullUpdates));
 }
 
 HugoConsole::~HugoConsole() {
@@ -149,4 +151,17 @@ bool HugoConsole::Cmd_boundaries(int argc, const char **argv) {
 	return false;
 }
 
+/**
+ * This command turns blitting the whole screen on every update on or off
+ */
+bool HugoConsole::Cmd_fullUpdates(int argc, const char **argv) {
+	if ((argc != 2) || (strcmp(argv[1], "on") && strcmp(argv[1], "off"))) {
+		DebugPrintf("Usage: %s [on | off]\n", argv[0]);
+		return true;
+	}
+
+	_vm->_screen->setFullScreenUpdates(!strcmp(argv[1], "on"));
+	return false;
+}
+
 } // End of namespace Hugo
@@ -42,6 +42,7 @@ private:
 	bool Cmd_getAllObjects(int argc, const char **argv);
 	bool Cmd_gotoScreen(int argc, const char **argv);
 	bool Cmd_boundaries(int argc, const char **argv);
+	bool Cmd_fullUpdates(int argc, const char **argv);
 };
 
 } // End of namespace Hugo
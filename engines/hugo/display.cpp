@@ -74,22 +74,17 @@ static const byte stdMouseCursor[] = {
 };
 
 
-Screen::Screen(HugoEngine *vm) : _vm(vm) {
+Screen::Screen(HugoEngine *vm) : _vm(vm), _dirtyRegion(kXPix, kYPix) {
 	_mainPalette = 0;
 	_curPalette = 0;
 	_dlAddIndex = 0;
 	_dlRestoreIndex = 0;
+	_fullScreenUpdates = false;
 
 	for (int i = 0; i < kNumFonts; i++) {
 		_arrayFont[i] = 0;
 		fontLoadedFl[i] = false;
 	}
-	for (int i = 0; i < kBlitListSize; i++) {
-		_dlBlistList[i]._x = 0;
-		_dlBlistList[i]._y = 0;
-		_dlBlistList[i]._dx = 0;
-		_dlBlistList[i]._dy = 0;
-	}
 	for (int i = 0; i < kRectListSize; i++) {
 		_dlAddList[i]._x = 0;
 		_dlAddList[i]._y = 0;
@@ -268,63 +263,6 @@ void Screen::displayFrame(const int sx, const int sy, Seq *seq, const bool foreF
 	displayList(kDisplayAdd, sx, sy, seq->_x2 + 1, seq->_lines);
 }
 
-/**
- * Merge rectangles A,B leaving result in B
- */
-void Screen::merge(const Rect *rectA, Rect *rectB) {
-	debugC(6, kDebugDisplay, "merge()");
-
-	int16 xa = rectA->_x + rectA->_dx;               // Find x2,y2 for each rectangle
-	int16 xb = rectB->_x + rectB->_dx;
-	int16 ya = rectA->_y + rectA->_dy;
-	int16 yb = rectB->_y + rectB->_dy;
-
-	rectB->_x = MIN(rectA->_x, rectB->_x);           // Minimum x,y
-	rectB->_y = MIN(rectA->_y, rectB->_y);
-	rectB->_dx = MAX(xa, xb) - rectB->_x;            // Maximum dx,dy
-	rectB->_dy = MAX(ya, yb) - rectB->_y;
-}
-
-/**
- * Coalesce the rectangles in the restore/add list into one unified
- * blist.  len is the sizes of alist or rlist.  blen is current length
- * of blist.  bmax is the max size of the blist.  Note that blist can
- * have holes, in which case dx = 0.  Returns used length of blist.
- */
-int16 Screen::mergeLists(Rect *list, Rect *blist, const int16 len, int16 blen) {
-	debugC(4, kDebugDisplay, "mergeLists()");
-
-	int16   coalesce[kBlitListSize];                // List of overlapping rects
-	// Process the list
-	for (int16 a = 0; a < len; a++, list++) {
-		// Compile list of overlapping rectangles in blit list
-		int16 c = 0;
-		Rect *bp = blist;
-		for (int16 b = 0; b < blen; b++, bp++) {
-			if (bp->_dx)                            // blist entry used
-				if (isOverlapping(list, bp))
-					coalesce[c++] = b;
-		}
-
-		// Any overlapping blit rects?
-		if (c == 0) {                               // None, add a new entry
-			blist[blen++] = *list;
-		} else {                                    // At least one overlapping
-			// Merge add-list entry with first blist entry
-			bp = &blist[coalesce[0]];
-			merge(list, bp);
-
-			// Merge any more blist entries
-			while (--c) {
-				Rect *cp = &blist[coalesce[c]];
-				merge(cp, bp);
-				cp->_dx = 0;                         // Delete entry
-			}
-		}
-	}
-	return blen;
-}
-
 /**
  * Process the display list
  * Trailing args are int16 x,y,dx,dy for the D_ADD operation
@@ -332,7 +270,6 @@ int16 Screen::mergeLists(Rect *list, Rect *blist, const int16 len, int16 blen) {
 void Screen::displayList(Dupdate update, ...) {
 	debugC(6, kDebugDisplay, "displayList()");
 
-	int16         blitLength = 0;                   // Length of blit list
 	va_list       marker;                           // Args used for D_ADD operation
 	Rect       *p;                                // Ptr to dlist entry
 
@@ -364,15 +301,27 @@ void Screen::displayList(Dupdate update, ...) {
 			break;
 		}
 
-		// Coalesce restore-list, add-list into combined blit-list
-		blitLength = mergeLists(_dlRestoreList, _dlBlistList, _dlRestoreIndex, blitLength);
-		blitLength = mergeLists(_dlAddList, _dlBlistList, _dlAddIndex, blitLength);
+		// Coalesce restore-list, add-list into the dirty region
+		if (_fullScreenUpdates) {
+			_dirtyRegion.invalidate();
+		} else {
+			for (int i = 0; i < _dlRestoreIndex; i++) {
+				p = &_dlRestoreList[i];
+				_dirtyRegion.addRect(Common::Rect(p->_x, p->_y, p->_x + p->_dx, p->_y + p->_dy));
+			}
+			for (int i = 0; i < _dlAddIndex; i++) {
+				p = &_dlAddList[i];
+				_dirtyRegion.addRect(Common::Rect(p->_x, p->_y, p->_x + p->_dx, p->_y + p->_dy));
+			}
+		}
 
-		// Blit the combined blit-list
-		for (_dlRestoreIndex = 0, p = _dlBlistList; _dlRestoreIndex < blitLength; _dlRestoreIndex++, p++) {
-			if (p->_dx)                              // Marks a used entry
-				displayRect(p->_x, p->_y, p->_dx, p->_dy);
+		// Blit the damaged parts of the screen
+		{
+			const Common::Array<Common::Rect> &rects = _dirtyRegion.getRects();
+			for (uint i = 0; i < rects.size(); i++)
+				g_system->copyRectToScreen(&_frontBuffer[rects[i].left + rects[i].top * kXPix], kXPix, rects[i].left, rects[i].top, rects[i].width(), rects[i].height());
 		}
+		_dirtyRegion.clear();
 		break;
 	case kDisplayRestore:                           // Restore each rectangle
 		for (_dlRestoreIndex = 0, p = _dlAddList; _dlRestoreIndex < _dlAddIndex; _dlRestoreIndex++, p++) {
@@ -627,22 +576,6 @@ void Screen::hideCursor() {
 	CursorMan.showMouse(false);
 }
 
-bool Screen::isInX(const int16 x, const Rect *rect) const {
-	return (x >= rect->_x) && (x <= rect->_x + rect->_dx);
-}
-
-bool Screen::isInY(const int16 y, const Rect *rect) const {
-	return (y >= rect->_y) && (y <= rect->_y + rect->_dy);
-}
-
-/**
- * Check if two rectangles are overlapping
- */
-bool Screen::isOverlapping(const Rect *rectA, const Rect *rectB) const {
-	return (isInX(rectA->_x, rectB) || isInX(rectA->_x + rectA->_dx, rectB) || isInX(rectB->_x, rectA) || isInX(rectB->_x + rectB->_dx, rectA)) &&
-		   (isInY(rectA->_y, rectB) || isInY(rectA->_y + rectA->_dy, rectB) || isInY(rectB->_y, rectA) || isInY(rectB->_y + rectB->_dy, rectA));
-}
-
 /**
  * Display active boundaries (activated in the console)
  * Light Red   = Exit hotspots
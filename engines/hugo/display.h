@@ -30,6 +30,8 @@
 #ifndef HUGO_DISPLAY_H
 #define HUGO_DISPLAY_H
 
+#include "graphics/dirtyregion.h"
+
 namespace Hugo {
 enum OverlayState {kOvlUndef, kOvlForeground, kOvlBackground}; // Overlay state
 
@@ -62,6 +64,7 @@ public:
 	void     drawRectangle(const bool filledFl, const int16 x1, const int16 y1, const int16 x2, const int16 y2, const int color);
 	void     drawShape(const int x, const int y, const int color1, const int color2);
 	void     drawStatusText();
+	void     setFullScreenUpdates(const bool fullFl) { _fullScreenUpdates = fullFl; }
 	void     freeScreen();
 	void     hideCursor();
 	void     initDisplay();
@@ -90,7 +93,6 @@ protected:
 	HugoEngine *_vm;
 
 	static const int kRectListSize = 16;            // Size of add/restore rect lists
-	static const int kBlitListSize = kRectListSize * 2; // Size of dirty rect blit list
 	static const int kShapeSize = 24;
 	static const int kFontLength = 128;             // Number of chars in font
 	static const int kFontSize = 1200;              // Max size of font data
@@ -110,10 +112,6 @@ protected:
 
 	Viewdib _frontBuffer;
 
-	inline bool isInX(const int16 x, const Rect *rect) const;
-	inline bool isInY(const int16 y, const Rect *rect) const;
-	inline bool isOverlapping(const Rect *rectA, const Rect *rectB) const;
-
 	virtual OverlayState findOvl(Seq *seqPtr, ImagePtr dstPtr, uint16 y) = 0;
 
 private:
@@ -123,7 +121,6 @@ private:
 
 	Icondib _iconBuffer;                          // Inventory icon DIB
 
-	int16 mergeLists(Rect *list, Rect *blist, const int16 len, int16 blen);
 	int16 center(const char *s) const;
 
 	Viewdib _backBuffer;
@@ -134,11 +131,11 @@ private:
 	int16  _dlAddIndex, _dlRestoreIndex;               // Index into add/restore lists
 	Rect _dlRestoreList[kRectListSize];              // The restore list
 	Rect _dlAddList[kRectListSize];                  // The add list
-	Rect _dlBlistList[kBlitListSize];                // The blit list
+	Graphics::DirtyRegion _dirtyRegion;              // The blit list
+	bool _fullScreenUpdates;                         // Blit the whole screen instead, for debugging
 	//
 
 	void createPal();
-	void merge(const Rect *rectA, Rect *rectB);
 	void writeChr(const int sx, const int sy, const byte color, const char *local_fontdata);
 };
 
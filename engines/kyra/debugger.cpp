@@ -42,6 +42,7 @@ Debugger::Debugger(KyraEngine_v1 *vm)
 void Debugger::initialize() {
 	DCmd_Register("continue",           WRAP_METHOD(Debugger, Cmd_Exit));
 	DCmd_Register("screen_debug_mode",  WRAP_METHOD(Debugger, cmd_setScreenDebug));
+	DCmd_Register("shape_verify",       WRAP_METHOD(Debugger, cmd_shapeVerify));
 	DCmd_Register("load_palette",       WRAP_METHOD(Debugger, cmd_loadPalette));
 	DCmd_Register("facings",            WRAP_METHOD(Debugger, cmd_showFacings));
 	DCmd_Register("gamespeed",          WRAP_METHOD(Debugger, cmd_gameSpeed));
@@ -67,6 +68,24 @@ bool Debugger::cmd_setScreenDebug(int argc, const char **argv) {
 	return true;
 }
 
+bool Debugger::cmd_shapeVerify(int argc, const char **argv) {
+	if (argc > 1) {
+		if (scumm_stricmp(argv[1], "enable") == 0)
+			_vm->screen()->enableShapeVerify(true);
+		else if (scumm_stricmp(argv[1], "disable") == 0)
+			_vm->screen()->enableShapeVerify(false);
+		else
+			DebugPrintf("Use shape_verify <enable/disable> to enable or disable it.\n");
+	} else {
+		uint32 shapes, mismatches;
+		_vm->screen()->getShapeVerifyStats(shapes, mismatches);
+		DebugPrintf("Shape verification is %s.\n", (_vm->screen()->queryShapeVerify() ? "enabled" : "disabled"));
+		DebugPrintf("%u shapes compared, %u mismatches.\n", shapes, mismatches);
+		DebugPrintf("Use shape_verify <enable/disable> to enable or disable it.\n");
+	}
+	return true;
+}
+
 bool Debugger::cmd_loadPalette(int argc, const char **argv) {
 	Palette palette(_vm->screen()->getPalette(0).getNumColors());
 
@@ -48,6 +48,11 @@ Screen::Screen(KyraEngine_v1 *vm, OSystem *system, const ScreenDim *dimTable, co
 	_drawShapeVar4 = 0;
 	_drawShapeVar5 = 0;
 
+	_dsSpecialised = true;
+	_dsVerify = false;
+	_dsVerifyPage = 0;
+	_dsVerifyCount = _dsVerifyMismatches = 0;
+
 	memset(_fonts, 0, sizeof(_fonts));
 
 	memset(_pagePtrs, 0, sizeof(_pagePtrs));
@@ -76,6 +81,7 @@ Screen::~Screen() {
 	delete _internFadePalette;
 	delete[] _decodeShapeBuffer;
 	delete[] _animBlockPtr;
+	delete[] _dsVerifyPage;
 
 	for (uint i = 0; i < _palettes.size(); ++i)
 		delete _palettes[i];
@@ -1433,6 +1439,99 @@ void Screen::drawShape(uint8 pageNum, const uint8 *shapeData, int x, int y, int
 
 	va_end(args);
 
+	if (_dsVerify)
+		drawShapeVerify(pageNum, shapeData, x, y, sd, flags);
+	else
+		drawShapeIntern(pageNum, shapeData, x, y, sd, flags);
+}
+
+void Screen::enableShapeVerify(bool enable) {
+	_dsVerify = enable;
+	_dsVerifyCount = _dsVerifyMismatches = 0;
+
+	if (!enable) {
+		delete[] _dsVerifyPage;
+		_dsVerifyPage = 0;
+	}
+}
+
+void Screen::drawShapeVerify(uint8 pageNum, const uint8 *shapeData, int x, int y, int sd, int flags) {
+	if (!_dsVerifyPage)
+		_dsVerifyPage = new uint8[SCREEN_PAGE_SIZE * 2];
+
+	uint8 *page = getPagePtr(pageNum);
+	uint8 *backup = _dsVerifyPage;
+	uint8 *generic = _dsVerifyPage + SCREEN_PAGE_SIZE;
+
+	// Draw with the generic line functions first and then restore the page
+	// and the state the plotting methods modify.
+	const int drawShapeVar4 = _drawShapeVar4;
+	memcpy(backup, page, SCREEN_PAGE_SIZE);
+
+	_dsSpecialised = false;
+	drawShapeIntern(pageNum, shapeData, x, y, sd, flags);
+	_dsSpecialised = true;
+
+	memcpy(generic, page, SCREEN_PAGE_SIZE);
+	memcpy(page, backup, SCREEN_PAGE_SIZE);
+	const int genericVar4 = _drawShapeVar4;
+	_drawShapeVar4 = drawShapeVar4;
+
+	drawShapeIntern(pageNum, shapeData, x, y, sd, flags);
+
+	++_dsVerifyCount;
+	if (memcmp(generic, page, SCREEN_PAGE_SIZE) || genericVar4 != _drawShapeVar4) {
+		++_dsVerifyMismatches;
+		warning("drawShape: Specialised drawing differs from the generic one (page %d, pos %d/%d, flags 0x%.4X)", pageNum, x, y, flags);
+	}
+}
+
+Screen::DsLineFunc Screen::getShapeLineFunc(int drawFunc, int plotType) const {
+#define DS_LINE_FUNCS(type) \
+	{ type, { &Screen::drawShapeProcessLineNoScaleUpwind<type>, \
+	          &Screen::drawShapeProcessLineNoScaleDownwind<type>, \
+	          &Screen::drawShapeProcessLineScaleUpwind<type>, \
+	          &Screen::drawShapeProcessLineScaleDownwind<type> } }
+
+	static const struct {
+		int plotType;
+		DsLineFunc lineFunc[4];
+	} dsSpecialisedLineFunc[] = {
+		DS_LINE_FUNCS(0),
+		DS_LINE_FUNCS(1),
+		DS_LINE_FUNCS(3),
+		DS_LINE_FUNCS(4),
+		DS_LINE_FUNCS(8),
+		DS_LINE_FUNCS(9),
+		DS_LINE_FUNCS(12),
+		DS_LINE_FUNCS(37),
+		DS_LINE_FUNCS(52)
+	};
+
+#undef DS_LINE_FUNCS
+
+	static const DsLineFunc dsLineFunc[] = {
+		&Screen::drawShapeProcessLineNoScaleUpwind<kDsPlotGeneric>,
+		&Screen::drawShapeProcessLineNoScaleDownwind<kDsPlotGeneric>,
+		&Screen::drawShapeProcessLineNoScaleUpwind<kDsPlotGeneric>,
+		&Screen::drawShapeProcessLineNoScaleDownwind<kDsPlotGeneric>,
+		&Screen::drawShapeProcessLineScaleUpwind<kDsPlotGeneric>,
+		&Screen::drawShapeProcessLineScaleDownwind<kDsPlotGeneric>,
+		&Screen::drawShapeProcessLineScaleUpwind<kDsPlotGeneric>,
+		&Screen::drawShapeProcessLineScaleDownwind<kDsPlotGeneric>
+	};
+
+	if (_dsSpecialised) {
+		for (int i = 0; i < ARRAYSIZE(dsSpecialisedLineFunc); ++i) {
+			if (dsSpecialisedLineFunc[i].plotType == plotType)
+				return dsSpecialisedLineFunc[i].lineFunc[((drawFunc & 4) >> 1) | (drawFunc & 1)];
+		}
+	}
+
+	return dsLineFunc[drawFunc];
+}
+
+void Screen::drawShapeIntern(uint8 pageNum, const uint8 *shapeData, int x, int y, int sd, int flags) {
 	static const DsMarginSkipFunc dsMarginFunc[] = {
 		&Screen::drawShapeMarginNoScaleUpwind,
 		&Screen::drawShapeMarginNoScaleDownwind,
@@ -1455,17 +1554,6 @@ void Screen::drawShape(uint8 pageNum, const uint8 *shapeData, int x, int y, int
 		&Screen::drawShapeSkipScaleDownwind
 	};
 
-	static const DsLineFunc dsLineFunc[] = {
-		&Screen::drawShapeProcessLineNoScaleUpwind,
-		&Screen::drawShapeProcessLineNoScaleDownwind,
-		&Screen::drawShapeProcessLineNoScaleUpwind,
-		&Screen::drawShapeProcessLineNoScaleDownwind,
-		&Screen::drawShapeProcessLineScaleUpwind,
-		&Screen::drawShapeProcessLineScaleDownwind,
-		&Screen::drawShapeProcessLineScaleUpwind,
-		&Screen::drawShapeProcessLineScaleDownwind
-	};
-
 	static const DsPlotFunc dsPlotFunc[] = {
 		&Screen::drawShapePlotType0,		// used by Kyra 1 + 2
 		&Screen::drawShapePlotType1,		// used by Kyra 3
@@ -1505,19 +1593,19 @@ void Screen::drawShape(uint8 pageNum, const uint8 *shapeData, int x, int y, int
 	const int drawFunc = flags & 0x0F;
 	_dsProcessMargin = dsMarginFunc[drawFunc];
 	_dsScaleSkip = dsSkipFunc[drawFunc];
-	_dsProcessLine = dsLineFunc[drawFunc];
 
 	const int ppc = (flags >> 8) & 0x3F;
+	const int ppc3 = (flags & 0x800) ? (((flags >> 8) & 0xF7) & 0x3F) : ppc;
 	_dsPlot = dsPlotFunc[ppc];
-	DsPlotFunc dsPlot2 = dsPlotFunc[ppc], dsPlot3 = dsPlotFunc[ppc];
-	if (flags & 0x800)
-		dsPlot3 = dsPlotFunc[((flags >> 8) & 0xF7) & 0x3F];
+	DsPlotFunc dsPlot2 = dsPlotFunc[ppc], dsPlot3 = dsPlotFunc[ppc3];
+	DsLineFunc dsLine2 = getShapeLineFunc(drawFunc, ppc), dsLine3 = getShapeLineFunc(drawFunc, ppc3);
+	_dsProcessLine = dsLine2;
 
 	if (!_dsPlot || !dsPlot2 || !dsPlot3) {
 		if (!dsPlot2)
 			warning("Missing drawShape plotting method type %d", ppc);
 		if (dsPlot3 != dsPlot2 && !dsPlot3)
-			warning("Missing drawShape plotting method type %d", (((flags >> 8) & 0xF7) & 0x3F));
+			warning("Missing drawShape plotting method type %d", ppc3);
 		return;
 	}
 
@@ -1700,6 +1788,7 @@ void Screen::drawShape(uint8 pageNum, const uint8 *shapeData, int x, int y, int
 					if (flags & 0x800)
 						normalPlot = (curY > _maskMinY && curY < _maskMaxY);
 					_dsPlot = normalPlot ? dsPlot2 : dsPlot3;
+					_dsProcessLine = normalPlot ? dsLine2 : dsLine3;
 					(this->*_dsProcessLine)(d, src, cnt, scaleState);
 				}
 				cnt += _dsOffscreenRight;
@@ -1828,12 +1917,13 @@ int Screen::drawShapeSkipScaleDownwind(uint8 *&dst, const uint8 *&src, int &cnt)
 	return found ? 0 : _dsOffscreenScaleVal1;
 }
 
+template<int plotType>
 void Screen::drawShapeProcessLineNoScaleUpwind(uint8 *&dst, const uint8 *&src, int &cnt, int16) {
 	do {
 		uint8 c = *src++;
 		if (c) {
 			uint8 *d = dst++;
-			(this->*_dsPlot)(d, c);
+			drawShapePlot<plotType>(d, c);
 			cnt--;
 		} else {
 			c = *src++;
@@ -1843,12 +1933,13 @@ void Screen::drawShapeProcessLineNoScaleUpwind(uint8 *&dst, const uint8 *&src, i
 	} while (cnt > 0);
 }
 
+template<int plotType>
 void Screen::drawShapeProcessLineNoScaleDownwind(uint8 *&dst, const uint8 *&src, int &cnt, int16) {
 	do {
 		uint8 c = *src++;
 		if (c) {
 			uint8 *d = dst--;
-			(this->*_dsPlot)(d, c);
+			drawShapePlot<plotType>(d, c);
 			cnt--;
 		} else {
 			c = *src++;
@@ -1858,6 +1949,7 @@ void Screen::drawShapeProcessLineNoScaleDownwind(uint8 *&dst, const uint8 *&src,
 	} while (cnt > 0);
 }
 
+template<int plotType>
 void Screen::drawShapeProcessLineScaleUpwind(uint8 *&dst, const uint8 *&src, int &cnt, int16 scaleState) {
 	int c = 0;
 
@@ -1877,7 +1969,7 @@ void Screen::drawShapeProcessLineScaleUpwind(uint8 *&dst, const uint8 *&src, int
 				scaleState = r & 0xFF;
 			}
 		} else if (scaleState) {
-			(this->*_dsPlot)(dst++, c);
+			drawShapePlot<plotType>(dst++, c);
 			scaleState -= 0x100;
 			cnt--;
 		}
@@ -1886,6 +1978,7 @@ void Screen::drawShapeProcessLineScaleUpwind(uint8 *&dst, const uint8 *&src, int
 	cnt = -1;
 }
 
+template<int plotType>
 void Screen::drawShapeProcessLineScaleDownwind(uint8 *&dst, const uint8 *&src, int &cnt, int16 scaleState) {
 	int c = 0;
 
@@ -1905,7 +1998,7 @@ void Screen::drawShapeProcessLineScaleDownwind(uint8 *&dst, const uint8 *&src, i
 				scaleState = r & 0xFF;
 			}
 		} else {
-			(this->*_dsPlot)(dst--, c);
+			drawShapePlot<plotType>(dst--, c);
 			scaleState -= 0x100;
 			cnt--;
 		}
@@ -1914,6 +2007,41 @@ void Screen::drawShapeProcessLineScaleDownwind(uint8 *&dst, const uint8 *&src, i
 	cnt = -1;
 }
 
+template<int plotType>
+inline void Screen::drawShapePlot(uint8 *dst, uint8 cmd) {
+	switch (plotType) {
+	case 0:
+		drawShapePlotType0(dst, cmd);
+		break;
+	case 1:
+		drawShapePlotType1(dst, cmd);
+		break;
+	case 3:
+		drawShapePlotType3_7(dst, cmd);
+		break;
+	case 4:
+		drawShapePlotType4(dst, cmd);
+		break;
+	case 8:
+		drawShapePlotType8(dst, cmd);
+		break;
+	case 9:
+		drawShapePlotType9(dst, cmd);
+		break;
+	case 12:
+		drawShapePlotType12(dst, cmd);
+		break;
+	case 37:
+		drawShapePlotType37(dst, cmd);
+		break;
+	case 52:
+		drawShapePlotType52(dst, cmd);
+		break;
+	default:
+		(this->*_dsPlot)(dst, cmd);
+	}
+}
+
 void Screen::drawShapePlotType0(uint8 *dst, uint8 cmd) {
 	*dst = cmd;
 }
@@ -411,6 +411,10 @@ public:
 	bool queryScreenDebug() const { return _debugEnabled; }
 	bool enableScreenDebug(bool enable);
 
+	bool queryShapeVerify() const { return _dsVerify; }
+	void enableShapeVerify(bool enable);
+	void getShapeVerifyStats(uint32 &shapes, uint32 &mismatches) const { shapes = _dsVerifyCount; mismatches = _dsVerifyMismatches; }
+
 	// page cur. functions
 	int setCurPage(int pageNum);
 	void clearCurPage();
@@ -634,10 +638,19 @@ protected:
 	int drawShapeMarginScaleDownwind(uint8 *&dst, const uint8 *&src, int &cnt);
 	int drawShapeSkipScaleUpwind(uint8 *&dst, const uint8 *&src, int &cnt);
 	int drawShapeSkipScaleDownwind(uint8 *&dst, const uint8 *&src, int &cnt);
-	void drawShapeProcessLineNoScaleUpwind(uint8 *&dst, const uint8 *&src, int &cnt, int16 scaleState);
-	void drawShapeProcessLineNoScaleDownwind(uint8 *&dst, const uint8 *&src, int &cnt, int16 scaleState);
-	void drawShapeProcessLineScaleUpwind(uint8 *&dst, const uint8 *&src, int &cnt, int16 scaleState);
-	void drawShapeProcessLineScaleDownwind(uint8 *&dst, const uint8 *&src, int &cnt, int16 scaleState);
+
+	// The line functions are instantiated once per commonly used plotting
+	// method, so the plotting can be inlined. kDsPlotGeneric instead calls
+	// the plotting method through _dsPlot and works for all of them.
+	enum {
+		kDsPlotGeneric = -1
+	};
+
+	template<int plotType> void drawShapeProcessLineNoScaleUpwind(uint8 *&dst, const uint8 *&src, int &cnt, int16 scaleState);
+	template<int plotType> void drawShapeProcessLineNoScaleDownwind(uint8 *&dst, const uint8 *&src, int &cnt, int16 scaleState);
+	template<int plotType> void drawShapeProcessLineScaleUpwind(uint8 *&dst, const uint8 *&src, int &cnt, int16 scaleState);
+	template<int plotType> void drawShapeProcessLineScaleDownwind(uint8 *&dst, const uint8 *&src, int &cnt, int16 scaleState);
+	template<int plotType> void drawShapePlot(uint8 *dst, uint8 cmd);
 
 	void drawShapePlotType0(uint8 *dst, uint8 cmd);
 	void drawShapePlotType1(uint8 *dst, uint8 cmd);
@@ -663,6 +676,10 @@ protected:
 	typedef void (Screen::*DsLineFunc)(uint8 *&dst, const uint8 *&src, int &cnt, int16 scaleState);
 	typedef void (Screen::*DsPlotFunc)(uint8 *dst, uint8 cmd);
 
+	DsLineFunc getShapeLineFunc(int drawFunc, int plotType) const;
+	void drawShapeIntern(uint8 pageNum, const uint8 *shapeData, int x, int y, int sd, int flags);
+	void drawShapeVerify(uint8 pageNum, const uint8 *shapeData, int x, int y, int sd, int flags);
+
 	DsMarginSkipFunc _dsProcessMargin;
 	DsMarginSkipFunc _dsScaleSkip;
 	DsLineFunc _dsProcessLine;
@@ -688,6 +705,14 @@ protected:
 	int _drawShapeVar4;
 	int _drawShapeVar5;
 
+	// When enabled every shape is drawn with the generic and with the
+	// specialised line functions and the results are compared
+	bool _dsSpecialised;
+	bool _dsVerify;
+	uint8 *_dsVerifyPage;
+	uint32 _dsVerifyCount;
+	uint32 _dsVerifyMismatches;
+
 	// AMIGA version
 	bool _interfacePaletteEnabled;
 
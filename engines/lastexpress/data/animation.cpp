@@ -28,7 +28,9 @@
 #include "lastexpress/data/snd.h"
 
 #include "lastexpress/debug.h"
+#include "lastexpress/graphics.h"
 #include "lastexpress/helpers.h"
+#include "lastexpress/lastexpress.h"
 
 #include "common/events.h"
 #include "common/rational.h"
@@ -258,6 +260,10 @@ void Animation::processChunkAudio(Common::SeekableReadStream *in, const Chunk &c
 
 // TODO: this method will probably go away and be integrated in the main loop
 void Animation::play() {
+	// The animation is drawn directly to the screen, so the whole screen
+	// needs to be redrawn from the planes afterwards
+	((LastExpressEngine *)g_engine)->getGraphicsManager()->invalidate();
+
 	Common::EventManager *eventMan = g_system->getEventManager();
 	while (!hasEnded() && !Engine::shouldQuit()) {
 		process();
@@ -128,13 +128,34 @@ AnimFrame::~AnimFrame() {
 }
 
 Common::Rect AnimFrame::draw(Graphics::Surface *s) {
+	// The frame positions do not always match the decompressed data, so
+	// return the rect of the pixels actually drawn instead
+	Common::Rect rect;
+	bool empty = true;
+
 	byte *inp = (byte *)_image.pixels;
 	uint16 *outp = (uint16 *)s->pixels;
-	for (int i = 0; i < 640 * 480; i++, inp++, outp++) {
-		if (*inp)
-			*outp = _palette[*inp];
+	for (int16 y = 0; y < 480; y++) {
+		int16 left = 640, right = 0;
+		for (int16 x = 0; x < 640; x++, inp++, outp++) {
+			if (*inp) {
+				*outp = _palette[*inp];
+				left = MIN(left, x);
+				right = x + 1;
+			}
+		}
+
+		if (left < right) {
+			if (empty) {
+				rect = Common::Rect(left, y, right, y + 1);
+				empty = false;
+			} else {
+				rect.extend(Common::Rect(left, y, right, y + 1));
+			}
+		}
 	}
-	return _rect;
+
+	return rect;
 }
 
 void AnimFrame::readPalette(Common::SeekableReadStream *in, const FrameInfo &f) {
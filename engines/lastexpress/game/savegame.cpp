@@ -362,6 +362,8 @@ SaveLoad::~SaveLoad() {
 void SaveLoad::initStream() {
 	delete _savegame;
 	_savegame = new SavegameStream();
+
+	_entryOffsets.clear();
 }
 
 void SaveLoad::flushStream(GameId id) {
@@ -422,6 +424,8 @@ uint32 SaveLoad::init(GameId id, bool resetHeaders) {
 			// Update sound queue while we go through the savegame
 			getSoundQueue()->updateQueue();
 
+			uint32 position = (uint32)_savegame->pos();
+
 			SavegameEntryHeader *entry = new SavegameEntryHeader();
 			entry->saveLoadWithSerializer(ser);
 
@@ -429,6 +433,7 @@ uint32 SaveLoad::init(GameId id, bool resetHeaders) {
 				break;
 
 			_gameHeaders.push_back(entry);
+			_entryOffsets.push_back(position);
 
 			_savegame->seek(entry->offset, SEEK_CUR);
 		}
@@ -446,21 +451,19 @@ void SaveLoad::loadStream(GameId id) {
 	if (!_savegame)
 		error("[SaveLoad::loadStream] Savegame stream is invalid");
 
-	// Load all savegame data
-	uint8 *buf = new uint8[8192];
-	while (!save->eos() && !save->err()) {
-		_engine->pollEvents();
-
-		uint32 count = save->read(buf, 8192);
-		if (count) {
-			uint32 w = _savegame->write(buf, count);
-			assert (w == count);
-		}
-	}
+	// Load all savegame data at once: the stream grows its buffer to exactly
+	// the requested size, so appending in small chunks would copy the whole
+	// savegame over and over again.
+	uint32 size = (uint32)save->size();
+	uint8 *buf = new uint8[size];
+	uint32 count = save->read(buf, size);
 
-	if (save->err())
+	if (save->err() || count != size)
 		error("SaveLoad::init - Error reading savegame");
 
+	uint32 w = _savegame->write(buf, count);
+	assert (w == count);
+
 	delete[] buf;
 	delete save;
 
@@ -474,8 +477,10 @@ void SaveLoad::clear(bool clearStream) {
 
 	_gameHeaders.clear();
 
-	if (clearStream)
+	if (clearStream) {
 		SAFE_DELETE(_savegame);
+		_entryOffsets.clear();
+	}
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -524,28 +529,58 @@ void SaveLoad::loadLastGame() {
 // Load a specific game entry
 void SaveLoad::loadGame(uint32 index) {
 	if (!_savegame)
-		error("[SaveLoad::loadLastGame] No savegame stream present");
+		error("[SaveLoad::loadGame] No savegame stream present");
 
-	// Rewind current savegame
-	_savegame->seek(0);
+	// Index 0 is the start of the game, entries are stored from index 1 onwards
+	if (index > _entryOffsets.size())
+		error("[SaveLoad::loadGame] Invalid index (was:%d, max:%d)", index, _entryOffsets.size());
 
-	// Write main header (with selected index)
+	// Validate main header
 	SavegameMainHeader header;
+	if (!loadMainHeader(_savegame, &header)) {
+		debugC(2, kLastExpressDebugSavegame, "Cannot load main header: %s", getFilename(getMenu()->getGameId()).c_str());
+		return;
+	}
+
+	SavegameType type = kSavegameTypeIndex;
+	EntityIndex entity = kEntityPlayer;
+	uint32 val = 0;
+
+	// Go to the entry and load it
+	if (index) {
+		_savegame->seek(_entryOffsets[index - 1]);
+		readEntry(&type, &entity, &val, false);
+	}
+
+	// Write main header again with the selected entry as the current one.
+	// Entries past that one are kept until they get overwritten by the next save.
 	header.count = index;
+	header.offsetEntry = index ? _entryOffsets[index - 1] : 32;
+	header.offset = index ? (uint32)_savegame->pos() : 32;
+	header.keepIndex = 0;
 	header.brightness = getState()->brightness;
 	header.volume = getState()->volume;
 
+	if (!header.isValid())
+		error("[SaveLoad::loadGame] Main game header is invalid");
+
+	_savegame->seek(0);
 	Common::Serializer ser(NULL, _savegame);
 	header.saveLoadWithSerializer(ser);
 
-	// TODO
-	// Go to the entry
-	// Load the entry
-	// Get offset (main and entry)
-	// Write main header again with correct entry offset
+	flushStream(getMenu()->getGameId());
+
 	// Setup game and start
+	_gameTicksLastSavegame = getState()->timeTicks;
+
+	if (!index) {
+		getLogic()->resetState();
+		getEntities()->setup(true, kEntityPlayer);
+		return;
+	}
 
-	error("[SaveLoad::loadGame] Not implemented! (only loading the last entry is working for now)");
+	getEntities()->reset();
+	getEntities()->setup(false, entity);
 }
 
 // Save game
@@ -593,12 +628,29 @@ void SaveLoad::saveGame(SavegameType type, EntityIndex entity, uint32 value) {
 	if (type != kSavegameTypeEvent2 && type != kSavegameTypeAuto)
 		header.offsetEntry = (uint32)_savegame->pos();
 
+	uint32 position = (uint32)_savegame->pos();
+
 	// Write the savegame entry
 	writeEntry(type, entity, value);
 
 	if (!header.keepIndex)
 		++header.count;
 
+	// Update the entry index: any entry stored after this one is now stale
+	_entryOffsets.resize(header.count - 1);
+	_entryOffsets.push_back(position);
+
+	// After loading an earlier entry, the stream still holds the later ones.
+	// Invalidate the next entry header so they do not show up again.
+	if (_savegame->pos() < _savegame->size()) {
+		uint32 endPosition = (uint32)_savegame->pos();
+		uint32 count = MIN<uint32>(32, (uint32)(_savegame->size() - _savegame->pos()));
+		while (count--)
+			_savegame->writeByte(0);
+
+		_savegame->seek(endPosition);
+	}
+
 	if (type == kSavegameTypeEvent2 || type == kSavegameTypeAuto) {
 		header.keepIndex = 1;
 	} else {
@@ -802,11 +854,8 @@ void SaveLoad::readEntry(SavegameType *type, EntityIndex *entity, uint32 *val, b
 	*entity = _entity;
 	getProgress().chapter = entry.chapter;
 
-	// Skip padding
-	uint32 offset = (uint32)_savegame->pos() - originalPosition;
-	if (offset & 0xF) {
-		_savegame->seek((~offset & 0xF) + 1, SEEK_SET);
-	}
+	// Skip padding (the entry size stored in the header already includes it)
+	_savegame->seek(originalPosition + entry.offset);
 }
 
 SaveLoad::SavegameEntryHeader *SaveLoad::getEntry(uint32 index) {
@@ -292,6 +292,11 @@ private:
 
 	SavegameStream *_savegame;
 	Common::Array<SavegameEntryHeader *> _gameHeaders;
+
+	// Stream position of each entry header, in the order they are stored in the savegame.
+	// Unlike the cached headers, this stays valid as long as the stream is loaded.
+	Common::Array<uint32> _entryOffsets;
+
 	uint32 _gameTicksLastSavegame;
 
 	// Headers
@@ -30,6 +30,9 @@ namespace LastExpress {
 
 #define COLOR_KEY  0xFFFF
 
+// Past this number of dirty rects, the bounding rect of all of them is merged
+#define MAX_DIRTY_RECTS 16
+
 GraphicsManager::GraphicsManager() : _changed(false) {
 	const Graphics::PixelFormat format(2, 5, 5, 5, 0, 10, 5, 0, 0);
 	_screen.create(640, 480, format);
@@ -53,10 +56,14 @@ GraphicsManager::~GraphicsManager() {
 }
 
 void GraphicsManager::update() {
-	// Update the screen if needed and reset the status
+	// Update the dirty parts of the screen if needed and reset the status
 	if (_changed) {
-		mergePlanes();
-		updateScreen();
+		for (uint i = 0; i < _dirtyRects.size(); i++) {
+			mergePlanes(_dirtyRects[i]);
+			updateScreen(_dirtyRects[i]);
+		}
+
+		_dirtyRects.clear();
 		_changed = false;
 	}
 }
@@ -65,11 +72,30 @@ void GraphicsManager::change() {
 	_changed = true;
 }
 
+void GraphicsManager::invalidate() {
+	addDirtyRect(Common::Rect(640, 480));
+}
+
 void GraphicsManager::clear(BackgroundType type) {
-	clear(type, Common::Rect(640, 480));
+	if (type == kBackgroundAll) {
+		clear(type, Common::Rect(640, 480));
+		return;
+	}
+
+	// The rest of the plane is still transparent
+	const Common::Rect bounds = _drawnBounds[type];
+	if (!bounds.isEmpty())
+		clear(type, bounds);
 }
 
 void GraphicsManager::clear(BackgroundType type, const Common::Rect &rect) {
+	addDirtyRect(rect);
+
+	for (int i = 0; i < kBackgroundAll; i++) {
+		if ((type == i || type == kBackgroundAll) && rect.contains(_drawnBounds[i]))
+			_drawnBounds[i] = Common::Rect();
+	}
+
 	switch (type) {
 		default:
 			error("[GraphicsManager::clear] Unknown background type: %d", type);
@@ -96,12 +122,53 @@ bool GraphicsManager::draw(Drawable *drawable, BackgroundType type, bool transit
 	if (transition)
 		clear(type);
 
-	// TODO store rect for later use
 	Common::Rect rect = drawable->draw(getSurface(type));
+	addDirtyRect(rect);
+
+	if (!rect.isEmpty()) {
+		Common::Rect &bounds = _drawnBounds[type];
+		if (bounds.isEmpty())
+			bounds = rect;
+		else
+			bounds.extend(rect);
+		bounds.clip(640, 480);
+	}
 
 	return (!rect.isEmpty());
 }
 
+void GraphicsManager::addDirtyRect(const Common::Rect &rect) {
+	Common::Rect dirty(rect);
+	dirty.clip(640, 480);
+	if (dirty.isEmpty())
+		return;
+
+	// Merge with all rects it overlaps, which in turn might make the merged
+	// rect overlap some of the rects checked before
+	for (uint i = 0; i < _dirtyRects.size(); ) {
+		if (_dirtyRects[i].contains(dirty))
+			return;
+
+		if (_dirtyRects[i].intersects(dirty)) {
+			dirty.extend(_dirtyRects[i]);
+			_dirtyRects.remove_at(i);
+			i = 0;
+			continue;
+		}
+
+		i++;
+	}
+
+	// Too many rects take longer to update than the whole area they cover
+	if (_dirtyRects.size() == MAX_DIRTY_RECTS) {
+		for (uint i = 0; i < _dirtyRects.size(); i++)
+			dirty.extend(_dirtyRects[i]);
+		_dirtyRects.clear();
+	}
+
+	_dirtyRects.push_back(dirty);
+}
+
 Graphics::Surface *GraphicsManager::getSurface(BackgroundType type) {
 	switch (type) {
 		default:
@@ -126,41 +193,27 @@ Graphics::Surface *GraphicsManager::getSurface(BackgroundType type) {
 	}
 }
 
-// TODO optimize to only merge dirty rects
-void GraphicsManager::mergePlanes() {
-	// Clear screen surface
-	_screen.fillRect(Common::Rect(640, 480), 0);
-
-	uint16 *screen = (uint16 *)_screen.pixels;
-	uint16 *inventory = (uint16 *)_inventory.pixels;
-	uint16 *overlay = (uint16 *)_overlay.pixels;
-	uint16 *backgroundC = (uint16 *)_backgroundC.pixels;
-	uint16 *backgroundA = (uint16 *)_backgroundA.pixels;
-
-	for (int i = 0; i < 640 * 480; i++) {
-
-		if (*inventory != COLOR_KEY)
-			*screen = *inventory;
-		else if (*overlay != COLOR_KEY)
-			*screen = *overlay;
-		else if (*backgroundA != COLOR_KEY)
-			*screen = *backgroundA;
-		else if (*backgroundC != COLOR_KEY)
-			*screen = *backgroundC;
-		else
-			*screen = 0;
-
-		inventory++;
-		screen++;
-		overlay++;
-		backgroundA++;
-		backgroundC++;
+void GraphicsManager::mergePlanes(const Common::Rect &rect) {
+	for (int16 y = rect.top; y < rect.bottom; y++) {
+		uint16 *screen = (uint16 *)_screen.getBasePtr(rect.left, y);
+		const uint16 *inventory = (const uint16 *)_inventory.getBasePtr(rect.left, y);
+		const uint16 *overlay = (const uint16 *)_overlay.getBasePtr(rect.left, y);
+		const uint16 *backgroundA = (const uint16 *)_backgroundA.getBasePtr(rect.left, y);
+		const uint16 *backgroundC = (const uint16 *)_backgroundC.getBasePtr(rect.left, y);
+
+		// Select the topmost plane which is not transparent. This is written
+		// without branches, so that compilers can vectorize the loop.
+		for (int16 x = 0; x < rect.width(); x++) {
+			uint16 color = (backgroundC[x] != COLOR_KEY) ? backgroundC[x] : 0;
+			color = (backgroundA[x] != COLOR_KEY) ? backgroundA[x] : color;
+			color = (overlay[x] != COLOR_KEY) ? overlay[x] : color;
+			screen[x] = (inventory[x] != COLOR_KEY) ? inventory[x] : color;
+		}
 	}
 }
 
-void GraphicsManager::updateScreen() {
-	g_system->fillScreen(0);
-	g_system->copyRectToScreen(_screen.getBasePtr(0, 0), 640 * 2, 0, 0, 640, 480);
+void GraphicsManager::updateScreen(const Common::Rect &rect) {
+	g_system->copyRectToScreen(_screen.getBasePtr(rect.left, rect.top), _screen.pitch, rect.left, rect.top, rect.width(), rect.height());
 }
 
 } // End of namespace LastExpress
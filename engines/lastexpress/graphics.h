@@ -25,6 +25,9 @@
 
 #include "lastexpress/drawable.h"
 
+#include "common/array.h"
+#include "common/rect.h"
+
 namespace LastExpress {
 
 class GraphicsManager {
@@ -43,10 +46,15 @@ public:
 	// Update the screen
 	void update();
 
-	// Signal a change to the screen, will cause the planes to be remerged
+	// Signal a change to the screen, will cause the dirty parts of the planes to be remerged
 	void change();
 
-	// Clear some screen parts
+	// Signal that the screen has been changed without going through the planes,
+	// will cause the whole screen to be remerged on the next change
+	void invalidate();
+
+	// Clear some screen parts. Clearing a whole plane only clears what was drawn to it
+	// since it was last cleared, so only that part is remerged.
 	void clear(BackgroundType type);
 	void clear(BackgroundType type, const Common::Rect &rect);
 
@@ -61,10 +69,17 @@ private:
 	Graphics::Surface _overlay;     // Overlay
 	Graphics::Surface _inventory;   // Overlay
 
-	void mergePlanes();
-	void updateScreen();
+	void mergePlanes(const Common::Rect &rect);
+	void updateScreen(const Common::Rect &rect);
 	Graphics::Surface *getSurface(BackgroundType type);
 
+	// Dirty rects, in screen coordinates
+	void addDirtyRect(const Common::Rect &rect);
+	Common::Array<Common::Rect> _dirtyRects;
+
+	// Bounds of what was drawn to each plane since it was last cleared as a whole
+	Common::Rect _drawnBounds[kBackgroundAll];
+
 	bool _changed;
 };
 
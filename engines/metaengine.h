@@ -169,6 +169,21 @@ public:
 		return SaveStateDescriptor();
 	}
 
+	/**
+	 * Returns the name of the savefile used for the specified save state.
+	 *
+	 * The save/load dialogs use this to validate their meta info cache
+	 * against the savefile. Engines which do not implement this (the
+	 * default implementation returns an empty string) always have their
+	 * meta infos queried via querySaveMetaInfos.
+	 *
+	 * @param target	name of a config manager target
+	 * @param slot		slot number of the save state
+	 */
+	virtual Common::String getSavegameFile(const char *target, int slot) const {
+		return Common::String();
+	}
+
 	/** @name MetaEngineFeature flags */
 	//@{
 
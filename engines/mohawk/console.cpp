@@ -42,6 +42,7 @@
 #ifdef ENABLE_RIVEN
 #include "mohawk/riven.h"
 #include "mohawk/riven_external.h"
+#include "mohawk/riven_graphics.h"
 #endif
 
 namespace Mohawk {
@@ -338,6 +339,7 @@ RivenConsole::RivenConsole(MohawkEngine_Riven *vm) : GUI::Debugger(), _vm(vm) {
 	DCmd_Register("getRMAP",		WRAP_METHOD(RivenConsole, Cmd_GetRMAP));
 	DCmd_Register("combos",         WRAP_METHOD(RivenConsole, Cmd_Combos));
 	DCmd_Register("sliderState",    WRAP_METHOD(RivenConsole, Cmd_SliderState));
+	DCmd_Register("cacheStats",     WRAP_METHOD(RivenConsole, Cmd_CacheStats));
 }
 
 RivenConsole::~RivenConsole() {
@@ -660,6 +662,31 @@ bool RivenConsole::Cmd_SliderState(int argc, const char **argv) {
 	return true;
 }
 
+bool RivenConsole::Cmd_CacheStats(int argc, const char **argv) {
+	if (argc > 1 && !scumm_stricmp(argv[1], "reset")) {
+		_vm->_gfx->resetCacheStats();
+		_vm->_sound->resetPrefetchStats();
+	}
+
+	const GraphicsManager::CacheStats &stats = _vm->_gfx->getCacheStats();
+	uint32 lookups = stats.hits + stats.prefetchHits + stats.misses;
+
+	DebugPrintf("Images:\n");
+	DebugPrintf("  %d lookups, %d cached, %d prefetched, %d decoded on demand\n", lookups, stats.hits, stats.prefetchHits, stats.misses);
+	if (lookups)
+		DebugPrintf("  Hit rate: %d%%\n", (stats.hits + stats.prefetchHits) * 100 / lookups);
+	DebugPrintf("  %d images prefetched, %d dropped unused\n", stats.prefetched, stats.evicted);
+
+	uint32 soundHits, soundMisses, soundEvicted;
+	_vm->_sound->getPrefetchStats(soundHits, soundMisses, soundEvicted);
+
+	DebugPrintf("Sounds:\n");
+	DebugPrintf("  %d started, %d prefetched, %d dropped unused\n", soundHits + soundMisses, soundHits, soundEvicted);
+
+	DebugPrintf("Use cacheStats reset to reset the counters.\n");
+	return true;
+}
+
 #endif // ENABLE_RIVEN
 
 LivingBooksConsole::LivingBooksConsole(MohawkEngine_LivingBooks *vm) : GUI::Debugger(), _vm(vm) {
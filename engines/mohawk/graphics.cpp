@@ -69,10 +69,12 @@ void MohawkSurface::convertToTrueColor() {
 }
 
 GraphicsManager::GraphicsManager() {
+	resetCacheStats();
 }
 
 GraphicsManager::~GraphicsManager() {
 	clearCache();
+	clearPrefetchCache();
 }
 
 void GraphicsManager::clearCache() {
@@ -89,8 +91,17 @@ void GraphicsManager::clearCache() {
 }
 
 MohawkSurface *GraphicsManager::findImage(uint16 id) {
-	if (!_cache.contains(id))
+	if (_cache.contains(id)) {
+		_cacheStats.hits++;
+	} else if (_prefetchCache.contains(id)) {
+		_cacheStats.prefetchHits++;
+		_cache[id] = _prefetchCache[id];
+		_prefetchCache.erase(id);
+		_prefetchOrder.remove(id);
+	} else {
+		_cacheStats.misses++;
 		_cache[id] = decodeImage(id);
+	}
 
 	// TODO: Probably would be nice to limit the size of the cache
 	// Currently, this can't get large because it is freed on every
@@ -104,6 +115,36 @@ Common::Array<MohawkSurface *> GraphicsManager::decodeImages(uint16 id) {
 	error("decodeImages not implemented for this game");
 }
 
+void GraphicsManager::prefetchImage(uint16 id) {
+	if (isImageCached(id))
+		return;
+
+	while (_prefetchOrder.size() >= kMaxPrefetchedImages) {
+		uint16 oldest = _prefetchOrder.front();
+		_prefetchOrder.pop_front();
+		delete _prefetchCache[oldest];
+		_prefetchCache.erase(oldest);
+		_cacheStats.evicted++;
+	}
+
+	_prefetchCache[id] = decodeImage(id);
+	_prefetchOrder.push_back(id);
+	_cacheStats.prefetched++;
+}
+
+void GraphicsManager::clearPrefetchCache() {
+	for (Common::HashMap<uint16, MohawkSurface *>::iterator it = _prefetchCache.begin(); it != _prefetchCache.end(); it++)
+		delete it->_value;
+
+	_cacheStats.evicted += _prefetchCache.size();
+	_prefetchCache.clear();
+	_prefetchOrder.clear();
+}
+
+void GraphicsManager::resetCacheStats() {
+	memset(&_cacheStats, 0, sizeof(_cacheStats));
+}
+
 void GraphicsManager::preloadImage(uint16 image) {
 	findImage(image);
 }
@@ -26,6 +26,7 @@
 #include "mohawk/bitmap.h"
 
 #include "common/hashmap.h"
+#include "common/list.h"
 #include "common/rect.h"
 
 namespace Graphics {
@@ -82,6 +83,23 @@ public:
 
 	void getSubImageSize(uint16 image, uint16 subimage, uint16 &width, uint16 &height);
 
+	// Decodes an image ahead of time into a bounded cache which is kept
+	// across clearCache() calls. findImage() takes the images from there.
+	void prefetchImage(uint16 id);
+	bool isImageCached(uint16 id) const { return _cache.contains(id) || _prefetchCache.contains(id); }
+	void clearPrefetchCache();
+
+	struct CacheStats {
+		uint32 hits;         // Found in the image cache
+		uint32 prefetchHits; // Found in the prefetch cache
+		uint32 misses;       // Decoded on demand
+		uint32 prefetched;   // Decoded by prefetchImage()
+		uint32 evicted;      // Prefetched, but dropped before being used
+	};
+
+	const CacheStats &getCacheStats() const { return _cacheStats; }
+	void resetCacheStats();
+
 protected:
 	void copyAnimImageSectionToScreen(MohawkSurface *image, Common::Rect src, Common::Rect dest);
 
@@ -100,6 +118,15 @@ private:
 	// An image cache that stores images until clearCache() is called
 	Common::HashMap<uint16, MohawkSurface *> _cache;
 	Common::HashMap<uint16, Common::Array<MohawkSurface *> > _subImageCache;
+
+	// Prefetched images, oldest first in _prefetchOrder
+	enum {
+		kMaxPrefetchedImages = 16
+	};
+
+	Common::HashMap<uint16, MohawkSurface *> _prefetchCache;
+	Common::List<uint16> _prefetchOrder;
+	CacheStats _cacheStats;
 };
 
 } // End of namespace Mohawk
@@ -195,8 +195,11 @@ void MohawkEngine_Riven::handleEvents() {
 	needsUpdate |= _video->updateMovies();
 
 	Common::Event event;
+	bool hadEvents = false;
 
 	while (_eventMan->pollEvent(event)) {
+		hadEvents = true;
+
 		switch (event.type) {
 		case Common::EVENT_MOUSEMOVE:
 			checkHotspotChange();
@@ -284,6 +287,17 @@ void MohawkEngine_Riven::handleEvents() {
 	if (needsUpdate)
 		_system->updateScreen();
 
+	// Use idle time to prepare the cards the player may go to next
+	if (!hadEvents && !_prefetchQueue.empty() && !_video->isVideoPlaying()) {
+		uint32 startTime = _system->getMillis();
+		runPrefetch();
+
+		uint32 elapsed = _system->getMillis() - startTime;
+		if (elapsed < 10)
+			_system->delayMillis(10 - elapsed);
+		return;
+	}
+
 	// Cut down on CPU usage
 	_system->delayMillis(10);
 }
@@ -308,6 +322,9 @@ void MohawkEngine_Riven::changeToStack(uint16 n) {
 
 	// Clear the graphics cache; images aren't used across stack boundaries
 	_gfx->clearCache();
+	_gfx->clearPrefetchCache();
+	_sound->clearPrefetchedSounds();
+	_prefetchQueue.clear();
 
 	// Clear the old stack files out
 	for (uint32 i = 0; i < _mhk.size(); i++)
@@ -412,6 +429,122 @@ void MohawkEngine_Riven::refreshCard() {
 
 	// Finally, install any hardcoded timer
 	installCardTimer();
+
+	queuePrefetch();
+}
+
+void MohawkEngine_Riven::queuePrefetch() {
+	// Anything queued for the previous card is stale now
+	_prefetchQueue.clear();
+
+	Common::Array<uint16> cards;
+	for (uint16 i = 0; i < _hotspotCount; i++) {
+		if (!_hotspots[i].enabled)
+			continue;
+
+		for (uint16 j = 0; j < _hotspots[i].scripts.size(); j++) {
+			uint16 scriptType = _hotspots[i].scripts[j]->getScriptType();
+			if (scriptType == kMouseDownScript || scriptType == kMouseUpScript)
+				_hotspots[i].scripts[j]->findCardSwitches(cards);
+		}
+	}
+
+	for (uint16 i = 0; i < cards.size(); i++) {
+		// Skip cards which are left right away for another stack
+		bool specialChange = false;
+		if (!(getFeatures() & GF_DEMO))
+			for (byte j = 0; j < ARRAYSIZE(rivenSpecialChange); j++)
+				if (_curStack == rivenSpecialChange[j].startStack && cards[i] == matchRMAPToCard(rivenSpecialChange[j].startCardRMAP))
+					specialChange = true;
+
+		if (specialChange || cards[i] == _curCard || !hasResource(ID_CARD, cards[i]))
+			cards.remove_at(i--);
+	}
+
+	debug(2, "Prefetching %d cards reachable from card %d", cards.size(), _curCard);
+
+	// The image shown when entering a card comes first, then its sounds
+	// and finally all other images the card may show.
+	for (uint16 i = 0; i < cards.size(); i++)
+		queuePrefetchImages(cards[i], true);
+	for (uint16 i = 0; i < cards.size(); i++)
+		queuePrefetchSounds(cards[i]);
+	for (uint16 i = 0; i < cards.size(); i++)
+		queuePrefetchImages(cards[i], false);
+}
+
+void MohawkEngine_Riven::queuePrefetchImages(uint16 card, bool firstOnly) {
+	if (!hasResource(ID_PLST, card))
+		return;
+
+	Common::SeekableReadStream *plst = getResource(ID_PLST, card);
+	uint16 recordCount = plst->readUint16BE();
+
+	for (uint16 i = 0; i < recordCount; i++) {
+		uint16 index = plst->readUint16BE();
+		PrefetchItem item;
+		item.tag = ID_TBMP;
+		item.id = plst->readUint16BE();
+		plst->skip(8); // Rect
+
+		if ((index == 1) == firstOnly)
+			_prefetchQueue.push_back(item);
+	}
+
+	delete plst;
+}
+
+void MohawkEngine_Riven::queuePrefetchSounds(uint16 card) {
+	if (!hasResource(ID_SLST, card))
+		return;
+
+	Common::SeekableReadStream *slst = getResource(ID_SLST, card);
+	uint16 recordCount = slst->readUint16BE();
+
+	// Only the first sound list is activated when entering the card
+	for (uint16 i = 0; i < recordCount; i++) {
+		uint16 index = slst->readUint16BE();
+		uint16 soundCount = slst->readUint16BE();
+
+		if (index != 1) {
+			// Sound ids, 5 words and volumes, balances and u2 per sound
+			slst->skip(soundCount * 2 + 10 + soundCount * 6);
+			continue;
+		}
+
+		uint16 *soundIds = new uint16[soundCount];
+		for (uint16 j = 0; j < soundCount; j++)
+			soundIds[j] = slst->readUint16BE();
+
+		slst->skip(10);
+
+		for (uint16 j = 0; j < soundCount; j++) {
+			// Sounds with a volume of 0 are never played
+			PrefetchItem item;
+			item.tag = ID_TWAV;
+			item.id = soundIds[j];
+			if (slst->readUint16BE() != 0)
+				_prefetchQueue.push_back(item);
+		}
+
+		delete[] soundIds;
+		break;
+	}
+
+	delete slst;
+}
+
+void MohawkEngine_Riven::runPrefetch() {
+	PrefetchItem item = _prefetchQueue.front();
+	_prefetchQueue.pop_front();
+
+	if (!hasResource(item.tag, item.id))
+		return;
+
+	if (item.tag == ID_TBMP)
+		_gfx->prefetchImage(item.id);
+	else
+		_sound->prefetchSLSTSound(item.id);
 }
 
 void MohawkEngine_Riven::loadCard(uint16 id) {
@@ -31,6 +31,7 @@
 
 #include "common/hashmap.h"
 #include "common/hash-str.h"
+#include "common/list.h"
 #include "common/random.h"
 #include "common/rect.h"
 
@@ -173,6 +174,18 @@ private:
 	bool _ignoreNextMouseUp;
 	void checkSunnerAlertClick();
 
+	// Prefetching of the cards reachable from the current one
+	struct PrefetchItem {
+		uint32 tag;
+		uint16 id;
+	};
+
+	Common::List<PrefetchItem> _prefetchQueue;
+	void queuePrefetch();
+	void queuePrefetchImages(uint16 card, bool firstOnly);
+	void queuePrefetchSounds(uint16 card);
+	void runPrefetch();
+
 public:
 	// Stack/card/script funtions
 	void changeToCard(uint16 dest);
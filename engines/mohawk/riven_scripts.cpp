@@ -28,6 +28,7 @@
 #include "mohawk/sound.h"
 #include "mohawk/video.h"
 
+#include "common/algorithm.h"
 #include "common/memstream.h"
 #include "common/stream.h"
 #include "common/system.h"
@@ -281,6 +282,49 @@ void RivenScript::processCommands(bool runCommands) {
 	}
 }
 
+void RivenScript::findCardSwitches(Common::Array<uint16> &cards) {
+	// This may be called while the script itself is running
+	const int32 oldPos = _stream->pos();
+
+	_stream->seek(0);
+	findCardSwitches(true, cards);
+	_stream->seek(oldPos);
+}
+
+void RivenScript::findCardSwitches(bool runCommands, Common::Array<uint16> &cards) {
+	// Only the blocks which would be run with the current variable values
+	// are considered, just like processCommands() does
+	uint16 commandCount = _stream->readUint16BE();
+
+	for (uint16 j = 0; j < commandCount && _stream->pos() < _stream->size(); j++) {
+		uint16 command = _stream->readUint16BE();
+
+		if (command == 8) {
+			_stream->readUint16BE();
+			uint16 var = _stream->readUint16BE();
+			uint16 logicBlockCount = _stream->readUint16BE();
+			bool anotherBlockEvaluated = false;
+
+			for (uint16 k = 0; k < logicBlockCount; k++) {
+				uint16 checkValue = _stream->readUint16BE();
+				bool runBlock = (_vm->getStackVar(var) == checkValue || checkValue == 0xffff) && runCommands && !anotherBlockEvaluated;
+				findCardSwitches(runBlock, cards);
+
+				if (runBlock)
+					anotherBlockEvaluated = true;
+			}
+		} else {
+			uint16 argCount = _stream->readUint16BE();
+			uint16 firstArg = argCount ? _stream->readUint16BE() : 0;
+			_stream->skip(MAX<int>(argCount - 1, 0) * 2);
+
+			// Command 2: go to card (card id)
+			if (runCommands && command == 2 && argCount > 0 && Common::find(cards.begin(), cards.end(), firstArg) == cards.end())
+				cards.push_back(firstArg);
+		}
+	}
+}
+
 ////////////////////////////////
 // Opcodes
 ////////////////////////////////
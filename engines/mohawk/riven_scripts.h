@@ -57,6 +57,7 @@ public:
 	~RivenScript();
 
 	void runScript();
+	void findCardSwitches(Common::Array<uint16> &cards);
 	void dumpScript(const Common::StringArray &varNames, const Common::StringArray &xNames, byte tabs);
 	uint16 getScriptType() { return _scriptType; }
 	uint16 getParentStack() { return _parentStack; }
@@ -82,6 +83,7 @@ private:
 
 	void dumpCommands(const Common::StringArray &varNames, const Common::StringArray &xNames, byte tabs);
 	void processCommands(bool runCommands);
+	void findCardSwitches(bool runCommands, Common::Array<uint16> &cards);
 
 	static uint32 calculateCommandSize(Common::SeekableReadStream *script);
 
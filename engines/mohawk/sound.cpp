@@ -41,6 +41,8 @@ Sound::Sound(MohawkEngine* vm) : _vm(vm) {
 	_midiParser = NULL;
 	_midiData = NULL;
 	_mystBackgroundSound.type = kFreeHandle;
+	_prefetchedSoundSize = 0;
+	resetPrefetchStats();
 	initMidi();
 }
 
@@ -48,6 +50,7 @@ Sound::~Sound() {
 	stopSound();
 	stopAllSLST();
 	stopBackgroundMyst();
+	clearPrefetchedSounds();
 
 	if (_midiParser) {
 		_midiParser->unloadMusic();
@@ -335,7 +338,19 @@ void Sound::playSLSTSound(uint16 id, bool fade, bool loop, uint16 volume, int16
 	sndHandle.id = id;
 	_currentSLSTSounds.push_back(sndHandle);
 
-	Audio::AudioStream *audStream = makeMohawkWaveStream(_vm->getResource(ID_TWAV, id));
+	Common::SeekableReadStream *stream;
+	if (_prefetchedSounds.contains(id)) {
+		stream = _prefetchedSounds[id];
+		_prefetchedSounds.erase(id);
+		_prefetchedSoundOrder.remove(id);
+		_prefetchedSoundSize -= stream->size();
+		_prefetchHits++;
+	} else {
+		stream = _vm->getResource(ID_TWAV, id);
+		_prefetchMisses++;
+	}
+
+	Audio::AudioStream *audStream = makeMohawkWaveStream(stream);
 
 	// Loop here if necessary
 	if (loop)
@@ -353,6 +368,56 @@ void Sound::stopSLSTSound(uint16 index, bool fade) {
 	_currentSLSTSounds.remove_at(index);
 }
 
+void Sound::prefetchSLSTSound(uint16 id) {
+	if (_prefetchedSounds.contains(id))
+		return;
+
+	// Sounds which are already playing don't need to be started again
+	for (uint16 i = 0; i < _currentSLSTSounds.size(); i++)
+		if (_currentSLSTSounds[i].id == id)
+			return;
+
+	Common::SeekableReadStream *stream = _vm->getResource(ID_TWAV, id);
+	uint32 size = stream->size();
+
+	if (size > kPrefetchSoundBudget) {
+		delete stream;
+		return;
+	}
+
+	while (_prefetchedSoundSize + size > kPrefetchSoundBudget)
+		evictPrefetchedSound();
+
+	_prefetchedSounds[id] = stream->readStream(size);
+	_prefetchedSoundOrder.push_back(id);
+	_prefetchedSoundSize += size;
+	delete stream;
+}
+
+void Sound::evictPrefetchedSound() {
+	uint16 oldest = _prefetchedSoundOrder.front();
+	_prefetchedSoundOrder.pop_front();
+	_prefetchedSoundSize -= _prefetchedSounds[oldest]->size();
+	delete _prefetchedSounds[oldest];
+	_prefetchedSounds.erase(oldest);
+	_prefetchEvicted++;
+}
+
+void Sound::clearPrefetchedSounds() {
+	while (!_prefetchedSoundOrder.empty())
+		evictPrefetchedSound();
+}
+
+void Sound::getPrefetchStats(uint32 &hits, uint32 &misses, uint32 &evicted) const {
+	hits = _prefetchHits;
+	misses = _prefetchMisses;
+	evicted = _prefetchEvicted;
+}
+
+void Sound::resetPrefetchStats() {
+	_prefetchHits = _prefetchMisses = _prefetchEvicted = 0;
+}
+
 void Sound::pauseSLST() {
 	for (uint16 i = 0; i < _currentSLSTSounds.size(); i++)
 		_vm->_mixer->pauseHandle(*_currentSLSTSounds[i].handle, true);
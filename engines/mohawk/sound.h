@@ -24,6 +24,8 @@
 #define MOHAWK_SOUND_H
 
 #include "common/scummsys.h"
+#include "common/hashmap.h"
+#include "common/list.h"
 #include "common/str.h"
 
 #include "audio/audiostream.h"
@@ -150,6 +152,13 @@ public:
 	void stopAllSLST(bool fade = false);
 	static byte convertRivenVolume(uint16 volume);
 
+	// Reads a SLST sound into memory ahead of time. The data is handed over
+	// when the sound is started, or dropped once the budget is exceeded.
+	void prefetchSLSTSound(uint16 id);
+	void clearPrefetchedSounds();
+	void getPrefetchStats(uint32 &hits, uint32 &misses, uint32 &evicted) const;
+	void resetPrefetchStats();
+
 private:
 	MohawkEngine *_vm;
 	MidiDriver *_midiDriver;
@@ -172,6 +181,17 @@ private:
 	void playSLSTSound(uint16 index, bool fade, bool loop, uint16 volume, int16 balance);
 	void stopSLSTSound(uint16 id, bool fade);
 	Common::Array<SLSTSndHandle> _currentSLSTSounds;
+
+	enum {
+		kPrefetchSoundBudget = 4 * 1024 * 1024
+	};
+
+	void evictPrefetchedSound();
+
+	Common::HashMap<uint16, Common::SeekableReadStream *> _prefetchedSounds;
+	Common::List<uint16> _prefetchedSoundOrder;
+	uint32 _prefetchedSoundSize;
+	uint32 _prefetchHits, _prefetchMisses, _prefetchEvicted;
 };
 
 } // End of namespace Mohawk
@@ -114,6 +114,12 @@ public:
 	 */
 	void setSaveDate(int year, int month, int day);
 
+	/**
+	 * Sets the human readable description of the creation date directly.
+	 * This is used to restore a description from cached meta data.
+	 */
+	void setSaveDate(const Common::String &date) { _saveDate = date; }
+
 	/**
 	 * Queries a human readable description of the date the save state was created.
 	 *
@@ -129,6 +135,12 @@ public:
 	 */
 	void setSaveTime(int hour, int min);
 
+	/**
+	 * Sets the human readable description of the creation time directly.
+	 * This is used to restore a description from cached meta data.
+	 */
+	void setSaveTime(const Common::String &time) { _saveTime = time; }
+
 	/**
 	 * Queries a human readable description of the time the save state was created.
 	 *
@@ -151,6 +163,12 @@ public:
 	 */
 	void setPlayTime(uint32 msecs);
 
+	/**
+	 * Sets the human readable description of the play time directly.
+	 * This is used to restore a description from cached meta data.
+	 */
+	void setPlayTime(const Common::String &playTime) { _playTime = playTime; }
+
 	/**
 	 * Queries a human readable description of the time the game was played
 	 * before the save state was created.
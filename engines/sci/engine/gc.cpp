@@ -22,6 +22,7 @@
 
 #include "sci/engine/gc.h"
 #include "common/array.h"
+#include "common/trace.h"
 #include "sci/graphics/ports.h"
 
 namespace Sci {
@@ -50,7 +51,8 @@ void WorklistManager::push(reg_t reg) {
 	if (!reg.getSegment()) // No numbers
 		return;
 
-	debugC(kDebugLevelGC, "[GC] Adding %04x:%04x", PRINT_REG(reg));
+	if (debugChannelSet(-1, kDebugLevelGC))
+		debugC(kDebugLevelGC, "[GC] Adding %04x:%04x", PRINT_REG(reg));
 
 	if (_map.contains(reg))
 		return; // already dealt with it
@@ -86,7 +88,8 @@ static void processWorkList(SegManager *segMan, WorklistManager &wm, const Commo
 		reg_t reg = wm._worklist.back();
 		wm._worklist.pop_back();
 		if (reg.getSegment() != stackSegment) { // No need to repeat this one
-			debugC(kDebugLevelGC, "[GC] Checking %04x:%04x", PRINT_REG(reg));
+			if (debugChannelSet(-1, kDebugLevelGC))
+				debugC(kDebugLevelGC, "[GC] Checking %04x:%04x", PRINT_REG(reg));
 			if (reg.getSegment() < heap.size() && heap[reg.getSegment()]) {
 				// Valid heap object? Find its outgoing references!
 				wm.pushArray(heap[reg.getSegment()]->listAllOutgoingReferences(reg));
@@ -161,6 +164,8 @@ AddrSet *findAllActiveReferences(EngineState *s) {
 }
 
 void run_gc(EngineState *s) {
+	TRACE_SCOPE("sci", "run_gc");
+
 	SegManager *segMan = s->_segMan;
 
 	// Some debug stuff
@@ -195,7 +200,8 @@ void run_gc(EngineState *s) {
 				if (!activeRefs->contains(addr)) {
 					// Not found -> we can free it
 					mobj->freeAtAddress(segMan, addr);
-					debugC(kDebugLevelGC, "[GC] Deallocating %04x:%04x", PRINT_REG(addr));
+					if (debugChannelSet(-1, kDebugLevelGC))
+						debugC(kDebugLevelGC, "[GC] Deallocating %04x:%04x", PRINT_REG(addr));
 #ifdef GC_DEBUG_CODE
 					segcount[type]++;
 #endif
@@ -23,6 +23,7 @@
 #ifdef ENABLE_HE
 
 #include "common/archive.h"
+#include "common/hashmap.h"
 #include "common/system.h"
 #include "graphics/cursorman.h"
 #include "graphics/primitives.h"
@@ -370,7 +371,7 @@ void Wiz::writeColor(uint8 *dstPtr, int dstType, uint16 color) {
 }
 
 #ifdef USE_RGB_COLOR
-void Wiz::copy16BitWizImage(uint8 *dst, const uint8 *src, int dstPitch, int dstType, int dstw, int dsth, int srcx, int srcy, int srcw, int srch, const Common::Rect *rect, int flags, const uint8 *xmapPtr) {
+void Wiz::copy16BitWizImage(uint8 *dst, const uint8 *src, int dstPitch, int dstType, int dstw, int dsth, int srcx, int srcy, int srcw, int srch, const Common::Rect *rect, int flags, const uint8 *xmapPtr, const uint32 *rowOffsets) {
 	Common::Rect r1, r2;
 	if (calcClipRects(dstw, dsth, srcx, srcy, srcw, srch, rect, r1, r2)) {
 		dst += r2.top * dstPitch + r2.left * 2;
@@ -383,15 +384,15 @@ void Wiz::copy16BitWizImage(uint8 *dst, const uint8 *src, int dstPitch, int dstT
 			r1.translate(dx, 0);
 		}
 		if (xmapPtr) {
-			decompress16BitWizImage<kWizXMap>(dst, dstPitch, dstType, src, r1, flags, xmapPtr);
+			decompress16BitWizImage<kWizXMap>(dst, dstPitch, dstType, src, r1, flags, xmapPtr, rowOffsets);
 		} else {
-			decompress16BitWizImage<kWizCopy>(dst, dstPitch, dstType, src, r1, flags);
+			decompress16BitWizImage<kWizCopy>(dst, dstPitch, dstType, src, r1, flags, NULL, rowOffsets);
 		}
 	}
 }
 #endif
 
-void Wiz::copyWizImage(uint8 *dst, const uint8 *src, int dstPitch, int dstType, int dstw, int dsth, int srcx, int srcy, int srcw, int srch, const Common::Rect *rect, int flags, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth) {
+void Wiz::copyWizImage(uint8 *dst, const uint8 *src, int dstPitch, int dstType, int dstw, int dsth, int srcx, int srcy, int srcw, int srch, const Common::Rect *rect, int flags, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth, const uint32 *rowOffsets) {
 	Common::Rect r1, r2;
 	if (calcClipRects(dstw, dsth, srcx, srcy, srcw, srch, rect, r1, r2)) {
 		dst += r2.top * dstPitch + r2.left * bitDepth;
@@ -404,11 +405,11 @@ void Wiz::copyWizImage(uint8 *dst, const uint8 *src, int dstPitch, int dstType,
 			r1.translate(dx, 0);
 		}
 		if (xmapPtr) {
-			decompressWizImage<kWizXMap>(dst, dstPitch, dstType, src, r1, flags, palPtr, xmapPtr, bitDepth);
+			decompressWizImage<kWizXMap>(dst, dstPitch, dstType, src, r1, flags, palPtr, xmapPtr, bitDepth, rowOffsets);
 		} else if (palPtr) {
-			decompressWizImage<kWizRMap>(dst, dstPitch, dstType, src, r1, flags, palPtr, NULL, bitDepth);
+			decompressWizImage<kWizRMap>(dst, dstPitch, dstType, src, r1, flags, palPtr, NULL, bitDepth, rowOffsets);
 		} else {
-			decompressWizImage<kWizCopy>(dst, dstPitch, dstType, src, r1, flags, NULL, NULL, bitDepth);
+			decompressWizImage<kWizCopy>(dst, dstPitch, dstType, src, r1, flags, NULL, NULL, bitDepth, rowOffsets);
 		}
 	}
 }
@@ -702,7 +703,7 @@ void Wiz::write16BitColor(uint8 *dstPtr, const uint8 *dataPtr, int dstType, cons
 }
 
 template<int type>
-void Wiz::decompress16BitWizImage(uint8 *dst, int dstPitch, int dstType, const uint8 *src, const Common::Rect &srcRect, int flags, const uint8 *xmapPtr) {
+void Wiz::decompress16BitWizImage(uint8 *dst, int dstPitch, int dstType, const uint8 *src, const Common::Rect &srcRect, int flags, const uint8 *xmapPtr, const uint32 *rowOffsets) {
 	const uint8 *dataPtr, *dataPtrNext;
 	uint8 code;
 	uint8 *dstPtr, *dstPtrNext;
@@ -716,9 +717,13 @@ void Wiz::decompress16BitWizImage(uint8 *dst, int dstPitch, int dstType, const u
 	dataPtr = src;
 
 	// Skip over the first 'srcRect->top' lines in the data
-	h = srcRect.top;
-	while (h--) {
-		dataPtr += READ_LE_UINT16(dataPtr) + 2;
+	if (rowOffsets) {
+		dataPtr += rowOffsets[srcRect.top];
+	} else {
+		h = srcRect.top;
+		while (h--) {
+			dataPtr += READ_LE_UINT16(dataPtr) + 2;
+		}
 	}
 	h = srcRect.height();
 	w = srcRect.width();
@@ -834,7 +839,7 @@ void Wiz::write8BitColor(uint8 *dstPtr, const uint8 *dataPtr, int dstType, const
 }
 
 template<int type>
-void Wiz::decompressWizImage(uint8 *dst, int dstPitch, int dstType, const uint8 *src, const Common::Rect &srcRect, int flags, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth) {
+void Wiz::decompressWizImage(uint8 *dst, int dstPitch, int dstType, const uint8 *src, const Common::Rect &srcRect, int flags, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth, const uint32 *rowOffsets) {
 	const uint8 *dataPtr, *dataPtrNext;
 	uint8 code, *dstPtr, *dstPtrNext;
 	int h, w, xoff, dstInc;
@@ -850,9 +855,13 @@ void Wiz::decompressWizImage(uint8 *dst, int dstPitch, int dstType, const uint8
 	dataPtr = src;
 
 	// Skip over the first 'srcRect->top' lines in the data
-	h = srcRect.top;
-	while (h--) {
-		dataPtr += READ_LE_UINT16(dataPtr) + 2;
+	if (rowOffsets) {
+		dataPtr += rowOffsets[srcRect.top];
+	} else {
+		h = srcRect.top;
+		while (h--) {
+			dataPtr += READ_LE_UINT16(dataPtr) + 2;
+		}
 	}
 	h = srcRect.height();
 	w = srcRect.width();
@@ -938,9 +947,9 @@ void Wiz::decompressWizImage(uint8 *dst, int dstPitch, int dstType, const uint8
 }
 
 // NOTE: These templates are used outside this file. We don't want the compiler to optimize them away, so we need to explicitely instantiate them.
-template void Wiz::decompressWizImage<kWizXMap>(uint8 *dst, int dstPitch, int dstType, const uint8 *src, const Common::Rect &srcRect, int flags, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth);
-template void Wiz::decompressWizImage<kWizRMap>(uint8 *dst, int dstPitch, int dstType, const uint8 *src, const Common::Rect &srcRect, int flags, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth);
-template void Wiz::decompressWizImage<kWizCopy>(uint8 *dst, int dstPitch, int dstType, const uint8 *src, const Common::Rect &srcRect, int flags, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth);
+template void Wiz::decompressWizImage<kWizXMap>(uint8 *dst, int dstPitch, int dstType, const uint8 *src, const Common::Rect &srcRect, int flags, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth, const uint32 *rowOffsets);
+template void Wiz::decompressWizImage<kWizRMap>(uint8 *dst, int dstPitch, int dstType, const uint8 *src, const Common::Rect &srcRect, int flags, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth, const uint32 *rowOffsets);
+template void Wiz::decompressWizImage<kWizCopy>(uint8 *dst, int dstPitch, int dstType, const uint8 *src, const Common::Rect &srcRect, int flags, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth, const uint32 *rowOffsets);
 
 template<int type>
 void Wiz::decompressRawWizImage(uint8 *dst, int dstPitch, int dstType, const uint8 *src, int srcPitch, int w, int h, int transColor, const uint8 *palPtr, uint8 bitDepth) {
@@ -976,13 +985,17 @@ void Wiz::decompressRawWizImage(uint8 *dst, int dstPitch, int dstType, const uin
 	}
 }
 
-int Wiz::isWizPixelNonTransparent(const uint8 *data, int x, int y, int w, int h, uint8 bitDepth) {
+int Wiz::isWizPixelNonTransparent(const uint8 *data, int x, int y, int w, int h, uint8 bitDepth, const uint32 *rowOffsets) {
 	if (x < 0 || x >= w || y < 0 || y >= h) {
 		return 0;
 	}
-	while (y != 0) {
-		data += READ_LE_UINT16(data) + 2;
-		--y;
+	if (rowOffsets) {
+		data += rowOffsets[y];
+	} else {
+		while (y != 0) {
+			data += READ_LE_UINT16(data) + 2;
+			--y;
+		}
 	}
 	uint16 off = READ_LE_UINT16(data); data += 2;
 	if (off == 0) {
@@ -1019,13 +1032,17 @@ int Wiz::isWizPixelNonTransparent(const uint8 *data, int x, int y, int w, int h,
 		return (~data[0]) & 1;
 }
 
-uint16 Wiz::getWizPixelColor(const uint8 *data, int x, int y, int w, int h, uint8 bitDepth, uint16 color) {
+uint16 Wiz::getWizPixelColor(const uint8 *data, int x, int y, int w, int h, uint8 bitDepth, uint16 color, const uint32 *rowOffsets) {
 	if (x < 0 || x >= w || y < 0 || y >= h) {
 		return color;
 	}
-	while (y != 0) {
-		data += READ_LE_UINT16(data) + 2;
-		--y;
+	if (rowOffsets) {
+		data += rowOffsets[y];
+	} else {
+		while (y != 0) {
+			data += READ_LE_UINT16(data) + 2;
+			--y;
+		}
 	}
 	uint16 off = READ_LE_UINT16(data); data += 2;
 	if (off == 0) {
@@ -1073,6 +1090,39 @@ uint16 Wiz::getRawWizPixelColor(const uint8 *data, int x, int y, int w, int h, u
 		return data[y * w + x];
 }
 
+/**
+ * Row offsets of the RLE compressed states of a Wiz image resource, so
+ * single rows can be accessed without walking over all the rows above.
+ */
+class WizRowIndex : public ResourceCache {
+public:
+	Common::HashMap<int, Common::Array<uint32> > _states;
+};
+
+const uint32 *Wiz::getWizRowOffsets(int resNum, int state, const uint8 *wizd, int h) {
+	if (h <= 0)
+		return NULL;
+
+	WizRowIndex *index = (WizRowIndex *)_vm->_res->getResourceCache(rtImage, resNum);
+	if (!index) {
+		index = new WizRowIndex();
+		_vm->_res->setResourceCache(rtImage, resNum, index);
+	}
+
+	Common::Array<uint32> &offsets = index->_states[state];
+	if (offsets.size() != (uint)h) {
+		offsets.resize(h);
+
+		uint32 offset = 0;
+		for (int y = 0; y < h; ++y) {
+			offsets[y] = offset;
+			offset += READ_LE_UINT16(wizd + offset) + 2;
+		}
+	}
+
+	return offsets.begin();
+}
+
 void Wiz::computeWizHistogram(uint32 *histogram, const uint8 *data, const Common::Rect &rCapt) {
 	int h = rCapt.top;
 	while (h--) {
@@ -1582,7 +1632,7 @@ uint8 *Wiz::drawWizImage(int resNum, int state, int maskNum, int maskState, int
 			dstPitch /= _vm->_bytesPerPixel;
 			copyWizImageWithMask(dst, wizd, dstPitch, cw, ch, x1, y1, width, height, &rScreen, 0, 1);
 		} else {
-			copyWizImage(dst, wizd, dstPitch, dstType, cw, ch, x1, y1, width, height, &rScreen, flags, palPtr, xmapPtr, _vm->_bytesPerPixel);
+			copyWizImage(dst, wizd, dstPitch, dstType, cw, ch, x1, y1, width, height, &rScreen, flags, palPtr, xmapPtr, _vm->_bytesPerPixel, getWizRowOffsets(resNum, state, wizd, height));
 		}
 		break;
 #ifdef USE_RGB_COLOR
@@ -1597,7 +1647,7 @@ uint8 *Wiz::drawWizImage(int resNum, int state, int maskNum, int maskState, int
 		// TODO: Unknown image type
 		break;
 	case 5:
-		copy16BitWizImage(dst, wizd, dstPitch, dstType, cw, ch, x1, y1, width, height, &rScreen, flags, xmapPtr);
+		copy16BitWizImage(dst, wizd, dstPitch, dstType, cw, ch, x1, y1, width, height, &rScreen, flags, xmapPtr, getWizRowOffsets(resNum, state, wizd, height));
 		break;
 #endif
 	default:
@@ -2596,7 +2646,7 @@ int Wiz::isWizPixelNonTransparent(int resNum, int state, int x, int y, int flags
 			}
 			break;
 		case 1:
-			ret = isWizPixelNonTransparent(wizd, x, y, w, h, 1);
+			ret = isWizPixelNonTransparent(wizd, x, y, w, h, 1, getWizRowOffsets(resNum, state, wizd, h));
 			break;
 #ifdef USE_RGB_COLOR
 		case 2:
@@ -2608,7 +2658,7 @@ int Wiz::isWizPixelNonTransparent(int resNum, int state, int x, int y, int flags
 			debug(0, "isWizPixelNonTransparent: Unhandled wiz compression type %d", c);
 			break;
 		case 5:
-			ret = isWizPixelNonTransparent(wizd, x, y, w, h, 2);
+			ret = isWizPixelNonTransparent(wizd, x, y, w, h, 2, getWizRowOffsets(resNum, state, wizd, h));
 			break;
 #endif
 		default:
@@ -2639,7 +2689,7 @@ uint16 Wiz::getWizPixelColor(int resNum, int state, int x, int y) {
 		}
 		break;
 	case 1:
-		color = getWizPixelColor(wizd, x, y, w, h, 1, _vm->VAR(_vm->VAR_WIZ_TCOLOR));
+		color = getWizPixelColor(wizd, x, y, w, h, 1, _vm->VAR(_vm->VAR_WIZ_TCOLOR), getWizRowOffsets(resNum, state, wizd, h));
 		break;
 #ifdef USE_RGB_COLOR
 	case 2:
@@ -2650,7 +2700,7 @@ uint16 Wiz::getWizPixelColor(int resNum, int state, int x, int y) {
 		debug(0, "getWizPixelColor: Unhandled wiz compression type %d", c);
 		break;
 	case 5:
-		color = getWizPixelColor(wizd, x, y, w, h, 2, _vm->VAR(_vm->VAR_WIZ_TCOLOR));
+		color = getWizPixelColor(wizd, x, y, w, h, 2, _vm->VAR(_vm->VAR_WIZ_TCOLOR), getWizRowOffsets(resNum, state, wizd, h));
 		break;
 #endif
 	default:
@@ -51,6 +51,10 @@ int PcSpkDriver::open() {
 	_lastActiveChannel = 0;
 	_lastActiveOut = 0;
 
+	// The speaker is only changed through applyRegisterWrite(), so the timer
+	// of a whole mixer buffer can be run at once
+	setRegisterQueueEnabled(true);
+
 	// We set the output sound type to music here to allow sound volume
 	// adjustment. The drawback here is that we can not control the music and
 	// sfx separately here. But the AdLib output has the same issue so it
@@ -65,6 +69,7 @@ void PcSpkDriver::close() {
 	_isOpen = false;
 
 	_mixer->stopHandle(_mixerSoundHandle);
+	setRegisterQueueEnabled(false);
 }
 
 void PcSpkDriver::send(uint32 d) {
@@ -91,6 +96,17 @@ void PcSpkDriver::generateSamples(int16 *buf, int len) {
 	_pcSpk.readBuffer(buf, len);
 }
 
+void PcSpkDriver::applyRegisterWrite(int reg, int value) {
+	if (reg == kPortTimer2)
+		_pcSpk.play(Audio::PCSpeaker::kWaveFormSquare, 1193180 / value, -1);
+	else if (reg == kPortSpeaker && !value)
+		_pcSpk.stop();
+}
+
+void PcSpkDriver::stopOutput() {
+	writeRegister(kPortSpeaker, 0);
+}
+
 void PcSpkDriver::onTimer() {
 	if (!_activeChannel)
 		return;
@@ -127,7 +143,7 @@ void PcSpkDriver::onTimer() {
 	if (_activeChannel->_tl) {
 		output((_activeChannel->_out.note << 7) + _activeChannel->_pitchBend + _activeChannel->_out.unk60 + _activeChannel->_out.unkE);
 	} else {
-		_pcSpk.stop();
+		stopOutput();
 		_lastActiveChannel = 0;
 		_lastActiveOut = 0;
 	}
@@ -144,7 +160,7 @@ void PcSpkDriver::updateNote() {
 	}
 
 	if (_activeChannel == 0 || _activeChannel->_tl == 0) {
-		_pcSpk.stop();
+		stopOutput();
 		_lastActiveChannel = 0;
 		_lastActiveOut = 0;
 	} else {
@@ -164,7 +180,7 @@ void PcSpkDriver::output(uint16 out) {
 	// This is not faithful to the original. Since our timings differ we would
 	// get distorted sound otherwise though.
 	if (_lastActiveChannel != _activeChannel || _lastActiveOut != out) {
-		_pcSpk.play(Audio::PCSpeaker::kWaveFormSquare, 1193180 / frequency, -1);
+		writeRegister(kPortTimer2, frequency);
 		_lastActiveChannel = _activeChannel;
 		_lastActiveOut = out;
 	}
@@ -313,7 +329,7 @@ void PcSpkDriver::MidiChannel_PcSpk::controlChange(byte control, byte value) {
 			if (_tl == 0) {
 				_owner->_lastActiveChannel = 0;
 				_owner->_lastActiveOut = 0;
-				_owner->_pcSpk.stop();
+				_owner->stopOutput();
 			} else {
 				_owner->output((_out.note << 7) + _pitchBend + _out.unk60 + _out.unkE);
 			}
@@ -46,14 +46,22 @@ public:
 protected:
 	void generateSamples(int16 *buf, int len);
 	void onTimer();
+	void applyRegisterWrite(int reg, int value);
 
 private:
 	Audio::PCSpeaker _pcSpk;
 	int _effectTimer;
 	uint8 _randBase;
 
+	// The emulated ports, the PIT channel 2 data port and the speaker gate
+	enum {
+		kPortTimer2 = 0x42,
+		kPortSpeaker = 0x61
+	};
+
 	void updateNote();
 	void output(uint16 out);
+	void stopOutput();
 
 	static uint8 getEffectModifier(uint16 level);
 	int16 getEffectModLevel(int16 level, int8 mod);
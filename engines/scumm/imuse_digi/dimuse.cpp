@@ -19,6 +19,7 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
  */
 
+#include "common/perfcounters.h"
 #include "common/system.h"
 #include "common/timer.h"
 
@@ -37,6 +38,10 @@
 
 namespace Scumm {
 
+// The performance counter of callbacks, for relating the feed block
+// allocations to them
+static int s_callbacksCounter = -1;
+
 void IMuseDigital::timer_handler(void *refCon) {
 	IMuseDigital *imuseDigital = (IMuseDigital *)refCon;
 	imuseDigital->callback();
@@ -50,6 +55,7 @@ IMuseDigital::IMuseDigital(ScummEngine_v7 *scumm, Audio::Mixer *mixer, int fps)
 	_pause = false;
 	_sound = new ImuseDigiSndMgr(_vm);
 	assert(_sound);
+	_feedPool = new ImuseDigiFeedPool();
 	_callbackFps = fps;
 	resetState();
 	for (int l = 0; l < MAX_DIGITAL_TRACKS + MAX_DIGITAL_FADETRACKS; l++) {
@@ -62,6 +68,9 @@ IMuseDigital::IMuseDigital(ScummEngine_v7 *scumm, Audio::Mixer *mixer, int fps)
 
 	_audioNames = NULL;
 	_numAudioNames = 0;
+
+	if (s_callbacksCounter < 0)
+		s_callbacksCounter = PerfMan.registerCounter("imuseCallbacks", Common::PerfCounterManager::kTypeCount);
 }
 
 IMuseDigital::~IMuseDigital() {
@@ -71,6 +80,8 @@ IMuseDigital::~IMuseDigital() {
 		delete _track[l];
 	}
 	delete _sound;
+	// The mixer might still play data of finished tracks
+	_feedPool->release();
 	free(_audioNames);
 }
 
@@ -91,6 +102,10 @@ static int32 makeMixerFlags(Track *track) {
 	return mixerFlags;
 }
 
+ImuseDigiFeedStream *IMuseDigital::makeFeedStream(Track *track, int freq) {
+	return new ImuseDigiFeedStream(_feedPool, freq, makeMixerFlags(track));
+}
+
 void IMuseDigital::resetState() {
 	_curMusicState = 0;
 	_curMusicSeq = 0;
@@ -198,7 +213,7 @@ void IMuseDigital::saveOrLoad(Serializer *ser) {
 			} else
 				error("IMuseDigital::saveOrLoad(): Can't handle %d bit samples", bits);
 
-			track->stream = Audio::makeQueuingAudioStream(freq, (track->mixerFlags & kFlagStereo) != 0);
+			track->stream = makeFeedStream(track, freq);
 
 			_mixer->playStream(track->getType(), &track->mixChanHandle, track->stream, -1, track->getVol(), track->getPan(),
 							DisposeAfterUse::YES, false, (track->mixerFlags & kFlagStereo) != 0);
@@ -210,6 +225,9 @@ void IMuseDigital::saveOrLoad(Serializer *ser) {
 void IMuseDigital::callback() {
 	Common::StackLock lock(_mutex, "IMuseDigital::callback()");
 
+	if (s_callbacksCounter >= 0)
+		Common::perfCount(s_callbacksCounter);
+
 	for (int l = 0; l < MAX_DIGITAL_TRACKS + MAX_DIGITAL_FADETRACKS; l++) {
 		Track *track = _track[l];
 		if (track->used) {
@@ -252,7 +270,7 @@ void IMuseDigital::callback() {
 
 			if (!track->souStreamUsed) {
 				assert(track->stream);
-				byte *tmpSndBufferPtr = NULL;
+				byte *sndBuffer = NULL;
 				int32 curFeedSize = 0;
 
 				if (track->curRegion == -1) {
@@ -284,21 +302,27 @@ void IMuseDigital::callback() {
 					continue;
 
 				do {
-					if (bits == 12) {
-						byte *tmpPtr = NULL;
+					// The mixer has not played the feeds queued so far yet
+					if (!track->stream->canQueueFeed())
+						break;
 
+					if (bits == 12) {
 						feedSize += track->dataMod12Bit;
 						int tmpFeedSize12Bits = (feedSize * 3) / 4;
 						int tmpLength12Bits = (tmpFeedSize12Bits / 3) * 4;
 						track->dataMod12Bit = feedSize - tmpLength12Bits;
 
-						int32 tmpOffset = (track->regionOffset * 3) / 4;
-						int tmpFeedSize = _sound->getDataFromRegion(track->soundDesc, track->curRegion, &tmpPtr, tmpOffset, tmpFeedSize12Bits);
-						curFeedSize = BundleCodecs::decode12BitsSample(tmpPtr, &tmpSndBufferPtr, tmpFeedSize);
+						// Read the packed samples behind the space for the
+						// first quarter of the output and unpack them in place
+						int packedPos = tmpLength12Bits / 4;
+						sndBuffer = track->stream->getFeedBuffer(packedPos + tmpFeedSize12Bits);
 
-						free(tmpPtr);
+						int32 tmpOffset = (track->regionOffset * 3) / 4;
+						int tmpFeedSize = _sound->getDataFromRegion(track->soundDesc, track->curRegion, sndBuffer + packedPos, tmpOffset, tmpFeedSize12Bits);
+						curFeedSize = BundleCodecs::decode12BitsSample(sndBuffer + packedPos, sndBuffer, tmpFeedSize);
 					} else if (bits == 16) {
-						curFeedSize = _sound->getDataFromRegion(track->soundDesc, track->curRegion, &tmpSndBufferPtr, track->regionOffset, feedSize);
+						sndBuffer = track->stream->getFeedBuffer(feedSize);
+						curFeedSize = _sound->getDataFromRegion(track->soundDesc, track->curRegion, sndBuffer, track->regionOffset, feedSize);
 						if (channels == 1) {
 							curFeedSize &= ~1;
 						}
@@ -306,15 +330,18 @@ void IMuseDigital::callback() {
 							curFeedSize &= ~3;
 						}
 					} else if (bits == 8) {
-						curFeedSize = _sound->getDataFromRegion(track->soundDesc, track->curRegion, &tmpSndBufferPtr, track->regionOffset, feedSize);
+						sndBuffer = track->stream->getFeedBuffer(feedSize);
+						curFeedSize = _sound->getDataFromRegion(track->soundDesc, track->curRegion, sndBuffer, track->regionOffset, feedSize);
 						if (_radioChatterSFX && track->soundId == 10000) {
 							if (curFeedSize > feedSize)
 								curFeedSize = feedSize;
-							byte *buf = (byte *)malloc(curFeedSize);
+							// Filtered in place, every sample is only written
+							// after the last read of it
+							byte *buf = sndBuffer;
 							int index = 0;
 							int count = curFeedSize - 4;
-							byte *ptr_1 = tmpSndBufferPtr;
-							byte *ptr_2 = tmpSndBufferPtr + 4;
+							byte *ptr_1 = sndBuffer;
+							byte *ptr_2 = sndBuffer + 4;
 							int value = ptr_1[0] - 0x80;
 							value += ptr_1[1] - 0x80;
 							value += ptr_1[2] - 0x80;
@@ -329,8 +356,6 @@ void IMuseDigital::callback() {
 							buf[curFeedSize - 2] = 0x80;
 							buf[curFeedSize - 3] = 0x80;
 							buf[curFeedSize - 4] = 0x80;
-							free(tmpSndBufferPtr);
-							tmpSndBufferPtr = buf;
 						}
 						if (channels == 2) {
 							curFeedSize &= ~1;
@@ -341,10 +366,9 @@ void IMuseDigital::callback() {
 						curFeedSize = feedSize;
 
 					if (_mixer->isReady()) {
-						track->stream->queueBuffer(tmpSndBufferPtr, curFeedSize, DisposeAfterUse::YES, makeMixerFlags(track));
+						track->stream->queueFeed(curFeedSize);
 						track->regionOffset += curFeedSize;
-					} else
-						free(tmpSndBufferPtr);
+					}
 
 					if (_sound->isEndOfRegion(track->soundDesc, track->curRegion)) {
 						switchToNextRegion(track);
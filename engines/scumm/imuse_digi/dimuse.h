@@ -29,6 +29,7 @@
 
 #include "scumm/imuse_digi/dimuse.h"
 #include "scumm/imuse_digi/dimuse_bndmgr.h"
+#include "scumm/imuse_digi/dimuse_feed.h"
 #include "scumm/imuse_digi/dimuse_sndmgr.h"
 #include "scumm/music.h"
 #include "scumm/sound.h"
@@ -72,6 +73,7 @@ private:
 	ScummEngine_v7 *_vm;
 	Audio::Mixer *_mixer;
 	ImuseDigiSndMgr *_sound;
+	ImuseDigiFeedPool *_feedPool;	// sample data buffers shared by all tracks
 
 	char *_audioNames;		// filenames of sound SFX used in FT
 	int32 _numAudioNames;	// number of above filenames
@@ -89,6 +91,7 @@ private:
 	static void timer_handler(void *refConf);
 	void callback();
 	void switchToNextRegion(Track *track);
+	ImuseDigiFeedStream *makeFeedStream(Track *track, int freq);
 	int allocSlot(int priority);
 	void startSound(int soundId, const char *soundName, int soundType, int volGroupId, Audio::AudioStream *input, int hookId, int volume, int priority, Track *otherTrack);
 	void selectVolumeGroup(int soundId, int volGroupId);
@@ -138,14 +138,50 @@ int BundleDirCache::matchFile(const char *filename) {
 	}
 }
 
-BundleMgr::BundleMgr(BundleDirCache *cache) {
+BundleBlockCache::BundleBlockCache() : _time(0) {
+	for (int i = 0; i < kNumBlocks; i++) {
+		_blocks[i].fileSlot = -1;
+		_blocks[i].lastUsed = 0;
+	}
+}
+
+BundleBlockCache::Block *BundleBlockCache::find(int fileSlot, int32 index, int32 block) {
+	for (int i = 0; i < kNumBlocks; i++) {
+		Block &b = _blocks[i];
+		if (b.fileSlot == fileSlot && b.index == index && b.block == block) {
+			b.lastUsed = ++_time;
+			return &b;
+		}
+	}
+
+	return NULL;
+}
+
+BundleBlockCache::Block *BundleBlockCache::replace(int fileSlot, int32 index, int32 block) {
+	Block *oldest = &_blocks[0];
+	for (int i = 1; i < kNumBlocks && oldest->fileSlot != -1; i++) {
+		if (_blocks[i].fileSlot == -1 || _blocks[i].lastUsed < oldest->lastUsed)
+			oldest = &_blocks[i];
+	}
+
+	oldest->fileSlot = fileSlot;
+	oldest->index = index;
+	oldest->block = block;
+	oldest->size = 0;
+	oldest->lastUsed = ++_time;
+	return oldest;
+}
+
+BundleMgr::BundleMgr(BundleDirCache *cache, BundleBlockCache *blockCache) {
 	_cache = cache;
+	_blockCache = blockCache;
 	_bundleTable = NULL;
 	_compTable = NULL;
 	_numFiles = 0;
 	_numCompItems = 0;
 	_curSampleId = -1;
 	_fileBundleId = -1;
+	_fileSlot = -1;
 	_file = new ScummFile();
 	_compInputBuff = NULL;
 }
@@ -183,17 +219,15 @@ bool BundleMgr::open(const char *filename, bool &compressed, bool errorFlag) {
 		return false;
 	}
 
-	int slot = _cache->matchFile(filename);
-	assert(slot != -1);
-	compressed = _cache->isSndDataExtComp(slot);
-	_numFiles = _cache->getNumFiles(slot);
+	_fileSlot = _cache->matchFile(filename);
+	assert(_fileSlot != -1);
+	compressed = _cache->isSndDataExtComp(_fileSlot);
+	_numFiles = _cache->getNumFiles(_fileSlot);
 	assert(_numFiles);
-	_bundleTable = _cache->getTable(slot);
-	_indexTable = _cache->getIndexTable(slot);
+	_bundleTable = _cache->getTable(_fileSlot);
+	_indexTable = _cache->getIndexTable(_fileSlot);
 	assert(_bundleTable);
 	_compTableLoaded = false;
-	_outputSize = 0;
-	_lastBlock = -1;
 
 	return true;
 }
@@ -205,9 +239,8 @@ void BundleMgr::close() {
 		_numFiles = 0;
 		_numCompItems = 0;
 		_compTableLoaded = false;
-		_lastBlock = -1;
-		_outputSize = 0;
 		_curSampleId = -1;
+		_fileSlot = -1;
 		free(_compTable);
 		_compTable = NULL;
 		free(_compInputBuff);
@@ -249,7 +282,36 @@ int32 BundleMgr::decompressSampleByCurIndex(int32 offset, int32 size, byte **com
 	return decompressSampleByIndex(_curSampleId, offset, size, compFinal, headerSize, headerOutside);
 }
 
+int32 BundleMgr::decompressSampleByCurIndex(int32 offset, int32 size, byte *buf, int headerSize, bool headerOutside) {
+	return decompressSampleByIndex(_curSampleId, offset, size, buf, headerSize, headerOutside);
+}
+
 int32 BundleMgr::decompressSampleByIndex(int32 index, int32 offset, int32 size, byte **compFinal, int headerSize, bool headerOutside) {
+	*compFinal = (byte *)malloc(size);
+	assert(*compFinal);
+	return decompressSampleByIndex(index, offset, size, *compFinal, headerSize, headerOutside);
+}
+
+BundleBlockCache::Block *BundleMgr::getBlock(int32 index, int32 block) {
+	BundleBlockCache::Block *cached = _blockCache->find(_fileSlot, index, block);
+	if (cached)
+		return cached;
+
+	cached = _blockCache->replace(_fileSlot, index, block);
+
+	// CMI hack: one more zero byte at the end of input buffer
+	_compInputBuff[_compTable[block].size] = 0;
+	_file->seek(_bundleTable[index].offset + _compTable[block].offset, SEEK_SET);
+	_file->read(_compInputBuff, _compTable[block].size);
+	cached->size = BundleCodecs::decompressCodec(_compTable[block].codec, _compInputBuff, cached->data, _compTable[block].size);
+	if (cached->size > BundleBlockCache::kBlockSize) {
+		error("_outputSize: %d", cached->size);
+	}
+
+	return cached;
+}
+
+int32 BundleMgr::decompressSampleByIndex(int32 index, int32 offset, int32 size, byte *buf, int headerSize, bool headerOutside) {
 	int32 i, finalSize, outputSize;
 	int skip, firstBlock, lastBlock;
 
@@ -278,27 +340,14 @@ int32 BundleMgr::decompressSampleByIndex(int32 index, int32 offset, int32 size,
 	if ((lastBlock >= _numCompItems) && (_numCompItems > 0))
 		lastBlock = _numCompItems - 1;
 
-	int32 blocksFinalSize = 0x2000 * (1 + lastBlock - firstBlock);
-	*compFinal = (byte *)malloc(blocksFinalSize);
-	assert(*compFinal);
 	finalSize = 0;
 
 	skip = (offset + headerSize) % 0x2000;
 
 	for (i = firstBlock; i <= lastBlock; i++) {
-		if (_lastBlock != i) {
-			// CMI hack: one more zero byte at the end of input buffer
-			_compInputBuff[_compTable[i].size] = 0;
-			_file->seek(_bundleTable[index].offset + _compTable[i].offset, SEEK_SET);
-			_file->read(_compInputBuff, _compTable[i].size);
-			_outputSize = BundleCodecs::decompressCodec(_compTable[i].codec, _compInputBuff, _compOutputBuff, _compTable[i].size);
-			if (_outputSize > 0x2000) {
-				error("_outputSize: %d", _outputSize);
-			}
-			_lastBlock = i;
-		}
+		BundleBlockCache::Block *block = getBlock(index, i);
 
-		outputSize = _outputSize;
+		outputSize = block->size;
 
 		if (headerOutside) {
 			outputSize -= skip;
@@ -313,9 +362,7 @@ int32 BundleMgr::decompressSampleByIndex(int32 index, int32 offset, int32 size,
 		if (outputSize > size)
 			outputSize = size;
 
-		assert(finalSize + outputSize <= blocksFinalSize);
-
-		memcpy(*compFinal + finalSize, _compOutputBuff + skip, outputSize);
+		memcpy(buf + finalSize, block->data + skip, outputSize);
 		finalSize += outputSize;
 
 		size -= outputSize;
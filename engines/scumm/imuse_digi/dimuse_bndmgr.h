@@ -63,6 +63,43 @@ public:
 	bool isSndDataExtComp(int slot);
 };
 
+/**
+ * An LRU cache of decompressed bundle blocks, shared by all BundleMgrs. The
+ * fade out copy of a music track reads the same blocks as the track itself,
+ * and jumping back within a sound no longer decompresses the blocks again.
+ */
+class BundleBlockCache {
+public:
+	enum {
+		kBlockSize = 0x2000,
+		kNumBlocks = 16
+	};
+
+	struct Block {
+		int fileSlot;		// slot of the bundle in the BundleDirCache, -1 if unused
+		int32 index;
+		int32 block;
+		int32 size;
+		uint32 lastUsed;
+		byte data[kBlockSize];
+	};
+
+	BundleBlockCache();
+
+	/** Returns a cached block, or NULL. */
+	Block *find(int fileSlot, int32 index, int32 block);
+
+	/**
+	 * Returns the least recently used block for decompressing the given block
+	 * into. The caller has to fill in the data and the size.
+	 */
+	Block *replace(int fileSlot, int32 index, int32 block);
+
+private:
+	Block _blocks[kNumBlocks];
+	uint32 _time;
+};
+
 class BundleMgr {
 
 private:
@@ -74,6 +111,7 @@ private:
 	};
 
 	BundleDirCache *_cache;
+	BundleBlockCache *_blockCache;
 	BundleDirCache::AudioTable *_bundleTable;
 	BundleDirCache::IndexNode *_indexTable;
 	CompTable *_compTable;
@@ -84,16 +122,15 @@ private:
 	BaseScummFile *_file;
 	bool _compTableLoaded;
 	int _fileBundleId;
-	byte _compOutputBuff[0x2000];
+	int _fileSlot;
 	byte *_compInputBuff;
-	int _outputSize;
-	int _lastBlock;
 
 	bool loadCompTable(int32 index);
+	BundleBlockCache::Block *getBlock(int32 index, int32 block);
 
 public:
 
-	BundleMgr(BundleDirCache *_cache);
+	BundleMgr(BundleDirCache *_cache, BundleBlockCache *blockCache);
 	~BundleMgr();
 
 	bool open(const char *filename, bool &compressed, bool errorFlag = false);
@@ -102,6 +139,13 @@ public:
 	int32 decompressSampleByName(const char *name, int32 offset, int32 size, byte **compFinal, bool headerOutside);
 	int32 decompressSampleByIndex(int32 index, int32 offset, int32 size, byte **compFinal, int header_size, bool headerOutside);
 	int32 decompressSampleByCurIndex(int32 offset, int32 size, byte **compFinal, int headerSize, bool headerOutside);
+
+	/**
+	 * Decompresses into the given buffer, which has to hold at least size
+	 * bytes, instead of allocating one.
+	 */
+	int32 decompressSampleByIndex(int32 index, int32 offset, int32 size, byte *buf, int headerSize, bool headerOutside);
+	int32 decompressSampleByCurIndex(int32 offset, int32 size, byte *buf, int headerSize, bool headerOutside);
 };
 
 } // End of namespace Scumm
@@ -31,10 +31,15 @@ namespace Scumm {
 namespace BundleCodecs {
 
 uint32 decode12BitsSample(const byte *src, byte **dst, uint32 size) {
+	*dst = (byte *)malloc((size / 3) * 4);
+	assert(*dst);
+	return decode12BitsSample(src, *dst, size);
+}
+
+uint32 decode12BitsSample(const byte *src, byte *dst, uint32 size) {
 	uint32 loop_size = size / 3;
 	uint32 s_size = loop_size * 4;
-	byte *ptr = *dst = (byte *)malloc(s_size);
-	assert(ptr);
+	byte *ptr = dst;
 
 	uint32 tmp;
 	while (loop_size--) {
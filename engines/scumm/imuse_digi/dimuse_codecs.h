@@ -29,6 +29,13 @@ namespace Scumm {
 namespace BundleCodecs {
 
 uint32 decode12BitsSample(const byte *src, byte **dst, uint32 size);
+
+/**
+ * Decodes into the given buffer instead of allocating one. The source may be
+ * stored at the end of that buffer, since the output never overtakes it.
+ */
+uint32 decode12BitsSample(const byte *src, byte *dst, uint32 size);
+
 int32 decompressCodec(int32 codec, byte *compInput, byte *compOutput, int32 inputSize);
 
 void initializeImcTables();
@@ -0,0 +1,194 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include "common/perfcounters.h"
+#include "common/endian.h"
+#include "common/textconsole.h"
+#include "common/util.h"
+
+#include "audio/decoders/raw.h"
+
+#include "scumm/imuse_digi/dimuse_feed.h"
+
+namespace Scumm {
+
+// The performance counter of allocated feed blocks, shared by all pools
+static int s_allocationsCounter = -1;
+
+ImuseDigiFeedPool::ImuseDigiFeedPool() : _freeBlocks(0), _refCount(1) {
+	if (s_allocationsCounter < 0)
+		s_allocationsCounter = PerfMan.registerCounter("imuseFeedAllocs", Common::PerfCounterManager::kTypeCount);
+}
+
+ImuseDigiFeedPool::~ImuseDigiFeedPool() {
+	while (_freeBlocks) {
+		Block *block = _freeBlocks;
+		_freeBlocks = block->next;
+		free(block->data);
+		delete block;
+	}
+}
+
+void ImuseDigiFeedPool::ref() {
+	Common::StackLock lock(_mutex);
+	_refCount++;
+}
+
+void ImuseDigiFeedPool::unref() {
+	_mutex.lock();
+	const bool last = (--_refCount == 0);
+	_mutex.unlock();
+
+	if (last)
+		delete this;
+}
+
+ImuseDigiFeedPool::Block *ImuseDigiFeedPool::getBlock(uint32 size) {
+	Common::StackLock lock(_mutex);
+
+	Block *block = _freeBlocks;
+	if (block && size <= kBlockSize) {
+		_freeBlocks = block->next;
+	} else {
+		// Feeds larger than a block get a block of their own, which is
+		// freed instead of pooled once it has been played
+		block = new Block;
+		block->size = MAX<uint32>(size, kBlockSize);
+		block->data = (byte *)malloc(block->size);
+		assert(block->data);
+
+		if (s_allocationsCounter >= 0)
+			Common::perfCount(s_allocationsCounter);
+	}
+
+	block->refCount = 1;
+	block->next = 0;
+	return block;
+}
+
+void ImuseDigiFeedPool::refBlock(Block *block) {
+	Common::StackLock lock(_mutex);
+	block->refCount++;
+}
+
+void ImuseDigiFeedPool::unrefBlock(Block *block) {
+	Common::StackLock lock(_mutex);
+	assert(block->refCount > 0);
+	if (--block->refCount)
+		return;
+
+	if (block->size == kBlockSize) {
+		block->next = _freeBlocks;
+		_freeBlocks = block;
+	} else {
+		free(block->data);
+		delete block;
+	}
+}
+
+template<bool is16Bit, bool isUnsigned, bool isLE>
+static void convertSamples(int16 *dst, const byte *src, int count) {
+	while (count--) {
+		const uint16 sample = is16Bit ? (isLE ? READ_LE_UINT16(src) : READ_BE_UINT16(src)) : (*src << 8);
+		*dst++ = (int16)(isUnsigned ? sample ^ 0x8000 : sample);
+		src += is16Bit ? 2 : 1;
+	}
+}
+
+ImuseDigiFeedStream::ImuseDigiFeedStream(ImuseDigiFeedPool *pool, int rate, byte flags)
+	: _pool(pool), _rate(rate), _stereo((flags & Audio::FLAG_STEREO) != 0), _sampleSize((flags & Audio::FLAG_16BITS) ? 2 : 1),
+	  _convert(0), _finished(false), _writeBlock(0), _writePos(0), _firstSlice(0), _numSlices(0), _readPos(0) {
+	_pool->ref();
+
+	const bool isUnsigned = (flags & Audio::FLAG_UNSIGNED) != 0;
+	if (!(flags & Audio::FLAG_16BITS))
+		_convert = isUnsigned ? convertSamples<false, true, false> : convertSamples<false, false, false>;
+	else if (flags & Audio::FLAG_LITTLE_ENDIAN)
+		_convert = isUnsigned ? convertSamples<true, true, true> : convertSamples<true, false, true>;
+	else
+		_convert = isUnsigned ? convertSamples<true, true, false> : convertSamples<true, false, false>;
+}
+
+ImuseDigiFeedStream::~ImuseDigiFeedStream() {
+	for (uint i = 0; i < _numSlices; i++)
+		_pool->unrefBlock(_slices[(_firstSlice + i) % kMaxSlices].block);
+	if (_writeBlock)
+		_pool->unrefBlock(_writeBlock);
+	_pool->unref();
+}
+
+byte *ImuseDigiFeedStream::getFeedBuffer(uint32 size) {
+	if (!_writeBlock || _writePos + size > _writeBlock->size) {
+		if (_writeBlock)
+			_pool->unrefBlock(_writeBlock);
+		_writeBlock = _pool->getBlock(size);
+		_writePos = 0;
+	}
+
+	return _writeBlock->data + _writePos;
+}
+
+void ImuseDigiFeedStream::queueFeed(uint32 size) {
+	assert(_writeBlock && _writePos + size <= _writeBlock->size);
+	assert(!_finished && canQueueFeed());
+
+	if (!size)
+		return;
+
+	_pool->refBlock(_writeBlock);
+
+	Common::StackLock lock(_mutex);
+	Slice &slice = _slices[(_firstSlice + _numSlices) % kMaxSlices];
+	slice.block = _writeBlock;
+	slice.data = _writeBlock->data + _writePos;
+	slice.size = size;
+	_numSlices++;
+
+	// Keep the following feeds aligned, the compressed streams decode
+	// directly into them as 16 bit samples
+	_writePos = MIN<uint32>((_writePos + size + 3) & ~3, _writeBlock->size);
+}
+
+int ImuseDigiFeedStream::readBuffer(int16 *buffer, const int numSamples) {
+	Common::StackLock lock(_mutex);
+
+	int samples = 0;
+	while (samples < numSamples && _numSlices) {
+		Slice &slice = _slices[_firstSlice];
+		const int count = MIN<int>(numSamples - samples, (slice.size - _readPos) / _sampleSize);
+
+		_convert(buffer + samples, slice.data + _readPos, count);
+		samples += count;
+		_readPos += count * _sampleSize;
+
+		// Drop the slice once it is played, or if only a partial sample is left
+		if (slice.size - _readPos < _sampleSize) {
+			_pool->unrefBlock(slice.block);
+			_firstSlice = (_firstSlice + 1) % kMaxSlices;
+			_numSlices--;
+			_readPos = 0;
+		}
+	}
+
+	return samples;
+}
+
+} // End of namespace Scumm
@@ -0,0 +1,149 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef SCUMM_IMUSE_DIGI_FEED_H
+#define SCUMM_IMUSE_DIGI_FEED_H
+
+#include "common/scummsys.h"
+#include "common/mutex.h"
+
+#include "audio/audiostream.h"
+
+namespace Scumm {
+
+/**
+ * A pool of fixed size blocks for the sample data fed to the mixer, shared
+ * by all tracks. Blocks are reference counted: every slice of a block which
+ * is queued in an ImuseDigiFeedStream holds a reference, and the block goes
+ * back into the pool once the mixer has played all of them.
+ *
+ * The pool itself is kept alive by its owner and by every stream, so the
+ * mixer may still play data after iMUSE is gone.
+ */
+class ImuseDigiFeedPool {
+public:
+	struct Block {
+		byte *data;
+		uint32 size;
+		int refCount;
+		Block *next;
+	};
+
+	enum {
+		kBlockSize = 0x10000
+	};
+
+	ImuseDigiFeedPool();
+
+	/** Drops the reference of the owner, to be used instead of delete. */
+	void release() { unref(); }
+
+	/**
+	 * Returns a block with room for at least size bytes, which is referenced
+	 * once. A new block is only allocated if the pool is empty.
+	 */
+	Block *getBlock(uint32 size);
+
+	void refBlock(Block *block);
+	void unrefBlock(Block *block);
+
+private:
+	friend class ImuseDigiFeedStream;
+
+	~ImuseDigiFeedPool();
+
+	void ref();
+	void unref();
+
+	Common::Mutex _mutex;
+	Block *_freeBlocks;
+	int _refCount;
+};
+
+/**
+ * The audio stream of a track. iMUSE writes the data of each feed directly
+ * into a block of the pool and queues it as a slice, so nothing is copied or
+ * allocated per feed while the pool has free blocks.
+ */
+class ImuseDigiFeedStream : public Audio::AudioStream {
+public:
+	/**
+	 * @param flags	a combination of the Audio::RawFlags describing the data
+	 */
+	ImuseDigiFeedStream(ImuseDigiFeedPool *pool, int rate, byte flags);
+	~ImuseDigiFeedStream();
+
+	/**
+	 * Returns a buffer for the next feed of at least size bytes, which stays
+	 * valid until queueFeed() is called.
+	 */
+	byte *getFeedBuffer(uint32 size);
+
+	/** Queues the first size bytes of the buffer returned by getFeedBuffer(). */
+	void queueFeed(uint32 size);
+
+	/** Returns whether another feed can be queued. */
+	bool canQueueFeed() const { return _numSlices < kMaxSlices; }
+
+	/** Marks the stream as finished, it ends once all feeds are played. */
+	void finish() { _finished = true; }
+
+	// AudioStream API
+	int readBuffer(int16 *buffer, const int numSamples);
+	bool isStereo() const { return _stereo; }
+	int getRate() const { return _rate; }
+	bool endOfData() const { return _numSlices == 0; }
+	bool endOfStream() const { return _finished && _numSlices == 0; }
+
+private:
+	enum {
+		kMaxSlices = 32
+	};
+
+	struct Slice {
+		ImuseDigiFeedPool::Block *block;
+		const byte *data;
+		uint32 size;
+	};
+
+	typedef void (*ConvertProc)(int16 *dst, const byte *src, int count);
+
+	ImuseDigiFeedPool *_pool;
+	const int _rate;
+	const bool _stereo;
+	const uint _sampleSize;
+	ConvertProc _convert;
+	bool _finished;
+
+	// The block the next feed is written to, and the write position in it
+	ImuseDigiFeedPool::Block *_writeBlock;
+	uint32 _writePos;
+
+	Common::Mutex _mutex;
+	Slice _slices[kMaxSlices];
+	uint _firstSlice;
+	volatile uint _numSlices;
+	uint32 _readPos;
+};
+
+} // End of namespace Scumm
+
+#endif
@@ -46,6 +46,7 @@ ImuseDigiSndMgr::ImuseDigiSndMgr(ScummEngine *scumm) {
 	_disk = 0;
 	_cacheBundleDir = new BundleDirCache();
 	assert(_cacheBundleDir);
+	_cacheBundleBlocks = new BundleBlockCache();
 	BundleCodecs::initializeImcTables();
 }
 
@@ -55,6 +56,7 @@ ImuseDigiSndMgr::~ImuseDigiSndMgr() {
 	}
 
 	delete _cacheBundleDir;
+	delete _cacheBundleBlocks;
 	BundleCodecs::releaseImcTables();
 }
 
@@ -320,7 +322,7 @@ ImuseDigiSndMgr::SoundDesc *ImuseDigiSndMgr::allocSlot() {
 bool ImuseDigiSndMgr::openMusicBundle(SoundDesc *sound, int &disk) {
 	bool result = false;
 
-	sound->bundle = new BundleMgr(_cacheBundleDir);
+	sound->bundle = new BundleMgr(_cacheBundleDir, _cacheBundleBlocks);
 	assert(sound->bundle);
 	if (_vm->_game.id == GID_CMI) {
 		if (_vm->_game.features & GF_DEMO) {
@@ -355,7 +357,7 @@ bool ImuseDigiSndMgr::openMusicBundle(SoundDesc *sound, int &disk) {
 bool ImuseDigiSndMgr::openVoiceBundle(SoundDesc *sound, int &disk) {
 	bool result = false;
 
-	sound->bundle = new BundleMgr(_cacheBundleDir);
+	sound->bundle = new BundleMgr(_cacheBundleDir, _cacheBundleBlocks);
 	assert(sound->bundle);
 	if (_vm->_game.id == GID_CMI) {
 		if (_vm->_game.features & GF_DEMO) {
@@ -632,7 +634,7 @@ int ImuseDigiSndMgr::getJumpFade(SoundDesc *soundDesc, int number) {
 	return soundDesc->jump[number].fadeDelay;
 }
 
-int32 ImuseDigiSndMgr::getDataFromRegion(SoundDesc *soundDesc, int region, byte **buf, int32 offset, int32 size) {
+int32 ImuseDigiSndMgr::getDataFromRegion(SoundDesc *soundDesc, int region, byte *buf, int32 offset, int32 size) {
 	debug(6, "getDataFromRegion() region:%d, offset:%d, size:%d, numRegions:%d", region, offset, size, soundDesc->numRegions);
 	assert(checkForProperHandle(soundDesc));
 	assert(buf && offset >= 0 && size >= 0);
@@ -644,8 +646,11 @@ int32 ImuseDigiSndMgr::getDataFromRegion(SoundDesc *soundDesc, int region, byte
 	int32 start = region_offset - offset_data;
 
 	if (offset + size + offset_data > region_length) {
-		size = region_length - offset;
-		soundDesc->endFlag = true;
+		// Never more than requested, the buffer only has room for that. The
+		// region only ends once this reaches its last byte, else the rest is
+		// read by the next call.
+		size = MIN(size, region_length - offset);
+		soundDesc->endFlag = (offset + size >= region_length);
 	} else {
 		soundDesc->endFlag = false;
 	}
@@ -655,12 +660,8 @@ int32 ImuseDigiSndMgr::getDataFromRegion(SoundDesc *soundDesc, int region, byte
 	if ((soundDesc->bundle) && (!soundDesc->compressed)) {
 		size = soundDesc->bundle->decompressSampleByCurIndex(start + offset, size, buf, header_size, header_outside);
 	} else if (soundDesc->resPtr) {
-		*buf = (byte *)malloc(size);
-		assert(*buf);
-		memcpy(*buf, soundDesc->resPtr + start + offset + header_size, size);
+		memcpy(buf, soundDesc->resPtr + start + offset + header_size, size);
 	} else if ((soundDesc->bundle) && (soundDesc->compressed)) {
-		*buf = (byte *)malloc(size);
-		assert(*buf);
 		char fileName[24];
 		int offsetMs = (((offset * 8 * 10) / soundDesc->bits) / (soundDesc->channels * soundDesc->freq)) * 100;
 		sprintf(fileName, "%s_reg%03d", soundDesc->name, region);
@@ -719,7 +720,7 @@ int32 ImuseDigiSndMgr::getDataFromRegion(SoundDesc *soundDesc, int region, byte
 			}
 			strcpy(soundDesc->lastFileName, fileName);
 		}
-		size = soundDesc->compressedStream->readBuffer((int16 *)*buf, size / 2) * 2;
+		size = soundDesc->compressedStream->readBuffer((int16 *)buf, size / 2) * 2;
 		if (soundDesc->compressedStream->endOfData() || soundDesc->endFlag) {
 			delete soundDesc->compressedStream;
 			soundDesc->compressedStream = NULL;
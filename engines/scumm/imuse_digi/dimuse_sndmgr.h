@@ -115,6 +115,7 @@ private:
 	ScummEngine *_vm;
 	byte _disk;
 	BundleDirCache *_cacheBundleDir;
+	BundleBlockCache *_cacheBundleBlocks;
 
 	bool openMusicBundle(SoundDesc *sound, int &disk);
 	bool openVoiceBundle(SoundDesc *sound, int &disk);
@@ -145,7 +146,8 @@ public:
 	int getJumpFade(SoundDesc *soundDesc, int number);
 	void getSyncSizeAndPtrById(SoundDesc *soundDesc, int number, int32 &sync_size, byte **sync_ptr);
 
-	int32 getDataFromRegion(SoundDesc *soundDesc, int region, byte **buf, int32 offset, int32 size);
+	/** Reads up to size bytes of the region into buf, returning the number read. */
+	int32 getDataFromRegion(SoundDesc *soundDesc, int region, byte *buf, int32 offset, int32 size);
 };
 
 } // End of namespace Scumm
@@ -84,6 +84,7 @@ MODULE_OBJS += \
 	imuse_digi/dimuse.o \
 	imuse_digi/dimuse_bndmgr.o \
 	imuse_digi/dimuse_codecs.o \
+	imuse_digi/dimuse_feed.o \
 	imuse_digi/dimuse_music.o \
 	imuse_digi/dimuse_sndmgr.o \
 	imuse_digi/dimuse_script.o \
@@ -844,16 +844,21 @@ ResourceManager::Resource::Resource() {
 	_status = 0;
 	_roomno = 0;
 	_roomoffs = 0;
+	_cache = 0;
 }
 
 ResourceManager::Resource::~Resource() {
 	delete[] _address;
 	_address = 0;
+	delete _cache;
+	_cache = 0;
 }
 
 void ResourceManager::Resource::nuke() {
 	delete[] _address;
 	_address = 0;
+	delete _cache;
+	_cache = 0;
 	_size = 0;
 	_flags = 0;
 	_status &= ~RS_MODIFIED;
@@ -988,6 +993,19 @@ bool ScummEngine::isResourceInUse(ResType type, ResId idx) const {
 	}
 }
 
+ResourceCache *ResourceManager::getResourceCache(ResType type, ResId idx) const {
+	if (!validateResource("getResourceCache", type, idx))
+		return NULL;
+	return _types[type][idx]._cache;
+}
+
+void ResourceManager::setResourceCache(ResType type, ResId idx, ResourceCache *cache) {
+	if (!validateResource("setResourceCache", type, idx))
+		return;
+	delete _types[type][idx]._cache;
+	_types[type][idx]._cache = cache;
+}
+
 void ResourceManager::setModified(ResType type, ResId idx) {
 	if (!validateResource("Modified", type, idx))
 		return;
@@ -68,6 +68,16 @@ enum ResTypeMode {
 	kSoundResTypeMode = 2		///< Resource comes from data files, but may change
 };
 
+/**
+ * Base class for data derived from a resource, e.g. lookup tables built
+ * while decoding it. It is attached to the resource it was built from and
+ * deleted together with it, so it can never outlive the resource data.
+ */
+class ResourceCache {
+public:
+	virtual ~ResourceCache() {}
+};
+
 /**
  * The 'resource manager' class. Currently doesn't really deserve to be called
  * a 'class', at least until somebody gets around to OOfying this more.
@@ -125,6 +135,11 @@ public:
 		 */
 		uint32 _roomoffs;
 
+		/**
+		 * Optional data derived from this resource, owned by the resource.
+		 */
+		ResourceCache *_cache;
+
 	public:
 		Resource();
 		~Resource();
@@ -192,6 +207,14 @@ public:
 
 	bool isResourceLoaded(ResType type, ResId idx) const;
 
+	/**
+	 * Get or set the data derived from the specified resource. Setting it
+	 * transfers ownership to the resource manager, which deletes it once
+	 * the resource is nuked.
+	 */
+	ResourceCache *getResourceCache(ResType type, ResId idx) const;
+	void setResourceCache(ResType type, ResId idx, ResourceCache *cache);
+
 	void lock(ResType type, ResId idx);
 	void unlock(ResType type, ResId idx);
 	bool isLocked(ResType type, ResId idx) const;
@@ -23,6 +23,7 @@
 #include "common/config-manager.h"
 #include "common/util.h"
 #include "common/system.h"
+#include "common/trace.h"
 
 #include "scumm/actor.h"
 #include "scumm/object.h"
@@ -469,11 +470,12 @@ void ScummEngine::executeScript() {
 		_opcode = fetchScriptByte();
 		if (_game.version > 2) // V0-V2 games didn't use the didexec flag
 			vm.slot[_currentScript].didexec = true;
-		debugC(DEBUG_OPCODES, "Script %d, offset 0x%x: [%X] %s()",
-				vm.slot[_currentScript].number,
-				(uint)(_scriptPointer - _scriptOrgPointer),
-				_opcode,
-				getOpcodeDesc(_opcode));
+		if (debugChannelSet(-1, DEBUG_OPCODES))
+			debugC(DEBUG_OPCODES, "Script %d, offset 0x%x: [%X] %s()",
+					vm.slot[_currentScript].number,
+					(uint)(_scriptPointer - _scriptOrgPointer),
+					_opcode,
+					getOpcodeDesc(_opcode));
 		if (_hexdumpScripts == true) {
 			for (c = -1; c < 15; c++) {
 				debugN(" %02x", *(_scriptPointer + c));
@@ -532,7 +534,8 @@ int ScummEngine::fetchScriptDWordSigned() {
 int ScummEngine::readVar(uint var) {
 	int a;
 
-	debugC(DEBUG_VARS, "readvar(%d)", var);
+	if (debugChannelSet(-1, DEBUG_VARS))
+		debugC(DEBUG_VARS, "readvar(%d)", var);
 
 	if ((var & 0x2000) && (_game.version <= 5)) {
 		a = fetchScriptWord();
@@ -613,7 +616,8 @@ int ScummEngine::readVar(uint var) {
 }
 
 void ScummEngine::writeVar(uint var, int value) {
-	debugC(DEBUG_VARS, "writeVar(%d, %d)", var, value);
+	if (debugChannelSet(-1, DEBUG_VARS))
+		debugC(DEBUG_VARS, "writeVar(%d, %d)", var, value);
 
 	if (!(var & 0xF000)) {
 		assertRange(0, var, _numVariables - 1, "variable (writing)");
@@ -884,6 +888,8 @@ void ScummEngine::unfreezeScripts() {
 
 
 void ScummEngine::runAllScripts() {
+	TRACE_SCOPE("scumm", "runAllScripts");
+
 	int i;
 
 	for (i = 0; i < NUM_SCRIPT_SLOT; i++)
@@ -261,7 +261,8 @@ int ScummEngine_v8::fetchScriptWordSigned() {
 }
 
 int ScummEngine_v8::readVar(uint var) {
-	debugC(DEBUG_VARS, "readvar(%d)", var);
+	if (debugChannelSet(-1, DEBUG_VARS))
+		debugC(DEBUG_VARS, "readvar(%d)", var);
 
 	if (!(var & 0xF0000000)) {
 		assertRange(0, var, _numVariables - 1, "variable");
@@ -285,7 +286,8 @@ int ScummEngine_v8::readVar(uint var) {
 }
 
 void ScummEngine_v8::writeVar(uint var, int value) {
-	debugC(DEBUG_VARS, "writeVar(%d, %d)", var, value);
+	if (debugChannelSet(-1, DEBUG_VARS))
+		debugC(DEBUG_VARS, "writeVar(%d, %d)", var, value);
 
 	if (!(var & 0xF0000000)) {
 		assertRange(0, var, _numVariables - 1, "variable (writing)");
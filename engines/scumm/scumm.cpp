@@ -25,6 +25,7 @@
 #include "common/md5.h"
 #include "common/events.h"
 #include "common/system.h"
+#include "common/trace.h"
 #include "common/translation.h"
 
 #include "engines/util.h"
@@ -2058,6 +2059,8 @@ void ScummEngine_v0::scummLoop(int delta) {
 }
 
 void ScummEngine::scummLoop(int delta) {
+	TRACE_SCOPE("scumm", "scummLoop");
+
 	if (_game.version >= 3) {
 		VAR(VAR_TMR_1) += delta;
 		VAR(VAR_TMR_2) += delta;
@@ -2367,6 +2370,8 @@ void ScummEngine_v8::scummLoop_handleSaveLoad() {
 #endif
 
 void ScummEngine::scummLoop_handleDrawing() {
+	TRACE_SCOPE("scumm", "drawing");
+
 	if (camera._cur != camera._last || _bgNeedsRedraw || _fullRedraw) {
 		redrawBGAreas();
 	}
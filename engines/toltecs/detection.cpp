@@ -197,6 +197,7 @@ public:
 	virtual int getMaximumSaveSlot() const;
 	void removeSaveState(const char *target, int slot) const;
 	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot) const;
+	Common::String getSavegameFile(const char *target, int slot) const;
 };
 
 bool ToltecsMetaEngine::hasFeature(MetaEngineFeature f) const {
@@ -288,6 +289,10 @@ void ToltecsMetaEngine::removeSaveState(const char *target, int slot) const {
 	}
 }
 
+Common::String ToltecsMetaEngine::getSavegameFile(const char *target, int slot) const {
+	return Toltecs::ToltecsEngine::getSavegameFilename(target, slot);
+}
+
 SaveStateDescriptor ToltecsMetaEngine::querySaveMetaInfos(const char *target, int slot) const {
 	Common::String filename = Toltecs::ToltecsEngine::getSavegameFilename(target, slot);
 	Common::InSaveFile *in = g_system->getSavefileManager()->openForLoading(filename.c_str());
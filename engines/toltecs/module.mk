@@ -5,7 +5,6 @@ MODULE_OBJS = \
 	console.o \
 	detection.o \
 	menu.o \
-	microtiles.o \
 	movie.o \
 	music.o \
 	palette.o \
@@ -41,13 +41,13 @@ Common::Rect makeRect(int16 x, int16 y, int16 width, int16 height) {
 RenderQueue::RenderQueue(ToltecsEngine *vm) : _vm(vm) {
 	_currQueue = new RenderQueueArray();
 	_prevQueue = new RenderQueueArray();
-	_updateUta = new MicroTileArray(640, 400);
+	_dirtyRegion = new Graphics::DirtyRegion(640, 400);
 }
 
 RenderQueue::~RenderQueue() {
 	delete _currQueue;
 	delete _prevQueue;
-	delete _updateUta;
+	delete _dirtyRegion;
 }
 
 void RenderQueue::addSprite(SpriteDrawItem &sprite) {
@@ -115,7 +115,7 @@ void RenderQueue::update() {
 
 	bool doFullRefresh = _vm->_screen->_fullRefresh;
 
-	_updateUta->clear();
+	_dirtyRegion->clear();
 
 	if (!doFullRefresh) {
 
@@ -276,35 +276,41 @@ void RenderQueue::invalidateItemsByRect(const Common::Rect &rect, const RenderQu
 }
 
 void RenderQueue::addDirtyRect(const Common::Rect &rect) {
-	_updateUta->addRect(rect);
+	_dirtyRegion->addRect(rect);
 }
 
 void RenderQueue::restoreDirtyBackground() {
-	int n_rects = 0;
-	Common::Rect *rects = _updateUta->getRectangles(&n_rects, 0, 0, 639, _vm->_cameraHeight - 1);
-	for (int i = 0; i < n_rects; i++) {
-		byte *destp = _vm->_screen->_frontScreen + rects[i].left + rects[i].top * 640;
-		byte *srcp = _vm->_screen->_backScreen + (_vm->_cameraX + rects[i].left) + (_vm->_cameraY + rects[i].top) * _vm->_sceneWidth;
-		int16 w = rects[i].width();
-		int16 h = rects[i].height();
+	const Common::Rect cameraRect(640, _vm->_cameraHeight);
+	const Common::Array<Common::Rect> &rects = _dirtyRegion->getRects();
+	for (uint i = 0; i < rects.size(); i++) {
+		Common::Rect rect(rects[i]);
+		rect.clip(cameraRect);
+		if (rect.isEmpty())
+			continue;
+		byte *destp = _vm->_screen->_frontScreen + rect.left + rect.top * 640;
+		byte *srcp = _vm->_screen->_backScreen + (_vm->_cameraX + rect.left) + (_vm->_cameraY + rect.top) * _vm->_sceneWidth;
+		int16 w = rect.width();
+		int16 h = rect.height();
 		while (h--) {
 			memcpy(destp, srcp, w);
 			destp += 640;
 			srcp += _vm->_sceneWidth;
 		}
-		invalidateItemsByRect(rects[i], NULL);
+		invalidateItemsByRect(rect, NULL);
 	}
-	delete[] rects;
 }
 
 void RenderQueue::updateDirtyRects() {
-	int n_rects = 0;
-	Common::Rect *rects = _updateUta->getRectangles(&n_rects, 0, 0, 639, _vm->_cameraHeight - 1);
-	for (int i = 0; i < n_rects; i++) {
-		_vm->_system->copyRectToScreen(_vm->_screen->_frontScreen + rects[i].left + rects[i].top * 640,
-			640, rects[i].left, rects[i].top, rects[i].width(), rects[i].height());
+	const Common::Rect cameraRect(640, _vm->_cameraHeight);
+	const Common::Array<Common::Rect> &rects = _dirtyRegion->getRects();
+	for (uint i = 0; i < rects.size(); i++) {
+		Common::Rect rect(rects[i]);
+		rect.clip(cameraRect);
+		if (rect.isEmpty())
+			continue;
+		_vm->_system->copyRectToScreen(_vm->_screen->_frontScreen + rect.left + rect.top * 640,
+			640, rect.left, rect.top, rect.width(), rect.height());
 	}
-	delete[] rects;
 }
 
 
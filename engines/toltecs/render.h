@@ -24,11 +24,11 @@
 #ifndef TOLTECS_RENDER_H
 #define TOLTECS_RENDER_H
 
+#include "graphics/dirtyregion.h"
 #include "graphics/surface.h"
 
 #include "toltecs/segmap.h"
 #include "toltecs/screen.h"
-#include "toltecs/microtiles.h"
 
 namespace Toltecs {
 
@@ -81,7 +81,7 @@ protected:
 
 	ToltecsEngine *_vm;
 	RenderQueueArray *_currQueue, *_prevQueue;
-	MicroTileArray *_updateUta;
+	Graphics::DirtyRegion *_dirtyRegion;
 
 	bool rectIntersectsItem(const Common::Rect &rect);
     RenderQueueItem *findItemInQueue(RenderQueueArray *queue, const RenderQueueItem &item);
@@ -50,7 +50,6 @@
 #include "toltecs/screen.h"
 #include "toltecs/segmap.h"
 #include "toltecs/sound.h"
-#include "toltecs/microtiles.h"
 
 namespace Toltecs {
 
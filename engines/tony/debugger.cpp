@@ -31,6 +31,7 @@ Debugger::Debugger() : GUI::Debugger() {
 	DCmd_Register("continue",		WRAP_METHOD(Debugger, Cmd_Exit));
 	DCmd_Register("scene",			WRAP_METHOD(Debugger, Cmd_Scene));
 	DCmd_Register("dirty_rects",	WRAP_METHOD(Debugger, Cmd_DirtyRects));
+	DCmd_Register("frame_time",		WRAP_METHOD(Debugger, Cmd_FrameTime));
 }
 
 static int strToInt(const char *s) {
@@ -126,4 +127,29 @@ bool Debugger::Cmd_DirtyRects(int argc, const char **argv) {
 	}
 }
 
+/**
+ * Shows the time spent on game frames, optionally resetting the statistics
+ */
+bool Debugger::Cmd_FrameTime(int argc, const char **argv) {
+	if (argc > 2 || (argc == 2 && strcmp(argv[1], "reset") != 0)) {
+		DebugPrintf("Usage: %s [reset]\n", argv[0]);
+		return true;
+	}
+
+	if (argc == 2) {
+		g_vm->_frameTimeLast = 0;
+		g_vm->_frameTimeMax = 0;
+		g_vm->_frameTimeTotal = 0;
+		g_vm->_frameCount = 0;
+		DebugPrintf("Frame time statistics reset\n");
+		return true;
+	}
+
+	DebugPrintf("Frames: %u\n", g_vm->_frameCount);
+	DebugPrintf("Last frame: %u ms\n", g_vm->_frameTimeLast);
+	DebugPrintf("Average frame: %u ms\n", g_vm->_frameCount ? g_vm->_frameTimeTotal / g_vm->_frameCount : 0);
+	DebugPrintf("Slowest frame: %u ms\n", g_vm->_frameTimeMax);
+	return true;
+}
+
 } // End of namespace Tony
@@ -249,7 +249,6 @@ RMGfxWoodyBuffer::RMGfxWoodyBuffer(int dimx, int dimy)
 \****************************************************************************/
 
 RMGfxTargetBuffer::RMGfxTargetBuffer() {
-	_otlist = NULL;
 	_otSize = 0;
 	_trackDirtyRects = false;
 }
@@ -261,21 +260,104 @@ RMGfxTargetBuffer::~RMGfxTargetBuffer() {
 void RMGfxTargetBuffer::clearOT() {
 	OTList *cur, *n;
 
-	cur = _otlist;
+	for (uint i = 0; i < _otBuckets.size(); ++i) {
+		cur = _otBuckets[i]->_head;
 
-	while (cur != NULL) {
-		cur->_prim->_task->unregister();
-		delete cur->_prim;
-		n = cur->_next;
-		delete cur;
-		cur = n;
+		while (cur != NULL) {
+			cur->_prim->_task->unregister();
+			delete cur->_prim;
+			n = cur->_next;
+			_otListPool.deleteChunk(cur);
+			cur = n;
+		}
+
+		_otBucketPool.deleteChunk(_otBuckets[i]);
+	}
+
+	_otBuckets.clear();
+	_otSize = 0;
+}
+
+/**
+ * Returns the bucket for the given priority, creating it if necessary
+ */
+RMGfxTargetBuffer::OTBucket *RMGfxTargetBuffer::findBucket(int nPrior) {
+	// Binary search for the first bucket with a priority not less than nPrior
+	uint lo = 0, hi = _otBuckets.size();
+	while (lo < hi) {
+		uint mid = (lo + hi) / 2;
+		if (_otBuckets[mid]->_prior < nPrior)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	if (lo < _otBuckets.size() && _otBuckets[lo]->_prior == nPrior)
+		return _otBuckets[lo];
+
+	OTBucket *bucket = new (_otBucketPool) OTBucket(nPrior);
+	_otBuckets.insert_at(lo, bucket);
+	return bucket;
+}
+
+/**
+ * Returns the first bucket with a priority higher than the given one, if any
+ */
+RMGfxTargetBuffer::OTBucket *RMGfxTargetBuffer::nextBucket(int nPrior) {
+	uint lo = 0, hi = _otBuckets.size();
+	while (lo < hi) {
+		uint mid = (lo + hi) / 2;
+		if (_otBuckets[mid]->_prior <= nPrior)
+			lo = mid + 1;
+		else
+			hi = mid;
 	}
 
-	_otlist = NULL;
+	return (lo < _otBuckets.size()) ? _otBuckets[lo] : NULL;
+}
+
+/**
+ * Unlinks a node from the bucket with the given priority. Buckets which
+ * become empty are released right away, so the first bucket in the table
+ * always holds the lowest priority primitive.
+ */
+void RMGfxTargetBuffer::removeFromBucket(int nPrior, OTList *prev, OTList *node) {
+	OTBucket *bucket = findBucket(nPrior);
+
+	// The hint may be stale in case primitives were added while the
+	// draw process was sleeping
+	if (prev == NULL || prev->_next != node) {
+		prev = NULL;
+		if (bucket->_head != node) {
+			prev = bucket->_head;
+			while (prev->_next != node)
+				prev = prev->_next;
+		}
+	}
+
+	if (prev == NULL)
+		bucket->_head = node->_next;
+	else
+		prev->_next = node->_next;
+
+	_otListPool.deleteChunk(node);
+	_otSize--;
+
+	if (bucket->_head == NULL) {
+		for (uint i = 0; i < _otBuckets.size(); ++i) {
+			if (_otBuckets[i] == bucket) {
+				_otBuckets.remove_at(i);
+				break;
+			}
+		}
+		_otBucketPool.deleteChunk(bucket);
+	}
 }
 
 void RMGfxTargetBuffer::drawOT(CORO_PARAM) {
 	CORO_BEGIN_CONTEXT;
+	OTBucket *bucket;
+	int prior;
 	OTList *cur;
 	OTList *prev;
 	OTList *next;
@@ -285,39 +367,41 @@ void RMGfxTargetBuffer::drawOT(CORO_PARAM) {
 
 	CORO_BEGIN_CODE(_ctx);
 
-	_ctx->prev = NULL;
-	_ctx->cur = _otlist;
-
-	while (_ctx->cur != NULL) {
-		// Call the task Draw method, passing it a copy of the original
-		_ctx->myprim = _ctx->cur->_prim->duplicate();
-		CORO_INVOKE_2(_ctx->cur->_prim->_task->draw, *this, _ctx->myprim);
-		delete _ctx->myprim;
-
-		// Check if it's time to remove the task from the OT list
-		CORO_INVOKE_1(_ctx->cur->_prim->_task->removeThis, _ctx->result);
-		if (_ctx->result) {
-			// De-register the task
-			_ctx->cur->_prim->_task->unregister();
-
-			// Delete task, freeing the memory
-			delete _ctx->cur->_prim;
-			_ctx->next = _ctx->cur->_next;
-			delete _ctx->cur;
-
-			// If it was the first item, update the list head
-			if (_ctx->prev == NULL)
-				_otlist = _ctx->next;
-			// Otherwise update the next pinter of the previous item
-			else
-				_ctx->prev->_next = _ctx->next;
-
-			_ctx->cur = _ctx->next;
-		} else {
-			// Update the pointer to the previous item, and the current to the next
-			_ctx->prev = _ctx->cur;
-			_ctx->cur = _ctx->cur->_next;
+	_ctx->bucket = _otBuckets.empty() ? NULL : _otBuckets[0];
+
+	while (_ctx->bucket != NULL) {
+		// Only the priority is kept across the draw calls, since the bucket
+		// itself may be released once its last primitive is removed
+		_ctx->prior = _ctx->bucket->_prior;
+		_ctx->prev = NULL;
+		_ctx->cur = _ctx->bucket->_head;
+
+		while (_ctx->cur != NULL) {
+			// Call the task Draw method, passing it a copy of the original
+			_ctx->myprim = _ctx->cur->_prim->duplicate();
+			CORO_INVOKE_2(_ctx->cur->_prim->_task->draw, *this, _ctx->myprim);
+			delete _ctx->myprim;
+
+			// Check if it's time to remove the task from the OT list
+			CORO_INVOKE_1(_ctx->cur->_prim->_task->removeThis, _ctx->result);
+			if (_ctx->result) {
+				// De-register the task
+				_ctx->cur->_prim->_task->unregister();
+
+				// Delete task, freeing the memory
+				delete _ctx->cur->_prim;
+				_ctx->next = _ctx->cur->_next;
+				removeFromBucket(_ctx->prior, _ctx->prev, _ctx->cur);
+
+				_ctx->cur = _ctx->next;
+			} else {
+				// Update the pointer to the previous item, and the current to the next
+				_ctx->prev = _ctx->cur;
+				_ctx->cur = _ctx->cur->_next;
+			}
 		}
+
+		_ctx->bucket = nextBucket(_ctx->prior);
 	}
 
 	CORO_END_CODE;
@@ -325,32 +409,30 @@ void RMGfxTargetBuffer::drawOT(CORO_PARAM) {
 
 void RMGfxTargetBuffer::addPrim(RMGfxPrimitive *prim) {
 	int nPrior;
-	OTList *cur, *n;
+	OTBucket *bucket;
+	OTList *n;
 
 	// Warn of the OT listing
 	prim->_task->Register();
 
 	// Check the priority
 	nPrior = prim->_task->priority();
-	n = new OTList(prim);
-
-	// Empty list
-	if (_otlist == NULL) {
-		_otlist = n;
-		_otlist->_next = NULL;
-	}
-	// Inclusion in the head
-	else if (nPrior < _otlist->_prim->_task->priority()) {
-		n->_next = _otlist;
-		_otlist = n;
+	n = new (_otListPool) OTList(prim);
+	bucket = findBucket(nPrior);
+
+	// Primitives of equal priority are drawn most recently added first. The
+	// only exception is the lowest priority in the table, where the first
+	// primitive stays in front of the others. This matches the order the
+	// original sorted list produced, which the game scripts rely on.
+	if (bucket->_head != NULL && bucket == _otBuckets[0]) {
+		n->_next = bucket->_head->_next;
+		bucket->_head->_next = n;
 	} else {
-		cur = _otlist;
-		while (cur->_next != NULL && nPrior > cur->_next->_prim->_task->priority())
-			cur = cur->_next;
-
-		n->_next = cur->_next;
-		cur->_next = n;
+		n->_next = bucket->_head;
+		bucket->_head = n;
 	}
+
+	_otSize++;
 }
 
 void RMGfxTargetBuffer::addDirtyRect(const Common::Rect &r) {
@@ -360,15 +442,21 @@ void RMGfxTargetBuffer::addDirtyRect(const Common::Rect &r) {
 }
 
 Common::List<Common::Rect> &RMGfxTargetBuffer::getDirtyRects() {
-	// Copy rects from both the current and previous frame into the output dirty rects list
+	// Collect the rects from both the current and previous frame
 	Common::List<Common::Rect>::iterator i;
-	_dirtyRects.clear();
+	_mergeRects.clear();
 	for (i = _previousDirtyRects.begin(); i != _previousDirtyRects.end(); ++i)
-		_dirtyRects.push_back(*i);
+		_mergeRects.push_back(*i);
 	for (i = _currentDirtyRects.begin(); i != _currentDirtyRects.end(); ++i)
-		_dirtyRects.push_back(*i);
+		_mergeRects.push_back(*i);
 
 	mergeDirtyRects();
+
+	// Copy the merged rects into the output dirty rects list
+	_dirtyRects.clear();
+	for (uint j = 0; j < _mergeRects.size(); ++j)
+		_dirtyRects.push_back(_mergeRects[j]);
+
 	return _dirtyRects;
 }
 
@@ -384,34 +472,53 @@ void RMGfxTargetBuffer::clearDirtyRects() {
 	_currentDirtyRects.clear();
 }
 
+static inline int rectArea(const Common::Rect &r) {
+	return r.width() * r.height();
+}
+
 /**
- * Merges any clipping rectangles that overlap to try and reduce
- * the total number of clip rectangles.
+ * Coalesces the clipping rectangles to try and reduce their total number.
+ * Rectangles inside others are dropped, and two rectangles are combined
+ * when they overlap or when their bounding box covers no more than the
+ * two of them did, e.g. for adjacent rects of equal height. Passes are
+ * repeated until nothing changes, since a grown rect may now reach others.
  */
 void RMGfxTargetBuffer::mergeDirtyRects() {
-	if (_dirtyRects.size() <= 1)
-		return;
-
-	Common::List<Common::Rect>::iterator rOuter, rInner;
-
-	for (rOuter = _dirtyRects.begin(); rOuter != _dirtyRects.end(); ++rOuter) {
-		rInner = rOuter;
-		while (++rInner != _dirtyRects.end()) {
-
-			if ((*rOuter).intersects(*rInner)) {
-				// these two rectangles overlap or
-				// are next to each other - merge them
+	bool merged;
+
+	do {
+		merged = false;
+
+		for (uint i = 0; i < _mergeRects.size(); ++i) {
+			uint j = i + 1;
+			while (j < _mergeRects.size()) {
+				Common::Rect &outer = _mergeRects[i];
+				const Common::Rect &inner = _mergeRects[j];
+
+				if (outer.contains(inner)) {
+					// Nothing to do besides dropping the inner rect
+				} else if (inner.contains(outer)) {
+					outer = inner;
+					merged = true;
+				} else {
+					Common::Rect bounds(outer);
+					bounds.extend(inner);
 
-				(*rOuter).extend(*rInner);
+					if (!outer.intersects(inner) && rectArea(bounds) > rectArea(outer) + rectArea(inner)) {
+						++j;
+						continue;
+					}
 
-				// remove the inner rect from the list
-				_dirtyRects.erase(rInner);
+					outer = bounds;
+					merged = true;
+				}
 
-				// move back to beginning of list
-				rInner = rOuter;
+				// Remove the inner rect, the order of the rects does not matter
+				_mergeRects[j] = _mergeRects.back();
+				_mergeRects.pop_back();
 			}
 		}
-	}
+	} while (merged);
 }
 
 uint16 *RMGfxTargetBuffer::_precalcTable = NULL;
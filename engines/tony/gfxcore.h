@@ -31,6 +31,7 @@
 
 #include "common/system.h"
 #include "common/coroutines.h"
+#include "common/memorypool.h"
 #include "tony/utils.h"
 
 namespace Tony {
@@ -440,19 +441,41 @@ private:
 		OTList();
 		OTList(RMGfxPrimitive *pr) {
 			_prim = pr;
+			_next = NULL;
+		}
+	};
+
+	/**
+	 * All the primitives sharing the same priority. Buckets are kept sorted
+	 * by priority, so drawing the OT is a plain walk over the buckets.
+	 */
+	struct OTBucket {
+		int _prior;
+		OTList *_head;
+
+		OTBucket(int prior) {
+			_prior = prior;
+			_head = NULL;
 		}
 	};
 
 	bool _trackDirtyRects;
 	Common::List<Common::Rect> _currentDirtyRects, _previousDirtyRects, _dirtyRects;
+	Common::Array<Common::Rect> _mergeRects;
 
 	void mergeDirtyRects();
 
+	OTBucket *findBucket(int nPrior);
+	OTBucket *nextBucket(int nPrior);
+	void removeFromBucket(int nPrior, OTList *prev, OTList *node);
+
 private:
 	//OSystem::MutexRef csModifyingOT;
 
 protected:
-	OTList *_otlist;
+	Common::Array<OTBucket *> _otBuckets;
+	Common::ObjectPool<OTList> _otListPool;
+	Common::ObjectPool<OTBucket> _otBucketPool;
 	int _otSize;
 
 public:
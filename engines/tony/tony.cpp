@@ -79,6 +79,10 @@ TonyEngine::TonyEngine(OSystem *syst, const TonyGameDescription *gameDesc) : Eng
 	_bDrawLocation = false;
 	_startTime = 0;
 	_curThumbnail = NULL;
+	_frameTimeLast = 0;
+	_frameTimeMax = 0;
+	_frameTimeTotal = 0;
+	_frameCount = 0;
 	_bQuitNow = false;
 	_bTimeFreezed = false;
 	_nTimeFreezed = 0;
@@ -643,6 +647,7 @@ void TonyEngine::openInitOptions(CORO_PARAM) {
 void TonyEngine::playProcess(CORO_PARAM, const void *param) {
 	CORO_BEGIN_CONTEXT;
 	Common::String fn;
+	uint32 frameStart;
 	CORO_END_CONTEXT(_ctx);
 
 
@@ -662,6 +667,7 @@ void TonyEngine::playProcess(CORO_PARAM, const void *param) {
 		CORO_INVOKE_1(CoroScheduler.sleep, 50);
 
 		// Call the engine to handle the next frame
+		_ctx->frameStart = g_system->getMillis();
 		CORO_INVOKE_1(g_vm->_theEngine.doFrame, g_vm->_bDrawLocation);
 
 		// Warns that a frame is finished
@@ -678,6 +684,12 @@ void TonyEngine::playProcess(CORO_PARAM, const void *param) {
 		// Paint the frame onto the screen
 		g_vm->_window.repaint();
 
+		// Keep track of the time spent on the frame
+		g_vm->_frameTimeLast = g_system->getMillis() - _ctx->frameStart;
+		g_vm->_frameTimeMax = MAX(g_vm->_frameTimeMax, g_vm->_frameTimeLast);
+		g_vm->_frameTimeTotal += g_vm->_frameTimeLast;
+		g_vm->_frameCount++;
+
 		// Signal the ScummVM debugger
 		g_vm->_debugger->onFrame();
 	}
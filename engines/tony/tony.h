@@ -139,6 +139,12 @@ public:
 	int _initialLoadSlotNumber;
 	int _loadSlotNumber;
 
+	// Frame time statistics, in milliseconds
+	uint32 _frameTimeLast;
+	uint32 _frameTimeMax;
+	uint32 _frameTimeTotal;
+	uint32 _frameCount;
+
 	// Bounding box list manager
 	RMGameBoxes _theBoxes;
 	RMWindow _window;
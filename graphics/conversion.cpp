@@ -23,6 +23,7 @@
 #include "graphics/pixelformat.h"
 
 #include "common/endian.h"
+#include "common/util.h"
 
 namespace Graphics {
 
@@ -30,9 +31,58 @@ namespace Graphics {
 
 namespace {
 
-template<typename SrcColor, typename DstColor, bool backward>
+/**
+ * Compile time counterpart of PixelFormat. Converting through it instead of a
+ * run time PixelFormat lets the compiler fold all shifts and masks, so the
+ * per pixel work boils down to a few constant bit operations. The results are
+ * identical to the ones of the generic conversion.
+ */
+template<typename ColorType, int RBits, int GBits, int BBits, int ABits, int RShift, int GShift, int BShift, int AShift>
+struct FixedPixelFormat {
+	typedef ColorType Color;
+
+	enum {
+		kBytesPerPixel = sizeof(Color),
+		kRLoss = 8 - RBits,
+		kGLoss = 8 - GBits,
+		kBLoss = 8 - BBits,
+		kALoss = 8 - ABits,
+		kRShift = RShift,
+		kGShift = GShift,
+		kBShift = BShift,
+		kAShift = AShift
+	};
+
+	inline uint32 ARGBToColor(uint8 a, uint8 r, uint8 g, uint8 b) const {
+		return
+			((a >> (8 - ABits)) << AShift) |
+			((r >> (8 - RBits)) << RShift) |
+			((g >> (8 - GBits)) << GShift) |
+			((b >> (8 - BBits)) << BShift);
+	}
+
+	inline void colorToARGB(uint32 color, uint8 &a, uint8 &r, uint8 &g, uint8 &b) const {
+		a = (ABits == 0) ? 0xFF : (((color >> AShift) << (8 - ABits)) & 0xFF);
+		r = ((color >> RShift) << (8 - RBits)) & 0xFF;
+		g = ((color >> GShift) << (8 - GBits)) & 0xFF;
+		b = ((color >> BShift) << (8 - BBits)) & 0xFF;
+	}
+};
+
+typedef FixedPixelFormat<uint16, 5, 6, 5, 0, 11,  5,  0,  0> FormatRGB565;
+typedef FixedPixelFormat<uint16, 5, 6, 5, 0,  0,  5, 11,  0> FormatBGR565;
+typedef FixedPixelFormat<uint16, 5, 5, 5, 0, 10,  5,  0,  0> FormatRGB555;
+typedef FixedPixelFormat<uint16, 5, 5, 5, 1, 10,  5,  0, 15> FormatARGB1555;
+typedef FixedPixelFormat<uint16, 5, 5, 5, 1, 11,  6,  1,  0> FormatRGBA5551;
+typedef FixedPixelFormat<uint32, 8, 8, 8, 0, 16,  8,  0,  0> FormatXRGB8888;
+typedef FixedPixelFormat<uint32, 8, 8, 8, 8, 16,  8,  0, 24> FormatARGB8888;
+typedef FixedPixelFormat<uint32, 8, 8, 8, 8, 24, 16,  8,  0> FormatRGBA8888;
+typedef FixedPixelFormat<uint32, 8, 8, 8, 8,  0,  8, 16, 24> FormatABGR8888;
+typedef FixedPixelFormat<uint32, 8, 8, 8, 8,  8, 16, 24,  0> FormatBGRA8888;
+
+template<typename SrcColor, typename DstColor, bool backward, class SrcFormat, class DstFormat>
 inline void crossBlitLogic(byte *dst, const byte *src, const uint w, const uint h,
-                           const PixelFormat &srcFmt, const PixelFormat &dstFmt,
+                           const SrcFormat &srcFmt, const DstFormat &dstFmt,
                            const uint srcDelta, const uint dstDelta) {
 	for (uint y = 0; y < h; ++y) {
 		for (uint x = 0; x < w; ++x) {
@@ -60,6 +110,37 @@ inline void crossBlitLogic(byte *dst, const byte *src, const uint w, const uint
 	}
 }
 
+template<typename SrcColor, typename DstColor, class SrcFormat, class DstFormat>
+inline void crossBlitRect(byte *dst, const byte *src,
+                          const uint dstPitch, const uint srcPitch,
+                          uint w, uint h,
+                          const SrcFormat &srcFmt, const DstFormat &dstFmt) {
+	const uint srcDelta = (srcPitch - w * sizeof(SrcColor));
+	const uint dstDelta = (dstPitch - w * sizeof(DstColor));
+
+	if (sizeof(DstColor) > sizeof(SrcColor)) {
+		// We need to blit the surface from bottom right to top left here.
+		// This is neeeded, because when we convert to the same memory
+		// buffer copying the surface from top left to bottom right would
+		// overwrite the source, since we have more bits per destination
+		// color than per source color.
+		dst += h * dstPitch - dstDelta - sizeof(DstColor);
+		src += h * srcPitch - srcDelta - sizeof(SrcColor);
+	}
+
+	// Without any padding between the lines the whole rect can be handled
+	// as one long line.
+	if (!srcDelta && !dstDelta) {
+		w *= h;
+		h = 1;
+	}
+
+	if (sizeof(DstColor) > sizeof(SrcColor))
+		crossBlitLogic<SrcColor, DstColor, true>(dst, src, w, h, srcFmt, dstFmt, srcDelta, dstDelta);
+	else
+		crossBlitLogic<SrcColor, DstColor, false>(dst, src, w, h, srcFmt, dstFmt, srcDelta, dstDelta);
+}
+
 template<typename DstColor, bool backward>
 inline void crossBlitLogic3BppSource(byte *dst, const byte *src, const uint w, const uint h,
                                      const PixelFormat &srcFmt, const PixelFormat &dstFmt,
@@ -95,6 +176,64 @@ inline void crossBlitLogic3BppSource(byte *dst, const byte *src, const uint w, c
 	}
 }
 
+template<class SrcFormat, class DstFormat>
+void crossBlitFixed(byte *dst, const byte *src, const uint dstPitch, const uint srcPitch, const uint w, const uint h) {
+	crossBlitRect<typename SrcFormat::Color, typename DstFormat::Color>(dst, src, dstPitch, srcPitch, w, h, SrcFormat(), DstFormat());
+}
+
+/**
+ * The fields of a PixelFormat as constant data, so that looking up a
+ * conversion does not need to construct any PixelFormat.
+ */
+struct FixedFormatDesc {
+	byte bytesPerPixel;
+	byte rLoss, gLoss, bLoss, aLoss;
+	byte rShift, gShift, bShift, aShift;
+
+	inline bool matches(const PixelFormat &fmt) const {
+		return fmt.bytesPerPixel == bytesPerPixel
+		    && fmt.rLoss == rLoss && fmt.gLoss == gLoss && fmt.bLoss == bLoss && fmt.aLoss == aLoss
+		    && fmt.rShift == rShift && fmt.gShift == gShift && fmt.bShift == bShift && fmt.aShift == aShift;
+	}
+};
+
+struct FixedCrossBlit {
+	FixedFormatDesc srcFormat;
+	FixedFormatDesc dstFormat;
+	void (*blit)(byte *dst, const byte *src, const uint dstPitch, const uint srcPitch, const uint w, const uint h);
+};
+
+#define FIXED_FORMAT(fmt) \
+	{ Format##fmt::kBytesPerPixel, \
+	  Format##fmt::kRLoss, Format##fmt::kGLoss, Format##fmt::kBLoss, Format##fmt::kALoss, \
+	  Format##fmt::kRShift, Format##fmt::kGShift, Format##fmt::kBShift, Format##fmt::kAShift }
+
+#define FIXED_CROSSBLIT(src, dst) \
+	{ FIXED_FORMAT(src), FIXED_FORMAT(dst), &crossBlitFixed<Format##src, Format##dst> }, \
+	{ FIXED_FORMAT(dst), FIXED_FORMAT(src), &crossBlitFixed<Format##dst, Format##src> }
+
+// Format pairs commonly converted every frame by backends, engines and video
+// decoders. Everything else goes through the generic conversion.
+const FixedCrossBlit fixedCrossBlits[] = {
+	FIXED_CROSSBLIT(RGB565, XRGB8888),
+	FIXED_CROSSBLIT(RGB565, ARGB8888),
+	FIXED_CROSSBLIT(RGB565, RGBA8888),
+	FIXED_CROSSBLIT(RGB565, ABGR8888),
+	FIXED_CROSSBLIT(RGB565, BGR565),
+	FIXED_CROSSBLIT(RGB565, RGB555),
+	FIXED_CROSSBLIT(RGB555, XRGB8888),
+	FIXED_CROSSBLIT(ARGB1555, ARGB8888),
+	FIXED_CROSSBLIT(RGBA5551, RGBA8888),
+	FIXED_CROSSBLIT(XRGB8888, RGBA8888),
+	FIXED_CROSSBLIT(ARGB8888, RGBA8888),
+	FIXED_CROSSBLIT(ARGB8888, ABGR8888),
+	FIXED_CROSSBLIT(ARGB8888, BGRA8888),
+	FIXED_CROSSBLIT(RGBA8888, ABGR8888)
+};
+
+#undef FIXED_CROSSBLIT
+#undef FIXED_FORMAT
+
 } // End of anonymous namespace
 
 // Function to blit a rect from one color format to another
@@ -125,40 +264,40 @@ bool crossBlit(byte *dst, const byte *src,
 		return true;
 	}
 
+	for (uint i = 0; i < ARRAYSIZE(fixedCrossBlits); ++i) {
+		if (fixedCrossBlits[i].srcFormat.matches(srcFmt) && fixedCrossBlits[i].dstFormat.matches(dstFmt)) {
+			fixedCrossBlits[i].blit(dst, src, dstPitch, srcPitch, w, h);
+			return true;
+		}
+	}
+
 	// Faster, but larger, to provide optimized handling for each case.
-	const uint srcDelta = (srcPitch - w * srcFmt.bytesPerPixel);
-	const uint dstDelta = (dstPitch - w * dstFmt.bytesPerPixel);
+	if (srcFmt.bytesPerPixel == 3) {
+		const uint srcDelta = (srcPitch - w * srcFmt.bytesPerPixel);
+		const uint dstDelta = (dstPitch - w * dstFmt.bytesPerPixel);
 
-	// TODO: optimized cases for dstDelta of 0
-	if (dstFmt.bytesPerPixel == 2) {
-		if (srcFmt.bytesPerPixel == 2) {
-			crossBlitLogic<uint16, uint16, false>(dst, src, w, h, srcFmt, dstFmt, srcDelta, dstDelta);
-		} else if (srcFmt.bytesPerPixel == 3) {
+		if (dstFmt.bytesPerPixel == 2) {
 			crossBlitLogic3BppSource<uint16, false>(dst, src, w, h, srcFmt, dstFmt, srcDelta, dstDelta);
+		} else if (dstFmt.bytesPerPixel == 4) {
+			// We need to blit the surface from bottom right to top left here,
+			// see crossBlitRect.
+			dst += h * dstPitch - dstDelta - dstFmt.bytesPerPixel;
+			src += h * srcPitch - srcDelta - srcFmt.bytesPerPixel;
+			crossBlitLogic3BppSource<uint32, true>(dst, src, w, h, srcFmt, dstFmt, srcDelta, dstDelta);
+		} else {
+			return false;
+		}
+	} else if (dstFmt.bytesPerPixel == 2) {
+		if (srcFmt.bytesPerPixel == 2) {
+			crossBlitRect<uint16, uint16>(dst, src, dstPitch, srcPitch, w, h, srcFmt, dstFmt);
 		} else {
-			crossBlitLogic<uint32, uint16, false>(dst, src, w, h, srcFmt, dstFmt, srcDelta, dstDelta);
+			crossBlitRect<uint32, uint16>(dst, src, dstPitch, srcPitch, w, h, srcFmt, dstFmt);
 		}
 	} else if (dstFmt.bytesPerPixel == 4) {
 		if (srcFmt.bytesPerPixel == 2) {
-			// We need to blit the surface from bottom right to top left here.
-			// This is neeeded, because when we convert to the same memory
-			// buffer copying the surface from top left to bottom right would
-			// overwrite the source, since we have more bits per destination
-			// color than per source color.
-			dst += h * dstPitch - dstDelta - dstFmt.bytesPerPixel;
-			src += h * srcPitch - srcDelta - srcFmt.bytesPerPixel;
-			crossBlitLogic<uint16, uint32, true>(dst, src, w, h, srcFmt, dstFmt, srcDelta, dstDelta);
-		} else if (srcFmt.bytesPerPixel == 3) {
-			// We need to blit the surface from bottom right to top left here.
-			// This is neeeded, because when we convert to the same memory
-			// buffer copying the surface from top left to bottom right would
-			// overwrite the source, since we have more bits per destination
-			// color than per source color.
-			dst += h * dstPitch - dstDelta - dstFmt.bytesPerPixel;
-			src += h * srcPitch - srcDelta - srcFmt.bytesPerPixel;
-			crossBlitLogic3BppSource<uint32, true>(dst, src, w, h, srcFmt, dstFmt, srcDelta, dstDelta);
+			crossBlitRect<uint16, uint32>(dst, src, dstPitch, srcPitch, w, h, srcFmt, dstFmt);
 		} else {
-			crossBlitLogic<uint32, uint32, false>(dst, src, w, h, srcFmt, dstFmt, srcDelta, dstDelta);
+			crossBlitRect<uint32, uint32>(dst, src, dstPitch, srcPitch, w, h, srcFmt, dstFmt);
 		}
 	} else {
 		return false;
@@ -60,6 +60,9 @@ inline static void RGB2YUV(byte r, byte g, byte b, byte &y, byte &u, byte &v) {
  *					false if there is an error.
  *
  * @note Blitting to a 3Bpp destination is not supported
+ * @note Commonly used format pairs, e.g. RGB565 <-> XRGB8888, are handled by
+ *       converters specialised at compile time. All other pairs are
+ *       converted through the generic PixelFormat helpers.
  * @note This can convert a surface in place, regardless of the
  *       source and destination format, as long as there is enough
  *       space for the destination. The dstPitch / srcPitch ratio
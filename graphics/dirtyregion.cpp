@@ -0,0 +1,175 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "graphics/dirtyregion.h"
+
+#include "common/util.h"
+
+namespace Graphics {
+
+DirtyRegion::DirtyRegion(int16 width, int16 height) : _width(width), _height(height) {
+	_tilesW = (width + kTileSize - 1) >> kTileShift;
+	_tilesH = (height + kTileSize - 1) >> kTileShift;
+	_tiles = new BoundingBox[_tilesW * _tilesH];
+	_glom = new int[_tilesW * 2];
+	clear();
+}
+
+DirtyRegion::~DirtyRegion() {
+	delete[] _tiles;
+	delete[] _glom;
+}
+
+void DirtyRegion::addRect(const Common::Rect &rect) {
+	if (_full || !rect.isValidRect())
+		return;
+
+	Common::Rect r(rect);
+	r.clip(Common::Rect(_width, _height));
+	if (r.isEmpty())
+		return;
+
+	if (r.width() == _width && r.height() == _height) {
+		invalidate();
+		return;
+	}
+
+	// Work with inclusive coordinates from here on
+	const int ux0 = r.left >> kTileShift;
+	const int uy0 = r.top >> kTileShift;
+	const int ux1 = (r.right - 1) >> kTileShift;
+	const int uy1 = (r.bottom - 1) >> kTileShift;
+
+	const int tx0 = r.left & (kTileSize - 1);
+	const int ty0 = r.top & (kTileSize - 1);
+	const int tx1 = (r.right - 1) & (kTileSize - 1);
+	const int ty1 = (r.bottom - 1) & (kTileSize - 1);
+
+	for (int yc = uy0; yc <= uy1; yc++) {
+		const uint iy0 = (yc == uy0) ? ty0 : 0;
+		const uint iy1 = (yc == uy1) ? ty1 : kTileSize - 1;
+		BoundingBox *tile = &_tiles[yc * _tilesW + ux0];
+
+		for (int xc = ux0; xc <= ux1; xc++, tile++) {
+			uint ix0 = (xc == ux0) ? tx0 : 0;
+			uint ix1 = (xc == ux1) ? tx1 : kTileSize - 1;
+			uint jy0 = iy0, jy1 = iy1;
+
+			const BoundingBox box = *tile;
+			if (box != kEmptyBox) {
+				ix0 = MIN<uint>(boxX0(box), ix0);
+				jy0 = MIN<uint>(boxY0(box), jy0);
+				ix1 = MAX<uint>(boxX1(box), ix1);
+				jy1 = MAX<uint>(boxY1(box), jy1);
+			}
+			*tile = makeBox(ix0, jy0, ix1, jy1);
+		}
+	}
+
+	_dirty = true;
+	_rectsValid = false;
+}
+
+void DirtyRegion::invalidate() {
+	_dirty = true;
+	_full = true;
+	_rectsValid = false;
+}
+
+void DirtyRegion::clear() {
+	for (int i = 0; i < _tilesW * _tilesH; ++i)
+		_tiles[i] = kEmptyBox;
+
+	_dirty = false;
+	_full = false;
+	_rects.clear();
+	_rectsValid = true;
+}
+
+const Common::Array<Common::Rect> &DirtyRegion::getRects() {
+	if (!_rectsValid) {
+		buildRects();
+		_rectsValid = true;
+	}
+	return _rects;
+}
+
+void DirtyRegion::buildRects() {
+	_rects.clear();
+
+	if (_full) {
+		_rects.push_back(Common::Rect(_width, _height));
+		return;
+	}
+
+	int *prevGlom = _glom;
+	int *curGlom = _glom + _tilesW;
+	for (int x = 0; x < _tilesW; ++x)
+		prevGlom[x] = -1;
+
+	const BoundingBox *tile = _tiles;
+	for (int y = 0; y < _tilesH; ++y) {
+		for (int x = 0; x < _tilesW; ++x)
+			curGlom[x] = -1;
+
+		for (int x = 0; x < _tilesW; ++x, ++tile) {
+			const BoundingBox box = *tile;
+			if (box == kEmptyBox)
+				continue;
+
+			const int start = x;
+			const int16 x0 = (x << kTileShift) + boxX0(box);
+			const int16 y0 = (y << kTileShift) + boxY0(box);
+			const int16 y1 = (y << kTileShift) + boxY1(box) + 1;
+
+			// Follow the run of tiles which the bounding box continues into
+			BoundingBox last = box;
+			while (boxX1(last) == kTileSize - 1 && x + 1 < _tilesW) {
+				const BoundingBox next = tile[1];
+				if (next == kEmptyBox || boxX0(next) != 0 || boxY0(next) != boxY0(box) || boxY1(next) != boxY1(box))
+					break;
+				last = next;
+				++x;
+				++tile;
+			}
+			const int16 x1 = (x << kTileShift) + boxX1(last) + 1;
+
+			// Grow the rectangle from the row above if it lines up exactly
+			const int above = prevGlom[start];
+			if (above != -1) {
+				Common::Rect &r = _rects[above];
+				if (r.left == x0 && r.right == x1 && r.bottom == y0) {
+					r.bottom = y1;
+					curGlom[start] = above;
+					continue;
+				}
+			}
+
+			curGlom[start] = _rects.size();
+			_rects.push_back(Common::Rect(x0, y0, x1, y1));
+		}
+
+		SWAP(prevGlom, curGlom);
+	}
+}
+
+} // End of namespace Graphics
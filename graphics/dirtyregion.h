@@ -0,0 +1,108 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef GRAPHICS_DIRTYREGION_H
+#define GRAPHICS_DIRTYREGION_H
+
+#include "common/scummsys.h"
+#include "common/array.h"
+#include "common/rect.h"
+
+namespace Graphics {
+
+/**
+ * Tracks the damaged parts of a screen sized area.
+ *
+ * The area is divided into tiles of 32x32 pixels, each of which keeps the
+ * bounding box of all rectangles added to it. This keeps adding rectangles
+ * cheap and bounded in memory, no matter how many are added during a frame.
+ * The bounding boxes are coalesced into a list of non overlapping rectangles
+ * when requested, which is what should be passed to the backend.
+ */
+class DirtyRegion {
+public:
+	DirtyRegion(int16 width, int16 height);
+	~DirtyRegion();
+
+	int16 getWidth() const { return _width; }
+	int16 getHeight() const { return _height; }
+
+	/**
+	 * Marks a rectangle as damaged. The rectangle is clipped to the area, so
+	 * partially (or completely) offscreen rectangles are fine.
+	 */
+	void addRect(const Common::Rect &r);
+
+	/** Marks the whole area as damaged. */
+	void invalidate();
+
+	/** Marks the whole area as clean. Usually called after presenting it. */
+	void clear();
+
+	bool isEmpty() const { return !_dirty; }
+	bool isFullyDirty() const { return _full; }
+
+	/**
+	 * Returns the damaged parts as non overlapping rectangles. Neighbouring
+	 * tiles are merged horizontally and vertically where their bounding boxes
+	 * line up. The array stays valid until the region is changed.
+	 */
+	const Common::Array<Common::Rect> &getRects();
+
+private:
+	enum {
+		kTileShift = 5,
+		kTileSize = 1 << kTileShift
+	};
+
+	/** Inclusive bounding box of a tile, packed as x0, y0, x1, y1 bytes. */
+	typedef uint32 BoundingBox;
+
+	static const BoundingBox kEmptyBox = 0xFFFFFFFF;
+
+	static byte boxX0(BoundingBox box) { return (box >> 24) & 0xFF; }
+	static byte boxY0(BoundingBox box) { return (box >> 16) & 0xFF; }
+	static byte boxX1(BoundingBox box) { return (box >> 8) & 0xFF; }
+	static byte boxY1(BoundingBox box) { return box & 0xFF; }
+
+	static BoundingBox makeBox(uint x0, uint y0, uint x1, uint y1) {
+		return (x0 << 24) | (y0 << 16) | (x1 << 8) | y1;
+	}
+
+	void buildRects();
+
+	int16 _width, _height;
+	int _tilesW, _tilesH;
+	BoundingBox *_tiles;
+
+	bool _dirty;
+	bool _full;
+	bool _rectsValid;
+	Common::Array<Common::Rect> _rects;
+
+	/** Index of the rect ending at each tile column, for merging rows. */
+	int *_glom;
+};
+
+} // End of namespace Graphics
+
+#endif
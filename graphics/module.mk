@@ -3,6 +3,7 @@ MODULE := graphics
 MODULE_OBJS := \
 	conversion.o \
 	cursorman.o \
+	dirtyregion.o \
 	font.o \
 	fontman.o \
 	fonts/bdf.o \
@@ -23,8 +23,11 @@
 // NB: This is really only necessary if USE_READLINE is defined
 #define FORBIDDEN_SYMBOL_ALLOW_ALL
 
+#include "common/archive.h"
 #include "common/debug-channels.h"
+#include "common/file.h"
 #include "common/system.h"
+#include "common/trace.h"
 
 #include "engines/engine.h"
 
@@ -64,6 +67,9 @@ Debugger::Debugger() {
 	DCmd_Register("debugflag_list",		WRAP_METHOD(Debugger, Cmd_DebugFlagsList));
 	DCmd_Register("debugflag_enable",	WRAP_METHOD(Debugger, Cmd_DebugFlagEnable));
 	DCmd_Register("debugflag_disable",	WRAP_METHOD(Debugger, Cmd_DebugFlagDisable));
+
+	DCmd_Register("archive_stats",		WRAP_METHOD(Debugger, Cmd_ArchiveStats));
+	DCmd_Register("trace",				WRAP_METHOD(Debugger, Cmd_Trace));
 }
 
 Debugger::~Debugger() {
@@ -537,6 +543,55 @@ bool Debugger::Cmd_DebugFlagDisable(int argc, const char **argv) {
 	return true;
 }
 
+bool Debugger::Cmd_ArchiveStats(int argc, const char **argv) {
+	if (argc >= 2 && !strcmp(argv[1], "reset")) {
+		SearchMan.resetArchiveStats();
+		DebugPrintf("Archive lookup statistics reset\n");
+		return true;
+	}
+
+	const Common::Array<Common::SearchSet::ArchiveStats> stats = SearchMan.getArchiveStats();
+
+	DebugPrintf("Prio  Lookups   Misses  Archive\n");
+	DebugPrintf("-----------------------------------\n");
+	for (uint i = 0; i < stats.size(); ++i) {
+		DebugPrintf("%4d %8u %8u  %s\n", stats[i].priority, stats[i].lookups,
+				stats[i].misses, stats[i].name.c_str());
+	}
+	DebugPrintf("\n");
+	return true;
+}
+
+bool Debugger::Cmd_Trace(int argc, const char **argv) {
+	if (argc >= 2 && !strcmp(argv[1], "start")) {
+		TraceMan.start();
+		DebugPrintf("Tracing started\n");
+	} else if (argc >= 2 && !strcmp(argv[1], "stop")) {
+		TraceMan.stop();
+		DebugPrintf("Tracing stopped\n");
+	} else if (argc >= 3 && !strcmp(argv[1], "save")) {
+		Common::DumpFile file;
+		if (!file.open(argv[2])) {
+			DebugPrintf("Could not open '%s' for writing\n", argv[2]);
+			return true;
+		}
+
+		// Saving while recording would read events as they are written
+		const bool enabled = TraceMan.isEnabled();
+		TraceMan.stop();
+		TraceMan.exportChromeJSON(file);
+		file.finalize();
+		if (enabled)
+			TraceMan.start();
+
+		DebugPrintf("Trace saved to '%s'\n", argv[2]);
+	} else {
+		DebugPrintf("trace start|stop|save <file>\n");
+		DebugPrintf("The saved file can be viewed with chrome://tracing\n");
+	}
+	return true;
+}
+
 // Console handler
 #ifndef USE_TEXT_CONSOLE_FOR_DEBUGGER
 bool Debugger::debuggerInputCallback(GUI::ConsoleDialog *console, const char *input, void *refCon) {
@@ -722,12 +722,32 @@ void LauncherDialog::close() {
 	Dialog::close();
 }
 
+namespace {
+
+struct LauncherEntry {
+	Common::String key;
+	Common::String description;
+
+	LauncherEntry(const Common::String &k, const Common::String &d) : key(k), description(d) {}
+};
+
+struct LauncherEntryComparator {
+	bool operator()(const LauncherEntry &x, const LauncherEntry &y) const {
+		const int cmp = scumm_stricmp(x.description.c_str(), y.description.c_str());
+		// Use the target name as tie breaker, so that the order of games with
+		// the same description does not depend on the hash map order.
+		return cmp < 0 || (cmp == 0 && x.key < y.key);
+	}
+};
+
+} // End of anonymous namespace
+
 void LauncherDialog::updateListing() {
-	StringArray l;
+	Common::Array<LauncherEntry> domainList;
 
 	// Retrieve a list of all games defined in the config file
-	_domains.clear();
 	const ConfigManager::DomainMap &domains = ConfMan.getGameDomains();
+	domainList.reserve(domains.size());
 	ConfigManager::DomainMap::const_iterator iter;
 	for (iter = domains.begin(); iter != domains.end(); ++iter) {
 #ifdef __DS__
@@ -744,24 +764,38 @@ void LauncherDialog::updateListing() {
 		if (gameid.empty())
 			gameid = iter->_key;
 		if (description.empty()) {
-			GameDescriptor g = EngineMan.findGame(gameid);
-			if (g.contains("description"))
-				description = g.description();
+			// Remember the description, so the plugins are only queried once
+			// for each gameid while the launcher is open. It is not written
+			// to the config file, so detector changes still show up.
+			Common::HashMap<String, String>::const_iterator known = _gameDescriptions.find(gameid);
+			if (known != _gameDescriptions.end()) {
+				description = known->_value;
+			} else {
+				GameDescriptor g = EngineMan.findGame(gameid);
+				if (g.contains("description"))
+					description = g.description();
+				_gameDescriptions[gameid] = description;
+			}
 		}
 
 		if (description.empty()) {
 			description = Common::String::format("Unknown (target %s, gameid %s)", iter->_key.c_str(), gameid.c_str());
 		}
 
-		if (!gameid.empty() && !description.empty()) {
-			// Insert the game into the launcher list
-			int pos = 0, size = l.size();
+		if (!gameid.empty() && !description.empty())
+			domainList.push_back(LauncherEntry(iter->_key, description));
+	}
+
+	// Sort the list once instead of inserting every game at its position
+	Common::sort(domainList.begin(), domainList.end(), LauncherEntryComparator());
 
-			while (pos < size && (scumm_stricmp(description.c_str(), l[pos].c_str()) > 0))
-				pos++;
-			l.insert_at(pos, description);
-			_domains.insert_at(pos, iter->_key);
-		}
+	StringArray l;
+	l.reserve(domainList.size());
+	_domains.clear();
+	_domains.reserve(domainList.size());
+	for (Common::Array<LauncherEntry>::const_iterator i = domainList.begin(); i != domainList.end(); ++i) {
+		l.push_back(i->description);
+		_domains.push_back(i->key);
 	}
 
 	const int oldSel = _list->getSelected();
@@ -25,6 +25,9 @@
 #include "gui/dialog.h"
 #include "engines/game.h"
 
+#include "common/hashmap.h"
+#include "common/hash-str.h"
+
 namespace GUI {
 
 class BrowserDialog;
@@ -71,6 +74,9 @@ protected:
 
 	String _search;
 
+	/** Game descriptions found by the detector for targets without one, by gameid */
+	Common::HashMap<String, String> _gameDescriptions;
+
 	virtual void reflowLayout();
 
 	/**
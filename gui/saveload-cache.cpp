@@ -0,0 +1,323 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include "gui/saveload-cache.h"
+
+#include "common/savefile.h"
+#include "common/system.h"
+#include "common/textconsole.h"
+
+#include "graphics/surface.h"
+
+namespace GUI {
+
+enum {
+	kCacheFileMagic = MKTAG('S', 'V', 'M', 'C'),
+	kCacheFileVersion = 1,
+	// Thumbnails are far smaller, larger sizes come from a broken cache
+	kMaxThumbnailSize = 1024
+};
+
+enum {
+	kEntryFlagDeletable      = 1 << 0,
+	kEntryFlagWriteProtected = 1 << 1,
+	kEntryFlagThumbnail      = 1 << 2
+};
+
+static void writeCacheString(Common::WriteStream &out, const Common::String &str) {
+	out.writeUint16LE(str.size());
+	out.write(str.c_str(), str.size());
+}
+
+static Common::String readCacheString(Common::ReadStream &in) {
+	Common::String str;
+	uint16 len = in.readUint16LE();
+	while (len-- > 0 && !in.eos())
+		str += (char)in.readByte();
+	return str;
+}
+
+SaveMetaCache::SaveMetaCache()
+	: _metaEngine(0), _enabled(false), _dirty(false) {
+}
+
+SaveMetaCache::~SaveMetaCache() {
+	close();
+}
+
+void SaveMetaCache::open(const MetaEngine *metaEngine, const Common::String &target) {
+	close();
+
+	_metaEngine = metaEngine;
+	_target = target;
+
+	// Only use the cache in case the engine tells us which savefiles to check
+	// for changes.
+	_enabled = !_metaEngine->getSavegameFile(_target.c_str(), 0).empty();
+
+	if (_enabled)
+		load();
+}
+
+void SaveMetaCache::close() {
+	flush();
+
+	_entries.clear();
+	_metaEngine = 0;
+	_target.clear();
+	_enabled = false;
+}
+
+bool SaveMetaCache::isCached(int slot) {
+	if (!_enabled)
+		return false;
+
+	EntryMap::const_iterator i = _entries.find(slot);
+	if (i == _entries.end())
+		return false;
+
+	uint32 size, timestamp;
+	if (!getFileInfo(slot, size, timestamp) || size != i->_value.size || timestamp != i->_value.timestamp) {
+		_entries.erase(slot);
+		_dirty = true;
+		return false;
+	}
+
+	return true;
+}
+
+SaveStateDescriptor SaveMetaCache::query(int slot) {
+	if (isCached(slot))
+		return _entries[slot].desc;
+
+	SaveStateDescriptor desc = _metaEngine->querySaveMetaInfos(_target.c_str(), slot);
+
+	Entry entry;
+	if (_enabled && desc.getSaveSlot() == slot && getFileInfo(slot, entry.size, entry.timestamp)) {
+		entry.desc = desc;
+		_entries[slot] = entry;
+		_dirty = true;
+	}
+
+	return desc;
+}
+
+void SaveMetaCache::invalidate(int slot) {
+	if (_entries.contains(slot)) {
+		_entries.erase(slot);
+		_dirty = true;
+	}
+}
+
+void SaveMetaCache::flush() {
+	if (!_enabled || !_dirty)
+		return;
+
+	_dirty = false;
+
+	Common::SaveFileManager *saveFileMan = g_system->getSavefileManager();
+	const Common::String fileName = getCacheFileName();
+
+	if (_entries.empty()) {
+		saveFileMan->removeSavefile(fileName);
+		return;
+	}
+
+	// The cache is not compressed on purpose, since loading it fast is its
+	// only reason to exist.
+	Common::OutSaveFile *out = saveFileMan->openForSaving(fileName, false);
+	if (!out) {
+		warning("SaveMetaCache: Could not write '%s'", fileName.c_str());
+		return;
+	}
+
+	out->writeUint32BE(kCacheFileMagic);
+	out->writeUint32BE(kCacheFileVersion);
+	out->writeUint32LE(_entries.size());
+
+	for (EntryMap::const_iterator i = _entries.begin(); i != _entries.end(); ++i)
+		saveEntry(*out, i->_key, i->_value);
+
+	out->finalize();
+	if (out->err())
+		warning("SaveMetaCache: Writing '%s' failed", fileName.c_str());
+
+	delete out;
+}
+
+Common::String SaveMetaCache::getCacheFileName() const {
+	return _target + "-meta.cache";
+}
+
+bool SaveMetaCache::getFileInfo(int slot, uint32 &size, uint32 &timestamp) const {
+	const Common::String fileName = _metaEngine->getSavegameFile(_target.c_str(), slot);
+	if (fileName.empty())
+		return false;
+
+	return g_system->getSavefileManager()->getSavefileInfo(fileName, size, timestamp);
+}
+
+void SaveMetaCache::load() {
+	Common::InSaveFile *in = g_system->getSavefileManager()->openForLoading(getCacheFileName());
+	if (!in)
+		return;
+
+	if (in->readUint32BE() != kCacheFileMagic || in->readUint32BE() != kCacheFileVersion) {
+		// Outdated or broken cache, it will be rewritten on the next flush.
+		_dirty = true;
+		delete in;
+		return;
+	}
+
+	uint32 count = in->readUint32LE();
+	while (count-- > 0) {
+		int slot;
+		Entry entry;
+		if (!loadEntry(*in, slot, entry)) {
+			// The following entries can't be found reliably after a broken
+			// one, so the whole cache is rebuilt
+			_entries.clear();
+			_dirty = true;
+			break;
+		}
+
+		_entries[slot] = entry;
+	}
+
+	delete in;
+}
+
+bool SaveMetaCache::loadEntry(Common::ReadStream &in, int &slot, Entry &entry) {
+	slot = in.readSint32LE();
+	entry.size = in.readUint32LE();
+	entry.timestamp = in.readUint32LE();
+
+	entry.desc.setSaveSlot(slot);
+	entry.desc.setDescription(readCacheString(in));
+	entry.desc.setSaveDate(readCacheString(in));
+	entry.desc.setSaveTime(readCacheString(in));
+	entry.desc.setPlayTime(readCacheString(in));
+
+	const byte flags = in.readByte();
+	entry.desc.setDeletableFlag((flags & kEntryFlagDeletable) != 0);
+	entry.desc.setWriteProtectedFlag((flags & kEntryFlagWriteProtected) != 0);
+
+	if (!(flags & kEntryFlagThumbnail))
+		return !in.err() && !in.eos();
+
+	const uint16 width = in.readUint16LE();
+	const uint16 height = in.readUint16LE();
+
+	Graphics::PixelFormat format;
+	format.bytesPerPixel = in.readByte();
+	format.rLoss = in.readByte();
+	format.gLoss = in.readByte();
+	format.bLoss = in.readByte();
+	format.aLoss = in.readByte();
+	format.rShift = in.readByte();
+	format.gShift = in.readByte();
+	format.bShift = in.readByte();
+	format.aShift = in.readByte();
+
+	if (in.err() || in.eos() || (format.bytesPerPixel != 2 && format.bytesPerPixel != 4))
+		return false;
+	if (width > kMaxThumbnailSize || height > kMaxThumbnailSize)
+		return false;
+
+	Graphics::Surface *thumb = new Graphics::Surface();
+	thumb->create(width, height, format);
+
+	for (uint y = 0; y < height; ++y) {
+		if (format.bytesPerPixel == 2) {
+			uint16 *dst = (uint16 *)thumb->getBasePtr(0, y);
+			for (uint x = 0; x < width; ++x)
+				*dst++ = in.readUint16LE();
+		} else {
+			uint32 *dst = (uint32 *)thumb->getBasePtr(0, y);
+			for (uint x = 0; x < width; ++x)
+				*dst++ = in.readUint32LE();
+		}
+	}
+
+	entry.desc.setThumbnail(thumb);
+
+	if (in.err() || in.eos())
+		return false;
+
+	// Thumbnails are converted to the overlay format on load. In case that
+	// changed since the cache was written, the thumbnails need to be decoded
+	// again.
+	return format == g_system->getOverlayFormat();
+}
+
+void SaveMetaCache::saveEntry(Common::WriteStream &out, int slot, const Entry &entry) {
+	const SaveStateDescriptor &desc = entry.desc;
+	const Graphics::Surface *thumb = desc.getThumbnail();
+	const bool hasThumbnail = thumb && (thumb->format.bytesPerPixel == 2 || thumb->format.bytesPerPixel == 4);
+
+	out.writeSint32LE(slot);
+	out.writeUint32LE(entry.size);
+	out.writeUint32LE(entry.timestamp);
+
+	writeCacheString(out, desc.getDescription());
+	writeCacheString(out, desc.getSaveDate());
+	writeCacheString(out, desc.getSaveTime());
+	writeCacheString(out, desc.getPlayTime());
+
+	byte flags = 0;
+	if (desc.getDeletableFlag())
+		flags |= kEntryFlagDeletable;
+	if (desc.getWriteProtectedFlag())
+		flags |= kEntryFlagWriteProtected;
+	if (hasThumbnail)
+		flags |= kEntryFlagThumbnail;
+	out.writeByte(flags);
+
+	if (!hasThumbnail)
+		return;
+
+	const Graphics::PixelFormat &format = thumb->format;
+	out.writeUint16LE(thumb->w);
+	out.writeUint16LE(thumb->h);
+	out.writeByte(format.bytesPerPixel);
+	out.writeByte(format.rLoss);
+	out.writeByte(format.gLoss);
+	out.writeByte(format.bLoss);
+	out.writeByte(format.aLoss);
+	out.writeByte(format.rShift);
+	out.writeByte(format.gShift);
+	out.writeByte(format.bShift);
+	out.writeByte(format.aShift);
+
+	for (int y = 0; y < thumb->h; ++y) {
+		if (format.bytesPerPixel == 2) {
+			const uint16 *src = (const uint16 *)thumb->getBasePtr(0, y);
+			for (int x = 0; x < thumb->w; ++x)
+				out.writeUint16LE(*src++);
+		} else {
+			const uint32 *src = (const uint32 *)thumb->getBasePtr(0, y);
+			for (int x = 0; x < thumb->w; ++x)
+				out.writeUint32LE(*src++);
+		}
+	}
+}
+
+} // End of namespace GUI
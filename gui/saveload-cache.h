@@ -0,0 +1,116 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef GUI_SAVELOAD_CACHE_H
+#define GUI_SAVELOAD_CACHE_H
+
+#include "common/hashmap.h"
+#include "common/str.h"
+
+#include "engines/metaengine.h"
+
+namespace Common {
+class ReadStream;
+class WriteStream;
+}
+
+namespace GUI {
+
+/**
+ * Cache for the save state meta infos of a single target.
+ *
+ * Querying meta infos via MetaEngine::querySaveMetaInfos means opening,
+ * inflating and parsing every savefile including its thumbnail. This cache
+ * keeps the results, including the already decoded thumbnails, in one file
+ * next to the savefiles. Every entry is validated against the size and the
+ * modification time of its savefile, so overwritten or removed saves are
+ * picked up automatically.
+ *
+ * Engines opt in by implementing MetaEngine::getSavegameFile. Without it,
+ * or when the savefile manager can not provide file infos, all queries are
+ * simply passed on to the MetaEngine.
+ */
+class SaveMetaCache {
+public:
+	SaveMetaCache();
+	~SaveMetaCache();
+
+	/**
+	 * Sets up the cache for the given target and loads the cache file,
+	 * if present. Any previously opened target is closed first.
+	 */
+	void open(const MetaEngine *metaEngine, const Common::String &target);
+
+	/**
+	 * Writes back any changes and drops all entries.
+	 */
+	void close();
+
+	/**
+	 * Checks whether up-to-date meta infos for the slot are available
+	 * without touching the savefile itself.
+	 */
+	bool isCached(int slot);
+
+	/**
+	 * Returns the meta infos for the slot. They are taken from the cache if
+	 * possible, otherwise they are queried from the MetaEngine and stored.
+	 */
+	SaveStateDescriptor query(int slot);
+
+	/**
+	 * Drops the entry for the slot, e.g. after the save was deleted.
+	 */
+	void invalidate(int slot);
+
+	/**
+	 * Writes the cache file in case any entry changed.
+	 */
+	void flush();
+
+private:
+	struct Entry {
+		Entry() : size(0), timestamp(0) {}
+
+		uint32 size;
+		uint32 timestamp;
+		SaveStateDescriptor desc;
+	};
+
+	typedef Common::HashMap<int, Entry> EntryMap;
+
+	const MetaEngine *_metaEngine;
+	Common::String _target;
+	EntryMap _entries;
+	bool _enabled;
+	bool _dirty;
+
+	Common::String getCacheFileName() const;
+	bool getFileInfo(int slot, uint32 &size, uint32 &timestamp) const;
+
+	void load();
+	bool loadEntry(Common::ReadStream &in, int &slot, Entry &entry);
+	void saveEntry(Common::WriteStream &out, int slot, const Entry &entry);
+};
+
+} // End of namespace GUI
+
+#endif
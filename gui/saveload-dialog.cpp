@@ -22,6 +22,7 @@
 #include "gui/saveload-dialog.h"
 #include "common/translation.h"
 #include "common/config-manager.h"
+#include "common/system.h"
 
 #include "gui/message.h"
 #include "gui/gui-manager.h"
@@ -104,7 +105,12 @@ int SaveLoadChooserDialog::run(const Common::String &target, const MetaEngine *m
 	_saveDateSupport = _metaInfoSupport && _metaEngine->hasFeature(MetaEngine::kSavesSupportCreationDate);
 	_playTimeSupport = _metaInfoSupport && _metaEngine->hasFeature(MetaEngine::kSavesSupportPlayTime);
 
-	return runIntern();
+	if (_metaInfoSupport)
+		_metaCache.open(_metaEngine, _target);
+
+	const int result = runIntern();
+	_metaCache.close();
+	return result;
 }
 
 void SaveLoadChooserDialog::handleCommand(CommandSender *sender, uint32 cmd, uint32 data) {
@@ -275,6 +281,7 @@ void SaveLoadChooserSimple::handleCommand(CommandSender *sender, uint32 cmd, uin
 								_("Delete"), _("Cancel"));
 			if (alert.runModal() == kMessageOK) {
 				_metaEngine->removeSaveState(_target.c_str(), _saveList[selItem].getSaveSlot());
+				_metaCache.invalidate(_saveList[selItem].getSaveSlot());
 
 				setResult(-1);
 				_list->setSelected(-1);
@@ -360,7 +367,7 @@ void SaveLoadChooserSimple::updateSelection(bool redraw) {
 	_playtime->setLabel(_("No playtime saved"));
 
 	if (selItem >= 0 && _metaInfoSupport) {
-		SaveStateDescriptor desc = _metaEngine->querySaveMetaInfos(_target.c_str(), _saveList[selItem].getSaveSlot());
+		SaveStateDescriptor desc = _metaCache.query(_saveList[selItem].getSaveSlot());
 
 		isDeletable = desc.getDeletableFlag() && _delSupport;
 		isWriteProtected = desc.getWriteProtectedFlag();
@@ -534,6 +541,12 @@ enum {
 	kNewSaveCmd = 'SAVE'
 };
 
+enum {
+	// Upper bound (in milliseconds) we want to spend loading uncached
+	// meta infos in handleTickle.
+	kMaxMetaLoadTime = 20
+};
+
 SaveLoadChooserGrid::SaveLoadChooserGrid(const Common::String &title, bool saveMode)
 	: SaveLoadChooserDialog("SaveLoadChooser", saveMode), _lines(0), _columns(0), _entriesPerPage(0),
 	_curPage(0), _newSaveContainer(0), _nextFreeSaveSlot(0), _buttons() {
@@ -616,6 +629,26 @@ void SaveLoadChooserGrid::handleMouseWheel(int x, int y, int direction) {
 	}
 }
 
+void SaveLoadChooserGrid::handleTickle() {
+	// Load meta infos which were not cached yet. We only spend a limited time
+	// per tickle here, so the dialog stays responsive and is painted right
+	// away even with a lot of uncached saves.
+	const uint32 start = g_system->getMillis();
+	while (!_pendingButtons.empty() && g_system->getMillis() - start < kMaxMetaLoadTime) {
+		const uint buttonNum = _pendingButtons.remove_at(0);
+		const uint saveNum = _curPage * _entriesPerPage + buttonNum;
+		if (saveNum >= _saveList.size())
+			continue;
+
+		SlotButton &curButton = _buttons[buttonNum];
+		const int saveSlot = _saveList[saveNum].getSaveSlot();
+		updateSlotButton(curButton, saveSlot, _metaCache.query(saveSlot));
+		curButton.container->draw();
+	}
+
+	SaveLoadChooserDialog::handleTickle();
+}
+
 void SaveLoadChooserGrid::open() {
 	SaveLoadChooserDialog::open();
 
@@ -847,54 +880,24 @@ void SaveLoadChooserGrid::hideButtons() {
 
 void SaveLoadChooserGrid::updateSaves() {
 	hideButtons();
+	_pendingButtons.clear();
 
 	for (uint i = _curPage * _entriesPerPage, curNum = 0; i < _saveList.size() && curNum < _entriesPerPage; ++i, ++curNum) {
 		const uint saveSlot = _saveList[i].getSaveSlot();
-
-		SaveStateDescriptor desc = _metaEngine->querySaveMetaInfos(_target.c_str(), saveSlot);
 		SlotButton &curButton = _buttons[curNum];
 		curButton.setVisible(true);
-		const Graphics::Surface *thumbnail = desc.getThumbnail();
-		if (thumbnail) {
-			curButton.button->setGfx(desc.getThumbnail());
-		} else {
-			curButton.button->setGfx(kThumbnailWidth, kThumbnailHeight2, 0, 0, 0);
-		}
-		curButton.description->setLabel(Common::String::format("%d. %s", saveSlot, desc.getDescription().c_str()));
-
-		Common::String tooltip(_("Name: "));
-		tooltip += desc.getDescription();
-
-		if (_saveDateSupport) {
-			const Common::String &saveDate = desc.getSaveDate();
-			if (!saveDate.empty()) {
-				tooltip += "\n";
-				tooltip +=  _("Date: ") + saveDate;
-			}
-
-			const Common::String &saveTime = desc.getSaveTime();
-			if (!saveTime.empty()) {
-				tooltip += "\n";
-				tooltip += _("Time: ") + saveTime;
-			}
-		}
-
-		if (_playTimeSupport) {
-			const Common::String &playTime = desc.getPlayTime();
-			if (!playTime.empty()) {
-				tooltip += "\n";
-				tooltip += _("Playtime: ") + playTime;
-			}
-		}
-
-		curButton.button->setTooltip(tooltip);
 
-		// In save mode we disable the button, when it's write protected.
-		// TODO: Maybe we should not display it at all then?
-		if (_saveMode && desc.getWriteProtectedFlag()) {
-			curButton.button->setEnabled(false);
+		if (_metaCache.isCached(saveSlot)) {
+			updateSlotButton(curButton, saveSlot, _metaCache.query(saveSlot));
 		} else {
-			curButton.button->setEnabled(true);
+			// Show what listSaves told us for now, the meta infos are loaded
+			// in handleTickle.
+			curButton.button->setGfx(kThumbnailWidth, kThumbnailHeight2, 0, 0, 0);
+			curButton.description->setLabel(Common::String::format("%d. %s", saveSlot, _saveList[i].getDescription().c_str()));
+			curButton.button->setTooltip(_("Name: ") + _saveList[i].getDescription());
+			// We do not know yet whether the save is write protected.
+			curButton.button->setEnabled(!_saveMode);
+			_pendingButtons.push_back(curNum);
 		}
 	}
 
@@ -912,6 +915,51 @@ void SaveLoadChooserGrid::updateSaves() {
 		_nextButton->setEnabled(false);
 }
 
+void SaveLoadChooserGrid::updateSlotButton(SlotButton &curButton, int saveSlot, const SaveStateDescriptor &desc) {
+	const Graphics::Surface *thumbnail = desc.getThumbnail();
+	if (thumbnail) {
+		curButton.button->setGfx(thumbnail);
+	} else {
+		curButton.button->setGfx(kThumbnailWidth, kThumbnailHeight2, 0, 0, 0);
+	}
+	curButton.description->setLabel(Common::String::format("%d. %s", saveSlot, desc.getDescription().c_str()));
+
+	Common::String tooltip(_("Name: "));
+	tooltip += desc.getDescription();
+
+	if (_saveDateSupport) {
+		const Common::String &saveDate = desc.getSaveDate();
+		if (!saveDate.empty()) {
+			tooltip += "\n";
+			tooltip +=  _("Date: ") + saveDate;
+		}
+
+		const Common::String &saveTime = desc.getSaveTime();
+		if (!saveTime.empty()) {
+			tooltip += "\n";
+			tooltip += _("Time: ") + saveTime;
+		}
+	}
+
+	if (_playTimeSupport) {
+		const Common::String &playTime = desc.getPlayTime();
+		if (!playTime.empty()) {
+			tooltip += "\n";
+			tooltip += _("Playtime: ") + playTime;
+		}
+	}
+
+	curButton.button->setTooltip(tooltip);
+
+	// In save mode we disable the button, when it's write protected.
+	// TODO: Maybe we should not display it at all then?
+	if (_saveMode && desc.getWriteProtectedFlag()) {
+		curButton.button->setEnabled(false);
+	} else {
+		curButton.button->setEnabled(true);
+	}
+}
+
 SavenameDialog::SavenameDialog()
 	: Dialog("SavenameDialog") {
 	_title = new StaticTextWidget(this, "SavenameDialog.DescriptionText", Common::String());
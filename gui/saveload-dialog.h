@@ -23,6 +23,7 @@
 #define GUI_SAVELOAD_DIALOG_H
 
 #include "gui/dialog.h"
+#include "gui/saveload-cache.h"
 #include "gui/widgets/list.h"
 
 #include "engines/metaengine.h"
@@ -77,6 +78,7 @@ protected:
 	bool					_saveDateSupport;
 	bool					_playTimeSupport;
 	Common::String			_target;
+	SaveMetaCache			_metaCache;
 
 #ifndef DISABLE_SAVELOADCHOOSER_GRID
 	ButtonWidget *_listButton;
@@ -163,6 +165,7 @@ public:
 protected:
 	virtual void handleCommand(CommandSender *sender, uint32 cmd, uint32 data);
 	virtual void handleMouseWheel(int x, int y, int direction);
+	virtual void handleTickle();
 private:
 	virtual int runIntern();
 
@@ -200,6 +203,10 @@ private:
 	void destroyButtons();
 	void hideButtons();
 	void updateSaves();
+	void updateSlotButton(SlotButton &button, int saveSlot, const SaveStateDescriptor &desc);
+
+	/** Indices into _buttons of slots whose meta infos still need to be loaded. */
+	Common::Array<uint> _pendingButtons;
 };
 
 #endif // !DISABLE_SAVELOADCHOOSER_GRID
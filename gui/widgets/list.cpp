@@ -160,6 +160,14 @@ void ListWidget::setList(const StringArray &list, const ColorList *colors) {
 	_listIndex.clear();
 	_listColors.clear();
 
+	// Precompute the lowercase keys used for filtering
+	_dataListLower.clear();
+	_dataListLower.reserve(list.size());
+	for (StringArray::const_iterator i = list.begin(); i != list.end(); ++i) {
+		_dataListLower.push_back(*i);
+		_dataListLower.back().toLowercase();
+	}
+
 	if (colors) {
 		_listColors = *colors;
 		assert(_listColors.size() == _dataList.size());
@@ -190,9 +198,17 @@ void ListWidget::append(const String &s, ThemeEngine::FontColor color) {
 	}
 
 	_dataList.push_back(s);
+	_dataListLower.push_back(s);
+	_dataListLower.back().toLowercase();
 	_list.push_back(s);
 
-	setFilter(_filter, false);
+	// Reapply the current filter, so the new entry is only shown when it
+	// matches.
+	if (!_filter.empty()) {
+		const String filter = _filter;
+		_filter.clear();
+		setFilter(filter, false);
+	}
 
 	scrollBarRecalc();
 }
@@ -675,6 +691,12 @@ void ListWidget::setFilter(const String &filter, bool redraw) {
 	if (_filter == filt) // Filter was not changed
 		return;
 
+	// When the new filter only extends the old one, e.g. because the user
+	// typed another character, every entry matching the new filter also
+	// matched the old one. Thus we only need to check the entries currently
+	// shown instead of the whole list.
+	const bool narrowing = !_filter.empty() && filt.hasPrefix(_filter);
+
 	_filter = filt;
 
 	if (_filter.empty()) {
@@ -686,26 +708,26 @@ void ListWidget::setFilter(const String &filter, bool redraw) {
 		// as substrings, ignoring case.
 
 		Common::StringTokenizer tok(_filter);
-		String tmp;
-		int n = 0;
+		const Common::Array<int> candidates(_listIndex);
+		const uint numCandidates = narrowing ? candidates.size() : _dataList.size();
 
 		_list.clear();
 		_listIndex.clear();
 
-		for (StringArray::iterator i = _dataList.begin(); i != _dataList.end(); ++i, ++n) {
-			tmp = *i;
-			tmp.toLowercase();
+		for (uint i = 0; i < numCandidates; ++i) {
+			const int n = narrowing ? candidates[i] : (int)i;
+			const String &key = _dataListLower[n];
 			bool matches = true;
 			tok.reset();
 			while (!tok.empty()) {
-				if (!tmp.contains(tok.nextToken())) {
+				if (!key.contains(tok.nextToken())) {
 					matches = false;
 					break;
 				}
 			}
 
 			if (matches) {
-				_list.push_back(*i);
+				_list.push_back(_dataList[n]);
 				_listIndex.push_back(n);
 			}
 		}
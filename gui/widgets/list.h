@@ -54,6 +54,7 @@ public:
 protected:
 	StringArray		_list;
 	StringArray		_dataList;
+	StringArray		_dataListLower;
 	ColorList		_listColors;
 	Common::Array<int>		_listIndex;
 	bool			_editable;
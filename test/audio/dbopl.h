@@ -0,0 +1,94 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/softsynth/opl/dbopl.h"
+
+#ifndef DISABLE_DOSBOX_OPL
+
+using namespace OPL::DOSBox;
+
+// Feeds the same random register writes to a chip using the block synth and
+// to one generating sample by sample, whose output has to be identical.
+class DBOPLTestSuite : public CxxTest::TestSuite
+{
+	uint32 _seed;
+
+	uint32 nextRandom() {
+		_seed = _seed * 1103515245 + 12345;
+		return _seed >> 16;
+	}
+
+	void write(DBOPL::Chip &a, DBOPL::Chip &b, uint32 reg, uint8 val) {
+		a.WriteReg(reg, val);
+		b.WriteReg(reg, val);
+	}
+
+	// Writes a random instrument to a channel and keys it on or off
+	void writeChannel(DBOPL::Chip &a, DBOPL::Chip &b, bool opl3) {
+		static const uint8 opOffsets[9] = { 0x00, 0x01, 0x02, 0x08, 0x09, 0x0A, 0x10, 0x11, 0x12 };
+
+		const uint32 bank = (opl3 && (nextRandom() & 1)) ? 0x100 : 0;
+		const uint channel = nextRandom() % 9;
+		for (uint op = 0; op < 2; ++op) {
+			const uint32 offset = bank + opOffsets[channel] + op * 3;
+			write(a, b, 0x20 + offset, nextRandom());
+			write(a, b, 0x40 + offset, nextRandom() & 0x3F);
+			write(a, b, 0x60 + offset, nextRandom());
+			write(a, b, 0x80 + offset, nextRandom());
+			write(a, b, 0xE0 + offset, nextRandom() & 7);
+		}
+		write(a, b, bank + 0xA0 + channel, nextRandom());
+		write(a, b, bank + 0xC0 + channel, nextRandom() | (opl3 ? 0x30 : 0));
+		write(a, b, bank + 0xB0 + channel, nextRandom() & 0x3F);
+	}
+
+	void compare(bool opl3, uint32 seed) {
+		_seed = seed;
+
+		DBOPL::InitTables();
+		DBOPL::Chip block, reference;
+		reference.referenceSynth = true;
+		block.Setup(44100);
+		reference.Setup(44100);
+
+		if (opl3) {
+			write(block, reference, 0x105, 1);
+			// Some four operator channels
+			write(block, reference, 0x104, 0x2D);
+		}
+		write(block, reference, 0x01, 0x20);
+
+		int32 blockBuffer[1024 * 2], referenceBuffer[1024 * 2];
+		for (uint i = 0; i < 200; ++i) {
+			const uint writes = nextRandom() & 3;
+			for (uint j = 0; j < writes; ++j)
+				writeChannel(block, reference, opl3);
+
+			// Vibrato, tremolo and sometimes the percussion mode
+			if (!(nextRandom() & 7))
+				write(block, reference, 0xBD, nextRandom());
+
+			const uint samples = 1 + nextRandom() % 1024;
+			if (opl3) {
+				block.GenerateBlock3(samples, blockBuffer);
+				reference.GenerateBlock3(samples, referenceBuffer);
+			} else {
+				block.GenerateBlock2(samples, blockBuffer);
+				reference.GenerateBlock2(samples, referenceBuffer);
+			}
+			TS_ASSERT_SAME_DATA(blockBuffer, referenceBuffer, samples * (opl3 ? 2 : 1) * sizeof(int32));
+		}
+	}
+
+	public:
+	void test_block_synth_opl2() {
+		compare(false, 1);
+		compare(false, 2);
+	}
+
+	void test_block_synth_opl3() {
+		compare(true, 3);
+		compare(true, 4);
+	}
+};
+
+#endif
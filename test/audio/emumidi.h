@@ -0,0 +1,198 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/softsynth/emumidi.h"
+
+#include "common/array.h"
+#include "common/system.h"
+
+// MidiDriver_Emulated needs an OSystem for its mutex. This one only has the
+// mutexes, which do nothing since the tests run in a single thread.
+class EmuMidiTestSystem : public OSystem {
+public:
+	const GraphicsMode *getSupportedGraphicsModes() const { return 0; }
+	int getDefaultGraphicsMode() const { return 0; }
+	bool setGraphicsMode(int mode) { return false; }
+	int getGraphicsMode() const { return 0; }
+	Graphics::PixelFormat getScreenFormat() const { return Graphics::PixelFormat::createFormatCLUT8(); }
+	Common::List<Graphics::PixelFormat> getSupportedFormats() const { return Common::List<Graphics::PixelFormat>(); }
+	void initSize(uint width, uint height, const Graphics::PixelFormat *format) {}
+	int16 getHeight() { return 0; }
+	int16 getWidth() { return 0; }
+	PaletteManager *getPaletteManager() { return 0; }
+	void copyRectToScreen(const void *buf, int pitch, int x, int y, int w, int h) {}
+	Graphics::Surface *lockScreen() { return 0; }
+	void unlockScreen() {}
+	void fillScreen(uint32 col) {}
+	void updateScreen() {}
+	void setShakePos(int shakeOffset) {}
+	void showOverlay() {}
+	void hideOverlay() {}
+	Graphics::PixelFormat getOverlayFormat() const { return Graphics::PixelFormat::createFormatCLUT8(); }
+	void clearOverlay() {}
+	void grabOverlay(void *buf, int pitch) {}
+	void copyRectToOverlay(const void *buf, int pitch, int x, int y, int w, int h) {}
+	int16 getOverlayHeight() { return 0; }
+	int16 getOverlayWidth() { return 0; }
+	bool showMouse(bool visible) { return false; }
+	void warpMouse(int x, int y) {}
+	void setMouseCursor(const void *buf, uint w, uint h, int hotspotX, int hotspotY, uint32 keycolor, bool dontScale, const Graphics::PixelFormat *format) {}
+	uint32 getMillis() { return 0; }
+	void delayMillis(uint msecs) {}
+	void getTimeAndDate(TimeDate &t) const {}
+	MutexRef createMutex() { return (MutexRef)this; }
+	void lockMutex(MutexRef mutex) {}
+	void unlockMutex(MutexRef mutex) {}
+	void deleteMutex(MutexRef mutex) {}
+	Audio::Mixer *getMixer() { return 0; }
+	void quit() {}
+	void displayMessageOnOSD(const char *msg) {}
+	void logMessage(LogMessageType::Type type, const char *message) {}
+};
+
+// A mono driver at 1000 Hz, so the timer ticks every 4 samples. The timer
+// writes the number of the tick, the samples are the value written last.
+class EmuMidiTestDriver : public MidiDriver_Emulated {
+public:
+	struct Write {
+		int reg;
+		int value;
+		int samples;	// samples generated before the write
+	};
+
+	Common::Array<Write> _applied;
+	int _value;
+	int _ticks;
+	int _samples;
+	bool _writeInGenerate;
+
+	EmuMidiTestDriver() : MidiDriver_Emulated(0), _value(0), _ticks(0), _samples(0), _writeInGenerate(false) {}
+
+	int open() {
+		MidiDriver_Emulated::open();
+		setRegisterQueueEnabled(true);
+		return 0;
+	}
+
+	void close() {}
+	void send(uint32 b) { writeRegister(1, b); }
+	MidiChannel *allocateChannel() { return 0; }
+	MidiChannel *getPercussionChannel() { return 0; }
+
+	bool isStereo() const { return false; }
+	int getRate() const { return 1000; }
+
+protected:
+	void generateSamples(int16 *buf, int len) {
+		// Writes from inside the synth are applied right away
+		if (_writeInGenerate)
+			writeRegister(2, _samples);
+
+		for (int i = 0; i < len; ++i)
+			buf[i] = _value;
+		_samples += len;
+	}
+
+	void onTimer() {
+		writeRegister(0, _ticks++);
+	}
+
+	void applyRegisterWrite(int reg, int value) {
+		Write write;
+		write.reg = reg;
+		write.value = value;
+		write.samples = _samples;
+		_applied.push_back(write);
+
+		if (reg != 2)
+			_value = value;
+	}
+};
+
+class EmuMidiTestSuite : public CxxTest::TestSuite {
+	OSystem *_oldSystem;
+	EmuMidiTestSystem *_system;
+
+public:
+	void setUp() {
+		_oldSystem = g_system;
+		_system = new EmuMidiTestSystem();
+		g_system = _system;
+	}
+
+	void tearDown() {
+		g_system = _oldSystem;
+		delete _system;
+	}
+
+	void test_queued_write_timing() {
+		EmuMidiTestDriver driver;
+		driver.open();
+
+		int16 buffer[16];
+		driver.readBuffer(buffer, 16);
+
+		// The ticks happen at samples 0, 4, 8, 12 and 16, the last one
+		// after the whole buffer has been generated
+		TS_ASSERT_EQUALS(driver._applied.size(), 5u);
+		for (uint i = 0; i < driver._applied.size(); ++i) {
+			TS_ASSERT_EQUALS(driver._applied[i].reg, 0);
+			TS_ASSERT_EQUALS(driver._applied[i].value, (int)i);
+			TS_ASSERT_EQUALS(driver._applied[i].samples, (int)i * 4);
+		}
+		for (int i = 0; i < 16; ++i)
+			TS_ASSERT_EQUALS(buffer[i], i / 4);
+
+		// The next buffer continues with the last tick, and its first tick
+		// is at sample 4
+		driver.readBuffer(buffer, 8);
+		TS_ASSERT_EQUALS(buffer[0], 4);
+		TS_ASSERT_EQUALS(buffer[3], 4);
+		TS_ASSERT_EQUALS(buffer[4], 5);
+		TS_ASSERT_EQUALS(buffer[7], 5);
+	}
+
+	void test_queued_write_order() {
+		EmuMidiTestDriver driver;
+		driver.open();
+
+		// Writes made between buffers are applied at the start of the next
+		// one, in the order they were made and before the first tick
+		driver.send(100);
+		driver.send(101);
+		TS_ASSERT(driver._applied.empty());
+
+		int16 buffer[8];
+		driver.readBuffer(buffer, 8);
+
+		TS_ASSERT_EQUALS(driver._applied.size(), 5u);
+		TS_ASSERT_EQUALS(driver._applied[0].reg, 1);
+		TS_ASSERT_EQUALS(driver._applied[0].value, 100);
+		TS_ASSERT_EQUALS(driver._applied[1].reg, 1);
+		TS_ASSERT_EQUALS(driver._applied[1].value, 101);
+		TS_ASSERT_EQUALS(driver._applied[2].reg, 0);
+		TS_ASSERT_EQUALS(driver._applied[2].value, 0);
+		TS_ASSERT_EQUALS(driver._applied[2].samples, 0);
+	}
+
+	void test_write_in_generate() {
+		EmuMidiTestDriver driver;
+		driver.open();
+		driver._writeInGenerate = true;
+
+		int16 buffer[8];
+		driver.readBuffer(buffer, 8);
+
+		// The synth's own writes are not queued, they come right before
+		// the samples generated after each tick
+		TS_ASSERT_EQUALS(driver._applied.size(), 5u);
+		TS_ASSERT_EQUALS(driver._applied[0].reg, 0);
+		TS_ASSERT_EQUALS(driver._applied[1].reg, 2);
+		TS_ASSERT_EQUALS(driver._applied[1].value, 0);
+		TS_ASSERT_EQUALS(driver._applied[2].reg, 0);
+		TS_ASSERT_EQUALS(driver._applied[2].samples, 4);
+		TS_ASSERT_EQUALS(driver._applied[3].reg, 2);
+		TS_ASSERT_EQUALS(driver._applied[3].value, 4);
+		TS_ASSERT_EQUALS(driver._applied[4].reg, 0);
+		TS_ASSERT_EQUALS(driver._applied[4].samples, 8);
+	}
+};
@@ -0,0 +1,196 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/opldump.h"
+#include "audio/softsynth/opl/dosbox.h"
+
+#include "common/array.h"
+#include "common/memstream.h"
+
+#ifndef DISABLE_DOSBOX_OPL
+
+// Records the register writes to one emulator while sending them to another
+// one too, and then replays them on a third.
+class OPLDumpTestSuite : public CxxTest::TestSuite
+{
+	uint32 _seed;
+
+	uint32 nextRandom() {
+		_seed = _seed * 1103515245 + 12345;
+		return _seed >> 16;
+	}
+
+	// Picks how a write is made: through writeReg() when 0, else the base port.
+	// The chips of a Dual OPL2 each have their own ports, 0x388 writes to both.
+	int randomPort(OPL::Config::OplType type) {
+		static const int dualPorts[3] = { 0x220, 0x222, 0x388 };
+
+		if (!(nextRandom() & 1))
+			return 0;
+		return (type == OPL::Config::kDualOpl2) ? dualPorts[nextRandom() % 3] : 0x388;
+	}
+
+	// Keys a random channel on or off with a random instrument
+	void writeChannel(OPL::Config::OplType type, OPL::OPL &a, OPL::OPL &b) {
+		static const uint8 opOffsets[9] = { 0x00, 0x01, 0x02, 0x08, 0x09, 0x0A, 0x10, 0x11, 0x12 };
+
+		const uint channel = nextRandom() % 9;
+		const int port = randomPort(type);
+		for (uint op = 0; op < 2; ++op) {
+			const uint32 offset = opOffsets[channel] + op * 3;
+			write(a, b, port, 0x20 + offset, nextRandom() & 0xFF);
+			write(a, b, port, 0x40 + offset, nextRandom() & 0x3F);
+			write(a, b, port, 0x60 + offset, nextRandom() & 0xFF);
+			write(a, b, port, 0x80 + offset, nextRandom() & 0xFF);
+		}
+		write(a, b, port, 0xA0 + channel, nextRandom() & 0xFF);
+		write(a, b, port, 0xC0 + channel, (nextRandom() & 0x0F) | 0x30);
+		write(a, b, port, 0xB0 + channel, nextRandom() & 0x3F);
+	}
+
+	// Sets one of the timer counters, which must not end up in the dump. The
+	// control register 0x04 is left alone, since the emulator would need an
+	// OSystem for it. Through writeReg(), the OPL2 ignores the upper bits of
+	// the register and the Dual OPL2 writes to both chips.
+	void writeTimer(OPL::Config::OplType type, OPL::OPL &a, OPL::OPL &b) {
+		const int port = randomPort(type);
+		int reg = 0x02 + (nextRandom() & 1);
+		if (!port && type != OPL::Config::kOpl3 && (nextRandom() & 1))
+			reg |= 0x100;
+		write(a, b, port, reg, nextRandom() & 0xFF);
+	}
+
+	void write(OPL::OPL &a, OPL::OPL &b, int port, int reg, int val) {
+		if (port) {
+			a.write(port, reg);
+			a.write(port + 1, val);
+			b.write(port, reg);
+			b.write(port + 1, val);
+		} else {
+			a.writeReg(reg, val);
+			b.writeReg(reg, val);
+		}
+	}
+
+	// Follows the register selection of the chips through the dump and
+	// returns false if a timer register is written
+	bool checkNoTimerWrites(OPL::Config::OplType type, Common::SeekableReadStream &stream) {
+		const bool dual = type == OPL::Config::kDualOpl2;
+		uint16 address[2] = { 0, 0 };
+
+		stream.skip(6);
+		while (!stream.eos()) {
+			switch (stream.readByte()) {
+			case OPL::kDumpInit:
+			case OPL::kDumpWait:
+				stream.readUint32LE();
+				break;
+
+			case OPL::kDumpWrite: {
+				const uint16 port = stream.readUint16LE();
+				const byte value = stream.readByte();
+				const uint index = dual ? (port & 2) >> 1 : 0;
+				const bool both = dual && (port & 8);
+
+				if (!(port & 1)) {
+					address[index] = value;
+					if (both)
+						address[1] = value;
+				} else if ((address[index] >= 0x02 && address[index] <= 0x04) ||
+				           (both && address[1] >= 0x02 && address[1] <= 0x04)) {
+					return false;
+				}
+				break;
+			}
+
+			case OPL::kDumpWriteReg: {
+				const uint16 reg = stream.readUint16LE();
+				stream.readByte();
+				if (type != OPL::Config::kOpl3 && (reg & 0xFF) >= 0x02 && (reg & 0xFF) <= 0x04)
+					return false;
+				break;
+			}
+
+			case OPL::kDumpEnd:
+				return true;
+
+			default:
+				break;
+			}
+		}
+
+		return false;
+	}
+
+	void captureAndReplay(OPL::Config::OplType type, uint32 seed) {
+		_seed = seed;
+
+		Common::MemoryWriteStreamDynamic dump(DisposeAfterUse::YES);
+		OPL::OPL *direct = new OPL::DOSBox::OPL(type);
+		OPL::OPL *capture = new OPL::CaptureOPL(new OPL::DOSBox::OPL(type), type, &dump, DisposeAfterUse::NO);
+		direct->init(22050);
+		capture->init(22050);
+		if (type == OPL::Config::kOpl3)
+			write(*direct, *capture, 0, 0x105, 1);
+
+		// Both emulators exist at the same time and have to stay in sync
+		Common::Array<int16> output;
+		int16 directBuffer[512], captureBuffer[512];
+		for (uint i = 0; i < 100; ++i) {
+			const uint writes = nextRandom() & 3;
+			for (uint j = 0; j < writes; ++j)
+				writeChannel(type, *direct, *capture);
+			if (!(nextRandom() & 3))
+				writeTimer(type, *direct, *capture);
+
+			const int length = (1 + nextRandom() % 256) * (direct->isStereo() ? 2 : 1);
+			direct->readBuffer(directBuffer, length);
+			capture->readBuffer(captureBuffer, length);
+			TS_ASSERT_SAME_DATA(directBuffer, captureBuffer, length * sizeof(int16));
+
+			for (int j = 0; j < length; ++j)
+				output.push_back(directBuffer[j]);
+		}
+
+		delete capture;
+		delete direct;
+
+		Common::MemoryReadStream check(dump.getData(), dump.size());
+		TS_ASSERT(checkNoTimerWrites(type, check));
+
+		// Replaying has to give the same output, no matter how it is read
+		Common::MemoryReadStream stream(dump.getData(), dump.size());
+		OPL::DumpPlayer player(&stream);
+		OPL::Config::OplType dumpType;
+		TS_ASSERT(player.readHeader(dumpType));
+		TS_ASSERT_EQUALS(dumpType, type);
+
+		OPL::DOSBox::OPL replay(type);
+		Common::Array<int16> replayed;
+		int16 buffer[1000];
+		while (!player.isFinished()) {
+			const int read = player.play(&replay, buffer, 1000);
+			for (int j = 0; j < read; ++j)
+				replayed.push_back(buffer[j]);
+		}
+
+		TS_ASSERT_EQUALS(player.getRate(), 22050);
+		TS_ASSERT_EQUALS(replayed.size(), output.size());
+		if (replayed.size() == output.size())
+			TS_ASSERT_SAME_DATA(replayed.begin(), output.begin(), output.size() * sizeof(int16));
+	}
+
+	public:
+	void test_capture_opl2() {
+		captureAndReplay(OPL::Config::kOpl2, 1);
+	}
+
+	void test_capture_opl3() {
+		captureAndReplay(OPL::Config::kOpl3, 2);
+	}
+
+	void test_capture_dual_opl2() {
+		captureAndReplay(OPL::Config::kDualOpl2, 3);
+	}
+};
+
+#endif
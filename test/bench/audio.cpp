@@ -0,0 +1,179 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+// Benchmarks for the rate converters and the audio decoders in audio/. Only
+// the decoders which do not depend on an external library are covered, since
+// there is no way to create input data for the others here.
+
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+#include "test/bench/bench.h"
+
+#include "audio/audiostream.h"
+#include "audio/rate.h"
+#include "audio/decoders/adpcm.h"
+#include "audio/decoders/raw.h"
+
+#include "common/memstream.h"
+#include "common/util.h"
+
+namespace Bench {
+
+namespace {
+
+enum {
+	kOutputRate = 44100,
+	kOutputFrames = 4096,
+	kDataSize = 64 * 1024,
+	kVolume = 256
+};
+
+// Endless stream of noise, so the converters never run out of input
+class NoiseStream : public Audio::AudioStream {
+public:
+	NoiseStream(int rate, bool stereo) : _rate(rate), _stereo(stereo), _seed(1) {}
+
+	int readBuffer(int16 *buffer, const int numSamples) {
+		for (int i = 0; i < numSamples; ++i)
+			buffer[i] = (int16)random(_seed);
+		return numSamples;
+	}
+
+	bool isStereo() const { return _stereo; }
+	int getRate() const { return _rate; }
+	bool endOfData() const { return false; }
+
+private:
+	int _rate;
+	bool _stereo;
+	uint32 _seed;
+};
+
+class RateConversion : public Benchmark {
+public:
+	RateConversion(const char *name, int inputRate, bool stereo)
+		: Benchmark("audio", name), _input(inputRate, stereo), _converter(0), _inputRate(inputRate), _stereo(stereo) {}
+
+	void setUp() { _converter = Audio::makeRateConverter(_inputRate, kOutputRate, _stereo); }
+
+	void run() {
+		memset(_buffer, 0, sizeof(_buffer));
+		consume(_converter->flow(_input, _buffer, kOutputFrames, kVolume, kVolume));
+	}
+
+	void tearDown() {
+		delete _converter;
+		_converter = 0;
+	}
+
+	// Output data, since that is the same for all converters
+	uint32 getBytesPerRun() const { return sizeof(_buffer); }
+
+private:
+	NoiseStream _input;
+	Audio::RateConverter *_converter;
+	int _inputRate;
+	bool _stereo;
+	Audio::st_sample_t _buffer[kOutputFrames * 2];
+};
+
+// Decodes a block of random data front to back
+class Decoder : public Benchmark {
+public:
+	Decoder(const char *name) : Benchmark("audio", name) {}
+
+	void setUp() { fillRandom(_data, kDataSize); }
+
+	void run() {
+		Audio::AudioStream *stream = createStream(new Common::MemoryReadStream(_data, kDataSize));
+
+		int16 buffer[1024];
+		uint32 samples = 0;
+		while (!stream->endOfData()) {
+			const int count = stream->readBuffer(buffer, ARRAYSIZE(buffer));
+			if (count <= 0)
+				break;
+			samples += count;
+		}
+
+		delete stream;
+		consume(samples);
+	}
+
+	uint32 getBytesPerRun() const { return kDataSize; }
+
+protected:
+	virtual Audio::AudioStream *createStream(Common::SeekableReadStream *data) = 0;
+
+private:
+	byte _data[kDataSize];
+};
+
+class RawDecoder : public Decoder {
+public:
+	RawDecoder(const char *name, byte flags) : Decoder(name), _flags(flags) {}
+
+protected:
+	Audio::AudioStream *createStream(Common::SeekableReadStream *data) {
+		return Audio::makeRawStream(data, 22050, _flags, DisposeAfterUse::YES);
+	}
+
+private:
+	byte _flags;
+};
+
+class ADPCMDecoder : public Decoder {
+public:
+	ADPCMDecoder(const char *name, Audio::ADPCMType type, int channels, uint32 blockAlign)
+		: Decoder(name), _type(type), _channels(channels), _blockAlign(blockAlign) {}
+
+protected:
+	Audio::AudioStream *createStream(Common::SeekableReadStream *data) {
+		return Audio::makeADPCMStream(data, DisposeAfterUse::YES, kDataSize, _type, 22050, _channels, _blockAlign);
+	}
+
+private:
+	Audio::ADPCMType _type;
+	int _channels;
+	uint32 _blockAlign;
+};
+
+} // End of anonymous namespace
+
+void addAudioSuite() {
+	addBenchmark(new RateConversion("rate_copy_stereo", 44100, true));
+	addBenchmark(new RateConversion("rate_11025_mono", 11025, false));
+	addBenchmark(new RateConversion("rate_22050_mono", 22050, false));
+	addBenchmark(new RateConversion("rate_22050_stereo", 22050, true));
+	addBenchmark(new RateConversion("rate_48000_stereo", 48000, true));
+
+	addBenchmark(new RawDecoder("raw_8bit_unsigned_mono", Audio::FLAG_UNSIGNED));
+	addBenchmark(new RawDecoder("raw_16bit_le_stereo", Audio::FLAG_16BITS | Audio::FLAG_LITTLE_ENDIAN | Audio::FLAG_STEREO));
+
+	addBenchmark(new ADPCMDecoder("adpcm_oki", Audio::kADPCMOki, 1, 0));
+	addBenchmark(new ADPCMDecoder("adpcm_dvi", Audio::kADPCMDVI, 1, 0));
+	addBenchmark(new ADPCMDecoder("adpcm_ms_ima", Audio::kADPCMMSIma, 2, 2048));
+	addBenchmark(new ADPCMDecoder("adpcm_ms", Audio::kADPCMMS, 2, 2048));
+	addBenchmark(new ADPCMDecoder("adpcm_apple", Audio::kADPCMApple, 1, 34));
+}
+
+} // End of namespace Bench
@@ -0,0 +1,216 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+// Micro benchmark runner. Every benchmark is first run in batches of growing
+// size until a batch takes at least the minimum sample time. The batch size
+// found this way is then used for the warmup and the measured repetitions.
+// The minimum and the median time per call of all repetitions are reported,
+// either as a table or as JSON.
+//
+// Usage: bench [--json] [--filter=TEXT] [--repetitions=NUM] [--warmup=NUM]
+//              [--min-time=MSECS]
+
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+#include "test/bench/bench.h"
+
+#include "common/algorithm.h"
+#include "common/array.h"
+#include "common/str.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+static Common::Array<Bench::Benchmark *> s_benchmarks;
+
+namespace Bench {
+
+static volatile uint32 s_sink = 0;
+
+void addBenchmark(Benchmark *benchmark) {
+	s_benchmarks.push_back(benchmark);
+}
+
+void consume(uint32 value) {
+	s_sink += value;
+}
+
+uint32 random(uint32 &seed) {
+	seed = seed * 1103515245 + 12345;
+	return seed >> 8;
+}
+
+void fillRandom(byte *buf, uint32 size, uint32 seed) {
+	for (uint32 i = 0; i < size; ++i)
+		buf[i] = random(seed) & 0xFF;
+}
+
+} // End of namespace Bench
+
+struct Options {
+	bool json;
+	const char *filter;
+	int repetitions;
+	int warmup;
+	double minTime;
+};
+
+struct Result {
+	uint32 iterations;
+	double min;
+	double median;
+	double mean;
+};
+
+static double getSeconds() {
+	struct timeval tv;
+	gettimeofday(&tv, 0);
+	return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+static double runBatch(Bench::Benchmark *benchmark, uint32 iterations) {
+	double start = getSeconds();
+	for (uint32 i = 0; i < iterations; ++i)
+		benchmark->run();
+	return getSeconds() - start;
+}
+
+static Result measure(Bench::Benchmark *benchmark, const Options &options) {
+	Result result;
+
+	// Find a batch size which takes long enough to be measured reliably.
+	// This also serves as the first part of the warmup.
+	result.iterations = 1;
+	while (runBatch(benchmark, result.iterations) < options.minTime && result.iterations < (1U << 30))
+		result.iterations *= 2;
+
+	for (int i = 0; i < options.warmup; ++i)
+		runBatch(benchmark, result.iterations);
+
+	// Seconds per call of every repetition
+	Common::Array<double> samples;
+	double total = 0;
+	for (int i = 0; i < options.repetitions; ++i) {
+		double time = runBatch(benchmark, result.iterations) / result.iterations;
+		samples.push_back(time);
+		total += time;
+	}
+
+	Common::sort(samples.begin(), samples.end());
+
+	const uint count = samples.size();
+	result.min = samples[0];
+	result.median = (count & 1) ? samples[count / 2] : (samples[count / 2 - 1] + samples[count / 2]) / 2;
+	result.mean = total / count;
+
+	return result;
+}
+
+static void printUsage(const char *name) {
+	printf("Usage: %s [--json] [--filter=TEXT] [--repetitions=NUM] [--warmup=NUM] [--min-time=MSECS]\n", name);
+}
+
+static bool parseOptions(int argc, char *argv[], Options &options) {
+	options.json = false;
+	options.filter = 0;
+	options.repetitions = 9;
+	options.warmup = 2;
+	options.minTime = 0.02;
+
+	for (int i = 1; i < argc; ++i) {
+		const char *arg = argv[i];
+
+		if (!strcmp(arg, "--json"))
+			options.json = true;
+		else if (!strncmp(arg, "--filter=", 9))
+			options.filter = arg + 9;
+		else if (!strncmp(arg, "--repetitions=", 14))
+			options.repetitions = MAX(atoi(arg + 14), 1);
+		else if (!strncmp(arg, "--warmup=", 9))
+			options.warmup = MAX(atoi(arg + 9), 0);
+		else if (!strncmp(arg, "--min-time=", 11))
+			options.minTime = MAX(atoi(arg + 11), 1) / 1000.0;
+		else
+			return false;
+	}
+
+	return true;
+}
+
+int main(int argc, char *argv[]) {
+	Options options;
+	if (!parseOptions(argc, argv, options)) {
+		printUsage(argv[0]);
+		return 1;
+	}
+
+	Bench::addCommonSuite();
+	Bench::addGraphicsSuite();
+	Bench::addAudioSuite();
+	Bench::addOPLSuite();
+
+	if (options.json)
+		printf("{\"repetitions\":%d,\"warmup\":%d,\"benchmarks\":[", options.repetitions, options.warmup);
+	else
+		printf("%-40s %12s %12s %10s\n", "benchmark", "min (ns)", "median (ns)", "MB/s");
+
+	bool first = true;
+	for (uint i = 0; i < s_benchmarks.size(); ++i) {
+		Bench::Benchmark *benchmark = s_benchmarks[i];
+		const Common::String name = Common::String::format("%s/%s", benchmark->getSuite(), benchmark->getName());
+
+		if (options.filter && !strstr(name.c_str(), options.filter))
+			continue;
+
+		benchmark->setUp();
+		const Result result = measure(benchmark, options);
+		benchmark->tearDown();
+
+		// Throughput is based on the fastest repetition
+		const uint32 bytes = benchmark->getBytesPerRun();
+		const double throughput = bytes ? bytes / result.min / (1024.0 * 1024.0) : 0.0;
+
+		if (options.json) {
+			printf("%s\n{\"suite\":\"%s\",\"name\":\"%s\",\"iterations\":%u,\"min_ns\":%.1f,\"median_ns\":%.1f,\"mean_ns\":%.1f,\"bytes\":%u,\"mb_per_s\":%.1f}",
+			       first ? "" : ",", benchmark->getSuite(), benchmark->getName(), result.iterations,
+			       result.min * 1e9, result.median * 1e9, result.mean * 1e9, bytes, throughput);
+		} else {
+			printf("%-40s %12.1f %12.1f", name.c_str(), result.min * 1e9, result.median * 1e9);
+			if (bytes)
+				printf(" %10.1f", throughput);
+			printf("\n");
+		}
+		fflush(stdout);
+
+		first = false;
+	}
+
+	if (options.json)
+		printf("\n]}\n");
+
+	for (uint i = 0; i < s_benchmarks.size(); ++i)
+		delete s_benchmarks[i];
+
+	return 0;
+}
@@ -0,0 +1,87 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef TEST_BENCH_BENCH_H
+#define TEST_BENCH_BENCH_H
+
+#include "common/scummsys.h"
+
+namespace Bench {
+
+/**
+ * A single micro benchmark.
+ *
+ * The runner calls setUp() once, then run() repeatedly in timed batches and
+ * finally tearDown(). Everything which should not be measured, like filling
+ * input buffers, belongs into setUp().
+ */
+class Benchmark {
+public:
+	Benchmark(const char *suite, const char *name) : _suite(suite), _name(name) {}
+	virtual ~Benchmark() {}
+
+	const char *getSuite() const { return _suite; }
+	const char *getName() const { return _name; }
+
+	virtual void setUp() {}
+	virtual void run() = 0;
+	virtual void tearDown() {}
+
+	/**
+	 * Returns the amount of data processed by a single call to run(). If this
+	 * is not zero, the throughput is reported as well.
+	 */
+	virtual uint32 getBytesPerRun() const { return 0; }
+
+private:
+	const char *_suite;
+	const char *_name;
+};
+
+/**
+ * Adds a benchmark to the list of benchmarks to run. The runner takes
+ * ownership of it.
+ */
+void addBenchmark(Benchmark *benchmark);
+
+/**
+ * Benchmarks should pass their results to this function, so that the
+ * compiler can not optimize away the work done.
+ */
+void consume(uint32 value);
+
+/**
+ * Returns a reproducible pseudo random number sequence, so all benchmarks
+ * see the same input data on every run.
+ */
+uint32 random(uint32 &seed);
+void fillRandom(byte *buf, uint32 size, uint32 seed = 12345);
+
+// Suites
+void addCommonSuite();
+void addGraphicsSuite();
+void addAudioSuite();
+void addOPLSuite();
+
+} // End of namespace Bench
+
+#endif
@@ -0,0 +1,315 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+// Benchmarks for the containers, strings, streams, MD5 and zlib code in common/
+
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+#include "test/bench/bench.h"
+
+#include "common/array.h"
+#include "common/bufferedstream.h"
+#include "common/hash-str.h"
+#include "common/hashmap.h"
+#include "common/md5.h"
+#include "common/memstream.h"
+#include "common/str.h"
+#include "common/zlib.h"
+
+namespace Bench {
+
+namespace {
+
+enum {
+	kNumKeys = 4096,
+	kNumStrings = 1024,
+	kStreamSize = 256 * 1024
+};
+
+class HashMapInsert : public Benchmark {
+public:
+	HashMapInsert() : Benchmark("common", "hashmap_insert_uint") {}
+
+	void setUp() {
+		uint32 seed = 1;
+		for (uint i = 0; i < kNumKeys; ++i)
+			_keys[i] = random(seed);
+	}
+
+	void run() {
+		Common::HashMap<uint32, uint32> map;
+		for (uint i = 0; i < kNumKeys; ++i)
+			map[_keys[i]] = i;
+		consume(map.size());
+	}
+
+private:
+	uint32 _keys[kNumKeys];
+};
+
+class HashMapLookup : public Benchmark {
+public:
+	HashMapLookup() : Benchmark("common", "hashmap_lookup_uint") {}
+
+	void setUp() {
+		uint32 seed = 1;
+		for (uint i = 0; i < kNumKeys; ++i) {
+			_keys[i] = random(seed);
+			_map[_keys[i]] = i;
+		}
+	}
+
+	void run() {
+		uint32 sum = 0;
+		for (uint i = 0; i < kNumKeys; ++i)
+			sum += _map.getVal(_keys[i]);
+		consume(sum);
+	}
+
+	void tearDown() { _map.clear(); }
+
+private:
+	uint32 _keys[kNumKeys];
+	Common::HashMap<uint32, uint32> _map;
+};
+
+// The typical resource name lookup, case insensitive as in SearchSet
+class HashMapLookupString : public Benchmark {
+public:
+	HashMapLookupString() : Benchmark("common", "hashmap_lookup_string") {}
+
+	void setUp() {
+		for (uint i = 0; i < kNumStrings; ++i) {
+			_keys.push_back(Common::String::format("RESOURCE.%03d", i));
+			_map[_keys[i]] = i;
+		}
+	}
+
+	void run() {
+		uint32 sum = 0;
+		for (uint i = 0; i < kNumStrings; ++i)
+			sum += _map.getVal(_keys[i]);
+		consume(sum);
+	}
+
+	void tearDown() {
+		_map.clear();
+		_keys.clear();
+	}
+
+private:
+	Common::Array<Common::String> _keys;
+	Common::HashMap<Common::String, uint32, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> _map;
+};
+
+class StringAppend : public Benchmark {
+public:
+	StringAppend() : Benchmark("common", "string_append") {}
+
+	void run() {
+		Common::String str;
+		for (uint i = 0; i < kNumStrings; ++i)
+			str += (char)('a' + (i & 15));
+		consume(str.size());
+	}
+};
+
+class StringFormat : public Benchmark {
+public:
+	StringFormat() : Benchmark("common", "string_format") {}
+
+	void run() {
+		uint32 size = 0;
+		for (uint i = 0; i < 64; ++i)
+			size += Common::String::format("%s.%03d", "savegame", i).size();
+		consume(size);
+	}
+};
+
+class StringCompare : public Benchmark {
+public:
+	StringCompare() : Benchmark("common", "string_equals_ignore_case") {}
+
+	void setUp() {
+		for (uint i = 0; i < kNumStrings; ++i) {
+			_a.push_back(Common::String::format("Resource.%03d", i));
+			_b.push_back(Common::String::format("RESOURCE.%03d", i));
+		}
+	}
+
+	void run() {
+		uint32 count = 0;
+		for (uint i = 0; i < kNumStrings; ++i)
+			count += _a[i].equalsIgnoreCase(_b[i]) ? 1 : 0;
+		consume(count);
+	}
+
+	void tearDown() {
+		_a.clear();
+		_b.clear();
+	}
+
+private:
+	Common::Array<Common::String> _a, _b;
+};
+
+class ArrayPushBack : public Benchmark {
+public:
+	ArrayPushBack() : Benchmark("common", "array_push_back") {}
+
+	void run() {
+		Common::Array<uint32> array;
+		for (uint i = 0; i < kNumKeys; ++i)
+			array.push_back(i);
+		consume(array.size());
+	}
+};
+
+class ArrayInsertFront : public Benchmark {
+public:
+	ArrayInsertFront() : Benchmark("common", "array_insert_front") {}
+
+	void run() {
+		Common::Array<uint32> array;
+		for (uint i = 0; i < 256; ++i)
+			array.insert_at(0, i);
+		consume(array.size());
+	}
+};
+
+// Base class for all benchmarks working on a block of random data
+class StreamBenchmark : public Benchmark {
+public:
+	StreamBenchmark(const char *name) : Benchmark("common", name) {}
+
+	void setUp() { fillRandom(_data, kStreamSize); }
+	uint32 getBytesPerRun() const { return kStreamSize; }
+
+protected:
+	byte _data[kStreamSize];
+};
+
+class MemoryStreamRead : public StreamBenchmark {
+public:
+	MemoryStreamRead() : StreamBenchmark("memorystream_read_uint32") {}
+
+	void run() {
+		Common::MemoryReadStream stream(_data, kStreamSize);
+		uint32 sum = 0;
+		for (uint i = 0; i < kStreamSize / 4; ++i)
+			sum += stream.readUint32LE();
+		consume(sum);
+	}
+};
+
+class BufferedStreamRead : public StreamBenchmark {
+public:
+	BufferedStreamRead() : StreamBenchmark("bufferedstream_read_byte") {}
+
+	void run() {
+		Common::SeekableReadStream *stream = Common::wrapBufferedSeekableReadStream(
+			new Common::MemoryReadStream(_data, kStreamSize), 4096, DisposeAfterUse::YES);
+		uint32 sum = 0;
+		for (uint i = 0; i < kStreamSize; ++i)
+			sum += stream->readByte();
+		delete stream;
+		consume(sum);
+	}
+};
+
+class MD5 : public StreamBenchmark {
+public:
+	MD5() : StreamBenchmark("md5") {}
+
+	void run() {
+		Common::MemoryReadStream stream(_data, kStreamSize);
+		uint8 digest[16];
+		Common::computeStreamMD5(stream, digest);
+		consume(digest[0]);
+	}
+};
+
+#ifdef USE_ZLIB
+class ZlibInflate : public Benchmark {
+public:
+	ZlibInflate() : Benchmark("common", "zlib_inflate"), _compressed(0), _compressedSize(0) {}
+
+	void setUp() {
+		// Data with a small alphabet and some repetitions, which compresses
+		// about as well as typical game data
+		uint32 seed = 1;
+		for (uint i = 0; i < kStreamSize; ++i)
+			_data[i] = (i && (random(seed) & 0x100)) ? _data[i / 2] : ('a' + (random(seed) & 15));
+
+		Common::MemoryWriteStreamDynamic *out = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::NO);
+		Common::WriteStream *compressed = Common::wrapCompressedWriteStream(out);
+		compressed->write(_data, kStreamSize);
+		compressed->finalize();
+
+		// The compressed stream owns the memory stream, but not its data
+		_compressed = out->getData();
+		_compressedSize = out->size();
+		delete compressed;
+	}
+
+	void run() {
+		Common::SeekableReadStream *stream = Common::wrapCompressedReadStream(
+			new Common::MemoryReadStream(_compressed, _compressedSize), kStreamSize);
+		uint32 size = stream->read(_data, kStreamSize);
+		delete stream;
+		consume(size);
+	}
+
+	void tearDown() {
+		free(_compressed);
+		_compressed = 0;
+	}
+
+	uint32 getBytesPerRun() const { return kStreamSize; }
+
+private:
+	byte _data[kStreamSize];
+	byte *_compressed;
+	uint32 _compressedSize;
+};
+#endif
+
+} // End of anonymous namespace
+
+void addCommonSuite() {
+	addBenchmark(new HashMapInsert());
+	addBenchmark(new HashMapLookup());
+	addBenchmark(new HashMapLookupString());
+	addBenchmark(new StringAppend());
+	addBenchmark(new StringFormat());
+	addBenchmark(new StringCompare());
+	addBenchmark(new ArrayPushBack());
+	addBenchmark(new ArrayInsertFront());
+	addBenchmark(new MemoryStreamRead());
+	addBenchmark(new BufferedStreamRead());
+	addBenchmark(new MD5());
+#ifdef USE_ZLIB
+	addBenchmark(new ZlibInflate());
+#endif
+}
+
+} // End of namespace Bench
@@ -0,0 +1,150 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+// Conversion throughput benchmark for Graphics::crossBlit. Every format pair
+// is converted with crossBlit and with a plain per pixel conversion through
+// PixelFormat, which is what crossBlit does for pairs without a fast path.
+//
+// Usage: crossblit [repetitions]
+
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+#include "common/scummsys.h"
+#include "common/util.h"
+#include "graphics/conversion.h"
+#include "graphics/pixelformat.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+enum {
+	kWidth = 640,
+	kHeight = 480
+};
+
+struct NamedFormat {
+	const char *name;
+	Graphics::PixelFormat format;
+};
+
+static double getSeconds() {
+	struct timeval tv;
+	gettimeofday(&tv, 0);
+	return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+static uint32 readPixel(const byte *p, uint bpp) {
+	return (bpp == 2) ? *(const uint16 *)p : *(const uint32 *)p;
+}
+
+static void writePixel(byte *p, uint bpp, uint32 color) {
+	if (bpp == 2)
+		*(uint16 *)p = color;
+	else
+		*(uint32 *)p = color;
+}
+
+static void convertGeneric(byte *dst, const byte *src, const Graphics::PixelFormat &dstFmt, const Graphics::PixelFormat &srcFmt) {
+	for (uint i = 0; i < kWidth * kHeight; ++i) {
+		byte a, r, g, b;
+		srcFmt.colorToARGB(readPixel(src, srcFmt.bytesPerPixel), a, r, g, b);
+		writePixel(dst, dstFmt.bytesPerPixel, dstFmt.ARGBToColor(a, r, g, b));
+		src += srcFmt.bytesPerPixel;
+		dst += dstFmt.bytesPerPixel;
+	}
+}
+
+static void convertCrossBlit(byte *dst, const byte *src, const Graphics::PixelFormat &dstFmt, const Graphics::PixelFormat &srcFmt) {
+	Graphics::crossBlit(dst, src, kWidth * dstFmt.bytesPerPixel, kWidth * srcFmt.bytesPerPixel, kWidth, kHeight, dstFmt, srcFmt);
+}
+
+typedef void (*ConvertProc)(byte *dst, const byte *src, const Graphics::PixelFormat &dstFmt, const Graphics::PixelFormat &srcFmt);
+
+// Returns the best frame rate of all repetitions
+static double measure(ConvertProc proc, byte *dst, const byte *src, const Graphics::PixelFormat &dstFmt, const Graphics::PixelFormat &srcFmt, int repetitions) {
+	const int frames = 20;
+	double best = 0;
+
+	for (int i = 0; i < repetitions; ++i) {
+		double start = getSeconds();
+		for (int f = 0; f < frames; ++f)
+			proc(dst, src, dstFmt, srcFmt);
+		double time = getSeconds() - start;
+		if (i == 0 || time < best)
+			best = time;
+	}
+
+	return best > 0 ? frames / best : 0.0;
+}
+
+int main(int argc, char *argv[]) {
+	const int repetitions = (argc > 1) ? MAX(atoi(argv[1]), 1) : 5;
+
+	static const NamedFormat formats[] = {
+		{ "RGB565",   Graphics::PixelFormat(2, 5, 6, 5, 0, 11,  5,  0,  0) },
+		{ "BGR565",   Graphics::PixelFormat(2, 5, 6, 5, 0,  0,  5, 11,  0) },
+		{ "RGB555",   Graphics::PixelFormat(2, 5, 5, 5, 0, 10,  5,  0,  0) },
+		{ "RGBA4444", Graphics::PixelFormat(2, 4, 4, 4, 4, 12,  8,  4,  0) },
+		{ "XRGB8888", Graphics::PixelFormat(4, 8, 8, 8, 0, 16,  8,  0,  0) },
+		{ "ARGB8888", Graphics::PixelFormat(4, 8, 8, 8, 8, 16,  8,  0, 24) },
+		{ "RGBA8888", Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16,  8,  0) },
+		{ "ABGR8888", Graphics::PixelFormat(4, 8, 8, 8, 8,  0,  8, 16, 24) }
+	};
+
+	byte *src = (byte *)malloc(kWidth * kHeight * 4);
+	byte *dstGeneric = (byte *)malloc(kWidth * kHeight * 4);
+	byte *dstCrossBlit = (byte *)malloc(kWidth * kHeight * 4);
+
+	uint32 seed = 12345;
+	for (uint i = 0; i < kWidth * kHeight * 4; ++i) {
+		seed = seed * 1103515245 + 12345;
+		src[i] = seed >> 24;
+	}
+
+	printf("%dx%d frames per second, best of %d\n", kWidth, kHeight, repetitions);
+	printf("%-8s -> %-8s %10s %10s %8s\n", "source", "dest", "generic", "crossBlit", "speedup");
+
+	for (int i = 0; i < ARRAYSIZE(formats); ++i) {
+		for (int j = 0; j < ARRAYSIZE(formats); ++j) {
+			if (i == j)
+				continue;
+
+			const Graphics::PixelFormat &srcFmt = formats[i].format;
+			const Graphics::PixelFormat &dstFmt = formats[j].format;
+
+			const double generic = measure(convertGeneric, dstGeneric, src, dstFmt, srcFmt, repetitions);
+			const double fast = measure(convertCrossBlit, dstCrossBlit, src, dstFmt, srcFmt, repetitions);
+			const bool match = !memcmp(dstGeneric, dstCrossBlit, kWidth * kHeight * dstFmt.bytesPerPixel);
+
+			printf("%-8s -> %-8s %10.1f %10.1f %7.2fx%s\n", formats[i].name, formats[j].name,
+			       generic, fast, generic > 0 ? fast / generic : 0.0, match ? "" : "  MISMATCH");
+		}
+	}
+
+	free(src);
+	free(dstGeneric);
+	free(dstCrossBlit);
+
+	return 0;
+}
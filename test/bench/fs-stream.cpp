@@ -0,0 +1,159 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+// Read throughput benchmark comparing the stdio based file stream with the
+// memory mapped one used for large files by the POSIX filesystem backend.
+//
+// Usage: fs-stream <file> [repetitions]
+
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+#include "common/scummsys.h"
+
+#if defined(POSIX) && !defined(DISABLE_MMAP_FILESTREAM)
+
+#include "backends/fs/posix/posix-mmapstream.h"
+#include "backends/fs/stdiostream.h"
+#include "common/util.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+
+static double getSeconds() {
+	struct timeval tv;
+	gettimeofday(&tv, 0);
+	return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+typedef Common::SeekableReadStream *(*OpenProc)(const Common::String &path);
+
+static Common::SeekableReadStream *openStdio(const Common::String &path) {
+	return StdioStream::makeFromPath(path, false);
+}
+
+static Common::SeekableReadStream *openMmap(const Common::String &path) {
+	return PosixMmapStream::makeFromPath(path);
+}
+
+// Reads the whole file front to back in blocks of the given size
+static uint32 readSequential(Common::SeekableReadStream *stream, uint32 blockSize) {
+	static byte buf[65536];
+	uint32 total = 0;
+
+	stream->seek(0);
+	while (!stream->eos())
+		total += stream->read(buf, blockSize);
+
+	return total;
+}
+
+// Reads small records at random offsets, the typical resource lookup pattern
+static uint32 readRandom(Common::SeekableReadStream *stream, uint32 count) {
+	const int32 size = stream->size();
+	uint32 seed = 12345;
+	uint32 total = 0;
+
+	for (uint32 i = 0; i < count; ++i) {
+		// Simple LCG, so both streams see the same access pattern
+		seed = seed * 1103515245 + 12345;
+		stream->seek((seed >> 8) % size);
+		total += stream->readUint32LE() & 1;
+		total += stream->readUint16BE() & 1;
+		total += stream->size() > 0;
+	}
+
+	return total;
+}
+
+static void runBenchmark(const char *name, OpenProc openProc, const Common::String &path, int repetitions) {
+	Common::SeekableReadStream *stream = openProc(path);
+	if (!stream) {
+		printf("%-6s could not open '%s'\n", name, path.c_str());
+		return;
+	}
+
+	const double fileMB = stream->size() / (1024.0 * 1024.0);
+	const uint32 randomReads = 100000;
+	static const uint32 blockSizes[] = { 16, 4096, 65536 };
+
+	for (int b = 0; b < ARRAYSIZE(blockSizes); ++b) {
+		double best = 0;
+		for (int i = 0; i < repetitions; ++i) {
+			double start = getSeconds();
+			readSequential(stream, blockSizes[b]);
+			double time = getSeconds() - start;
+			if (i == 0 || time < best)
+				best = time;
+		}
+
+		printf("%-6s sequential %5d byte blocks: %10.1f MB/s\n", name, blockSizes[b], best > 0 ? fileMB / best : 0.0);
+	}
+
+	double best = 0;
+	for (int i = 0; i < repetitions; ++i) {
+		double start = getSeconds();
+		readRandom(stream, randomReads);
+		double time = getSeconds() - start;
+		if (i == 0 || time < best)
+			best = time;
+	}
+
+	printf("%-6s random seek + read:          %10.0f reads/s\n", name, best > 0 ? randomReads / best : 0.0);
+
+	delete stream;
+}
+
+int main(int argc, char *argv[]) {
+	if (argc < 2) {
+		printf("Usage: %s <file> [repetitions]\n", argv[0]);
+		return 1;
+	}
+
+	const Common::String path(argv[1]);
+	const int repetitions = (argc > 2) ? MAX(atoi(argv[2]), 1) : 5;
+
+	// Warm up the page cache, so both runs read from memory
+	Common::SeekableReadStream *warmup = openStdio(path);
+	if (!warmup) {
+		printf("Could not open '%s'\n", argv[1]);
+		return 1;
+	}
+	readSequential(warmup, 65536);
+	delete warmup;
+
+	runBenchmark("stdio", openStdio, path, repetitions);
+	runBenchmark("mmap", openMmap, path, repetitions);
+
+	return 0;
+}
+
+#else
+
+#include <stdio.h>
+
+int main(int argc, char *argv[]) {
+	printf("Memory mapped file streams are not available on this platform\n");
+	return 0;
+}
+
+#endif
@@ -0,0 +1,141 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+// Benchmarks for the scalers and the pixel format conversion in graphics/
+
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+#include "test/bench/bench.h"
+
+#include "graphics/conversion.h"
+#include "graphics/pixelformat.h"
+#include "graphics/scaler.h"
+
+namespace Bench {
+
+namespace {
+
+enum {
+	kScreenWidth = 320,
+	kScreenHeight = 200,
+	// The scalers read the pixels around the source rect, so just like the
+	// backends we keep a border around the source screen
+	kBorder = 2,
+	kMaxScale = 3
+};
+
+#ifdef USE_SCALERS
+class Scaler : public Benchmark {
+public:
+	Scaler(const char *name, ScalerProc *proc) : Benchmark("graphics", name), _proc(proc) {}
+
+	void setUp() {
+		InitScalers(565);
+
+		// Smooth gradients with some noise, so the edge detection of the
+		// smarter scalers has something to do
+		uint32 seed = 1;
+		for (int y = 0; y < kScreenHeight + 2 * kBorder; ++y) {
+			for (int x = 0; x < kScreenWidth + 2 * kBorder; ++x) {
+				const uint16 noise = (random(seed) & 7) ? 0 : (random(seed) & 0xFFFF);
+				_src[y][x] = ((x / 8) << 11 | (y / 4) << 5 | ((x + y) / 16)) ^ noise;
+			}
+		}
+	}
+
+	void run() {
+		const uint32 dstPitch = kScreenWidth * kMaxScale * 2;
+		_proc((const uint8 *)&_src[kBorder][kBorder], sizeof(_src[0]), (uint8 *)_dst, dstPitch, kScreenWidth, kScreenHeight);
+		consume(_dst[0]);
+	}
+
+	void tearDown() { DestroyScalers(); }
+
+	uint32 getBytesPerRun() const { return kScreenWidth * kScreenHeight * 2; }
+
+private:
+	ScalerProc *_proc;
+	uint16 _src[kScreenHeight + 2 * kBorder][kScreenWidth + 2 * kBorder];
+	uint16 _dst[kScreenHeight * kMaxScale * kScreenWidth * kMaxScale];
+};
+#endif
+
+class CrossBlit : public Benchmark {
+public:
+	CrossBlit(const char *name, const Graphics::PixelFormat &dstFormat, const Graphics::PixelFormat &srcFormat)
+		: Benchmark("graphics", name), _dstFormat(dstFormat), _srcFormat(srcFormat) {}
+
+	void setUp() { fillRandom(_src, sizeof(_src)); }
+
+	void run() {
+		Graphics::crossBlit(_dst, _src, kWidth * _dstFormat.bytesPerPixel, kWidth * _srcFormat.bytesPerPixel,
+		                    kWidth, kHeight, _dstFormat, _srcFormat);
+		consume(_dst[0]);
+	}
+
+	uint32 getBytesPerRun() const { return kWidth * kHeight * _srcFormat.bytesPerPixel; }
+
+private:
+	enum {
+		kWidth = 640,
+		kHeight = 480
+	};
+
+	Graphics::PixelFormat _dstFormat, _srcFormat;
+	byte _src[kWidth * kHeight * 4];
+	byte _dst[kWidth * kHeight * 4];
+};
+
+} // End of anonymous namespace
+
+void addGraphicsSuite() {
+#ifdef USE_SCALERS
+	addBenchmark(new Scaler("scaler_normal2x", Normal2x));
+	addBenchmark(new Scaler("scaler_normal3x", Normal3x));
+	addBenchmark(new Scaler("scaler_advmame2x", AdvMame2x));
+	addBenchmark(new Scaler("scaler_advmame3x", AdvMame3x));
+	addBenchmark(new Scaler("scaler_2xsai", _2xSaI));
+	addBenchmark(new Scaler("scaler_super2xsai", Super2xSaI));
+	addBenchmark(new Scaler("scaler_supereagle", SuperEagle));
+	addBenchmark(new Scaler("scaler_tv2x", TV2x));
+	addBenchmark(new Scaler("scaler_dotmatrix", DotMatrix));
+#ifdef USE_HQ_SCALERS
+	addBenchmark(new Scaler("scaler_hq2x", HQ2x));
+	addBenchmark(new Scaler("scaler_hq3x", HQ3x));
+#endif
+#endif
+
+	const Graphics::PixelFormat rgb565(2, 5, 6, 5, 0, 11, 5, 0, 0);
+	const Graphics::PixelFormat rgb555(2, 5, 5, 5, 0, 10, 5, 0, 0);
+	const Graphics::PixelFormat rgba4444(2, 4, 4, 4, 4, 12, 8, 4, 0);
+	const Graphics::PixelFormat xrgb8888(4, 8, 8, 8, 0, 16, 8, 0, 0);
+	const Graphics::PixelFormat argb8888(4, 8, 8, 8, 8, 16, 8, 0, 24);
+	const Graphics::PixelFormat rgba8888(4, 8, 8, 8, 8, 24, 16, 8, 0);
+
+	addBenchmark(new CrossBlit("crossblit_rgb565_to_xrgb8888", xrgb8888, rgb565));
+	addBenchmark(new CrossBlit("crossblit_xrgb8888_to_rgb565", rgb565, xrgb8888));
+	addBenchmark(new CrossBlit("crossblit_rgb555_to_rgb565", rgb565, rgb555));
+	addBenchmark(new CrossBlit("crossblit_argb8888_to_rgba8888", rgba8888, argb8888));
+	addBenchmark(new CrossBlit("crossblit_rgba4444_to_argb8888", argb8888, rgba4444));
+}
+
+} // End of namespace Bench
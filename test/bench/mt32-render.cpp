@@ -0,0 +1,355 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+// Plays a standard MIDI file through the MT-32 emulator as fast as possible,
+// optionally writing the result to a WAV file. The time spent in the emulator
+// is reported, along with how much faster than real time that is.
+//
+// The MIDI file is meant to be a capture of what a game sent to the MT-32,
+// SysEx messages included. The ROMs are looked for in ROMDIR, under the same
+// names as in ScummVM.
+//
+// --single renders all partials one sample at a time instead of in blocks.
+// --compare renders the file both ways as well and fails if the outputs are
+// not identical.
+//
+// Usage: mt32-render [--repeat=NUM] [--single] [--compare] ROMDIR MIDI [WAV]
+
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+#include "common/scummsys.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#ifdef USE_MT32EMU
+
+#include "audio/mididrv.h"
+#include "audio/midiparser.h"
+#include "audio/softsynth/mt32/mt32emu.h"
+#include "audio/softsynth/mt32/ROMInfo.h"
+
+#include "common/array.h"
+#include "common/endian.h"
+#include "common/file.h"
+#include "common/memstream.h"
+#include "common/str.h"
+#include "common/util.h"
+
+enum {
+	kRate = 32000,
+	// The MIDI file is played in steps of 128 samples
+	kTimerRate = 4000,
+	kTimerSamples = kRate * kTimerRate / 1000000,
+	// How long the notes and the reverb may ring out after the end
+	kMaxTailSamples = kRate * 10
+};
+
+// Keeps the emulator from printing its debug messages
+class QuietReportHandler : public MT32Emu::ReportHandler {
+protected:
+	void printDebug(const char *fmt, va_list list) {}
+	void showLCDMessage(const char *message) {}
+};
+
+// Passes everything the parser plays on to the emulator
+class SynthDriver : public MidiDriver_BASE {
+public:
+	SynthDriver(MT32Emu::Synth &synth) : _synth(synth) {}
+
+	void send(uint32 b) {
+		_synth.playMsg(b);
+	}
+
+	void sysEx(const byte *msg, uint16 length) {
+		if (msg[0] == 0xF0)
+			_synth.playSysex(msg, length);
+		else
+			_synth.playSysexWithoutFraming(msg, length);
+	}
+
+private:
+	MT32Emu::Synth &_synth;
+};
+
+static double getSeconds() {
+	struct timeval tv;
+	gettimeofday(&tv, 0);
+	return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+static bool readFile(const char *filename, Common::Array<byte> &data) {
+	FILE *file = fopen(filename, "rb");
+	if (!file)
+		return false;
+
+	byte buffer[4096];
+	size_t read;
+	while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+		for (size_t i = 0; i < read; ++i)
+			data.push_back(buffer[i]);
+	}
+
+	fclose(file);
+	return true;
+}
+
+// Opens a ROM through a memory stream, since there's no OSystem to find files
+static Common::File *openROM(const char *romDir, const char *name) {
+	Common::Array<byte> data;
+	if (!readFile(Common::String::format("%s/%s", romDir, name).c_str(), data) || data.empty())
+		return 0;
+
+	byte *copy = (byte *)malloc(data.size());
+	memcpy(copy, data.begin(), data.size());
+
+	Common::File *file = new Common::File();
+	file->open(new Common::MemoryReadStream(copy, data.size(), DisposeAfterUse::YES), name);
+	return file;
+}
+
+static void writeUint32LE(FILE *file, uint32 value) {
+	byte data[4];
+	WRITE_LE_UINT32(data, value);
+	fwrite(data, 4, 1, file);
+}
+
+static void writeUint16LE(FILE *file, uint16 value) {
+	byte data[2];
+	WRITE_LE_UINT16(data, value);
+	fwrite(data, 2, 1, file);
+}
+
+// Writes the header of a 16 bit PCM WAV file
+static void writeWAVHeader(FILE *file, uint32 rate, uint16 channels, uint32 samples) {
+	const uint32 dataSize = samples * 2;
+
+	fwrite("RIFF", 4, 1, file);
+	writeUint32LE(file, 36 + dataSize);
+	fwrite("WAVEfmt ", 8, 1, file);
+	writeUint32LE(file, 16);
+	writeUint16LE(file, 1);
+	writeUint16LE(file, channels);
+	writeUint32LE(file, rate);
+	writeUint32LE(file, rate * channels * 2);
+	writeUint16LE(file, channels * 2);
+	writeUint16LE(file, 16);
+	fwrite("data", 4, 1, file);
+	writeUint32LE(file, dataSize);
+}
+
+static void writeSamples(FILE *wav, Common::Array<int16> *output, const int16 *buffer, uint32 samples) {
+	if (wav) {
+		for (uint32 i = 0; i < samples * 2; ++i)
+			writeUint16LE(wav, buffer[i]);
+	}
+	if (output) {
+		for (uint32 i = 0; i < samples * 2; ++i)
+			output->push_back(buffer[i]);
+	}
+}
+
+// Plays the whole MIDI file and lets it ring out, returns the seconds spent
+// and the number of samples per channel. The samples are written to the WAV
+// file and the output array, either of which may be 0.
+static double render(const MT32Emu::ROMImage &controlROM, const MT32Emu::ROMImage &pcmROM,
+                     Common::Array<byte> &midi, bool blockRendering,
+                     FILE *wav, Common::Array<int16> *output, uint32 &samples) {
+	// The synth reads the ROMs from the current position of their files
+	controlROM.getFile()->seek(0);
+	pcmROM.getFile()->seek(0);
+
+	QuietReportHandler reportHandler;
+	MT32Emu::Synth synth(&reportHandler);
+	if (!synth.open(controlROM, pcmROM))
+		return -1.0;
+	synth.setBlockRenderingEnabled(blockRendering);
+
+	SynthDriver driver(synth);
+	MidiParser *parser = MidiParser::createParser_SMF();
+	if (!parser->loadMusic(midi.begin(), midi.size())) {
+		delete parser;
+		synth.close();
+		return -1.0;
+	}
+	parser->setMidiDriver(&driver);
+	parser->setTimerRate(kTimerRate);
+	parser->setTrack(0);
+
+	int16 buffer[kTimerSamples * 2];
+	samples = 0;
+
+	double time = 0.0;
+	while (parser->isPlaying()) {
+		const double start = getSeconds();
+		parser->onTimer();
+		synth.render(buffer, kTimerSamples);
+		time += getSeconds() - start;
+
+		writeSamples(wav, output, buffer, kTimerSamples);
+		samples += kTimerSamples;
+	}
+
+	for (uint32 tail = 0; tail < kMaxTailSamples; tail += kTimerSamples) {
+		const double start = getSeconds();
+		const bool active = synth.isActive();
+		if (active)
+			synth.render(buffer, kTimerSamples);
+		time += getSeconds() - start;
+
+		if (!active)
+			break;
+		writeSamples(wav, output, buffer, kTimerSamples);
+		samples += kTimerSamples;
+	}
+
+	delete parser;
+	synth.close();
+	return time;
+}
+
+int main(int argc, char *argv[]) {
+	int repeat = 1;
+	bool single = false;
+	bool compare = false;
+	const char *romDir = 0;
+	const char *midiName = 0;
+	const char *wavName = 0;
+
+	for (int i = 1; i < argc; ++i) {
+		if (!strncmp(argv[i], "--repeat=", 9))
+			repeat = MAX(atoi(argv[i] + 9), 1);
+		else if (!strcmp(argv[i], "--single"))
+			single = true;
+		else if (!strcmp(argv[i], "--compare"))
+			compare = true;
+		else if (!romDir)
+			romDir = argv[i];
+		else if (!midiName)
+			midiName = argv[i];
+		else if (!wavName)
+			wavName = argv[i];
+		else
+			midiName = 0;
+	}
+
+	if (!midiName) {
+		printf("Usage: %s [--repeat=NUM] [--single] [--compare] ROMDIR MIDI [WAV]\n", argv[0]);
+		return 1;
+	}
+
+	Common::File *controlFile = openROM(romDir, "MT32_CONTROL.ROM");
+	if (!controlFile)
+		controlFile = openROM(romDir, "CM32L_CONTROL.ROM");
+	Common::File *pcmFile = openROM(romDir, "MT32_PCM.ROM");
+	if (!pcmFile)
+		pcmFile = openROM(romDir, "CM32L_PCM.ROM");
+	if (!controlFile || !pcmFile) {
+		printf("Could not find the MT-32 or CM-32L ROMs in '%s'\n", romDir);
+		return 1;
+	}
+
+	const MT32Emu::ROMImage *controlROM = MT32Emu::ROMImage::makeROMImage(controlFile);
+	const MT32Emu::ROMImage *pcmROM = MT32Emu::ROMImage::makeROMImage(pcmFile);
+
+	Common::Array<byte> midi;
+	if (!readFile(midiName, midi)) {
+		printf("Could not read '%s'\n", midiName);
+		return 1;
+	}
+
+	FILE *wav = 0;
+	if (wavName) {
+		wav = fopen(wavName, "wb");
+		if (!wav) {
+			printf("Could not open '%s'\n", wavName);
+			return 1;
+		}
+		// Leave room for the header, which needs the length
+		writeWAVHeader(wav, 0, 2, 0);
+	}
+
+	// Only the first run is written to the WAV file, the fastest one is
+	// reported
+	double best = 0.0;
+	uint32 samples = 0;
+	for (int i = 0; i < repeat; ++i) {
+		const double time = render(*controlROM, *pcmROM, midi, !single, i ? 0 : wav, 0, samples);
+		if (time < 0.0) {
+			printf("Could not play '%s' with the ROMs in '%s'\n", midiName, romDir);
+			return 1;
+		}
+		best = i ? MIN(best, time) : time;
+	}
+
+	if (wav) {
+		fseek(wav, 0, SEEK_SET);
+		writeWAVHeader(wav, kRate, 2, samples * 2);
+		fclose(wav);
+	}
+
+	// The block rendering has to give exactly the same output as rendering
+	// one sample at a time
+	int result = 0;
+	if (compare) {
+		Common::Array<int16> blockOutput, singleOutput;
+		uint32 blockSamples = 0, singleSamples = 0;
+		render(*controlROM, *pcmROM, midi, true, 0, &blockOutput, blockSamples);
+		render(*controlROM, *pcmROM, midi, false, 0, &singleOutput, singleSamples);
+
+		uint32 mismatch = 0;
+		while (mismatch < blockOutput.size() && mismatch < singleOutput.size() && blockOutput[mismatch] == singleOutput[mismatch])
+			++mismatch;
+
+		if (blockSamples != singleSamples) {
+			printf("Block rendering gave %u samples, single sample rendering %u\n", blockSamples, singleSamples);
+			result = 1;
+		} else if (mismatch < blockOutput.size()) {
+			printf("Block and single sample rendering differ from sample %u of channel %u on\n", mismatch / 2, mismatch % 2);
+			result = 1;
+		} else {
+			printf("Block and single sample rendering give identical output\n");
+		}
+	}
+
+	MT32Emu::ROMImage::freeROMImage(controlROM);
+	MT32Emu::ROMImage::freeROMImage(pcmROM);
+	delete controlFile;
+	delete pcmFile;
+
+	const double length = (double)samples / kRate;
+	printf("%u samples (%.1f s) at %d Hz rendered in %.1f ms, %.1fx real time\n",
+	       samples, length, (int)kRate, best * 1000.0, best > 0.0 ? length / best : 0.0);
+
+	return result;
+}
+
+#else
+
+int main(int argc, char *argv[]) {
+	printf("The MT-32 emulator is disabled\n");
+	return 1;
+}
+
+#endif
@@ -0,0 +1,211 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+// Renders an OPL register dump recorded with --opl-capture as fast as
+// possible, optionally writing the result to a WAV file. The time spent in
+// the emulator is reported, along with how much faster than real time that is.
+//
+// Only the DOSBox emulator can be used here, since the MAME one needs an
+// OSystem for its random source.
+//
+// Usage: opl-replay [--repeat=NUM] DUMP [WAV]
+
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+#include "audio/opldump.h"
+#include "audio/softsynth/opl/dosbox.h"
+
+#include "common/array.h"
+#include "common/endian.h"
+#include "common/memstream.h"
+#include "common/util.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#ifndef DISABLE_DOSBOX_OPL
+
+enum {
+	kBufferSamples = 4096
+};
+
+static double getSeconds() {
+	struct timeval tv;
+	gettimeofday(&tv, 0);
+	return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+static bool readFile(const char *filename, Common::Array<byte> &data) {
+	FILE *file = fopen(filename, "rb");
+	if (!file)
+		return false;
+
+	byte buffer[4096];
+	size_t read;
+	while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+		for (size_t i = 0; i < read; ++i)
+			data.push_back(buffer[i]);
+	}
+
+	fclose(file);
+	return true;
+}
+
+static void writeUint32LE(FILE *file, uint32 value) {
+	byte data[4];
+	WRITE_LE_UINT32(data, value);
+	fwrite(data, 4, 1, file);
+}
+
+static void writeUint16LE(FILE *file, uint16 value) {
+	byte data[2];
+	WRITE_LE_UINT16(data, value);
+	fwrite(data, 2, 1, file);
+}
+
+// Writes the header of a 16 bit PCM WAV file
+static void writeWAVHeader(FILE *file, uint32 rate, uint16 channels, uint32 samples) {
+	const uint32 dataSize = samples * 2;
+
+	fwrite("RIFF", 4, 1, file);
+	writeUint32LE(file, 36 + dataSize);
+	fwrite("WAVEfmt ", 8, 1, file);
+	writeUint32LE(file, 16);
+	writeUint16LE(file, 1);
+	writeUint16LE(file, channels);
+	writeUint32LE(file, rate);
+	writeUint32LE(file, rate * channels * 2);
+	writeUint16LE(file, channels * 2);
+	writeUint16LE(file, 16);
+	fwrite("data", 4, 1, file);
+	writeUint32LE(file, dataSize);
+}
+
+// Renders the whole dump, returns the seconds spent and the number of samples
+static double render(const Common::Array<byte> &data, FILE *wav, uint32 &samples, int &rate, bool &stereo) {
+	Common::MemoryReadStream stream(data.begin(), data.size());
+	OPL::DumpPlayer player(&stream);
+
+	OPL::Config::OplType type;
+	if (!player.readHeader(type))
+		return -1.0;
+
+	OPL::DOSBox::OPL opl(type);
+	stereo = opl.isStereo();
+
+	int16 buffer[kBufferSamples];
+	samples = 0;
+
+	double time = 0.0;
+	while (!player.isFinished()) {
+		const double start = getSeconds();
+		const int read = player.play(&opl, buffer, kBufferSamples);
+		time += getSeconds() - start;
+
+		if (wav) {
+			for (int i = 0; i < read; ++i)
+				writeUint16LE(wav, buffer[i]);
+		}
+		samples += read;
+	}
+
+	rate = player.getRate();
+	return time;
+}
+
+int main(int argc, char *argv[]) {
+	int repeat = 1;
+	const char *dumpName = 0;
+	const char *wavName = 0;
+
+	for (int i = 1; i < argc; ++i) {
+		if (!strncmp(argv[i], "--repeat=", 9))
+			repeat = MAX(atoi(argv[i] + 9), 1);
+		else if (!dumpName)
+			dumpName = argv[i];
+		else if (!wavName)
+			wavName = argv[i];
+		else
+			dumpName = 0;
+	}
+
+	if (!dumpName) {
+		printf("Usage: %s [--repeat=NUM] DUMP [WAV]\n", argv[0]);
+		return 1;
+	}
+
+	Common::Array<byte> data;
+	if (!readFile(dumpName, data)) {
+		printf("Could not read '%s'\n", dumpName);
+		return 1;
+	}
+
+	FILE *wav = 0;
+	if (wavName) {
+		wav = fopen(wavName, "wb");
+		if (!wav) {
+			printf("Could not open '%s'\n", wavName);
+			return 1;
+		}
+		// Leave room for the header, which needs the length
+		writeWAVHeader(wav, 0, 1, 0);
+	}
+
+	// Only the first run is written to the WAV file, the fastest one is
+	// reported
+	double best = 0.0;
+	uint32 samples = 0;
+	int rate = 0;
+	bool stereo = false;
+	for (int i = 0; i < repeat; ++i) {
+		const double time = render(data, i ? 0 : wav, samples, rate, stereo);
+		if (time < 0.0) {
+			printf("'%s' is not an OPL register dump\n", dumpName);
+			return 1;
+		}
+		best = i ? MIN(best, time) : time;
+	}
+
+	const uint16 channels = stereo ? 2 : 1;
+	if (wav) {
+		fseek(wav, 0, SEEK_SET);
+		writeWAVHeader(wav, rate, channels, samples);
+		fclose(wav);
+	}
+
+	const double length = rate ? (double)samples / channels / rate : 0.0;
+	printf("%u samples (%.1f s) at %d Hz rendered in %.1f ms, %.1fx real time\n",
+	       samples / channels, length, rate, best * 1000.0, best > 0.0 ? length / best : 0.0);
+
+	return 0;
+}
+
+#else
+
+int main(int argc, char *argv[]) {
+	printf("The DOSBox OPL emulator is disabled\n");
+	return 1;
+}
+
+#endif
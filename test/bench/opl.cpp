@@ -0,0 +1,246 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+// Benchmarks for the DOSBox OPL emulator. Every benchmark plays a register
+// sequence resembling the music of a typical AdLib game, once with the block
+// synth and once generating sample by sample for comparison.
+
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+#include "test/bench/bench.h"
+
+#include "audio/softsynth/opl/dbopl.h"
+
+#include "common/array.h"
+
+#ifndef DISABLE_DOSBOX_OPL
+
+using namespace OPL::DOSBox;
+
+namespace Bench {
+
+namespace {
+
+enum {
+	kRate = 44100,
+	kTickSamples = kRate / 60,	// Most music drivers run at 60 Hz or less
+	kSongTicks = 120,
+	kBufferSamples = 512
+};
+
+struct RegisterWrite {
+	uint32 wait;	///< Samples to generate before the write
+	uint16 reg;
+	uint8 val;
+};
+
+// Operator registers 0x20, 0x40, 0x60, 0x80 and 0xE0 of the modulator and
+// the carrier, followed by the feedback/connection value
+struct Instrument {
+	uint8 op[2][5];
+	uint8 c0;
+};
+
+static const Instrument s_instruments[] = {
+	{ { { 0x01, 0x4F, 0xF1, 0x53, 0x00 }, { 0x11, 0x00, 0xD2, 0x74, 0x00 } }, 0x06 },	// Piano
+	{ { { 0x00, 0x0D, 0xF2, 0x75, 0x00 }, { 0x01, 0x00, 0xF5, 0x75, 0x00 } }, 0x0A },	// Bass
+	{ { { 0x61, 0x1E, 0x71, 0x16, 0x00 }, { 0xE1, 0x03, 0x82, 0x17, 0x00 } }, 0x0E },	// Strings
+	{ { { 0xE2, 0x21, 0xF0, 0x0F, 0x01 }, { 0xE1, 0x00, 0xF0, 0x0F, 0x00 } }, 0x01 },	// Organ
+	{ { { 0xC1, 0x8C, 0xF4, 0x26, 0x02 }, { 0x81, 0x00, 0xA3, 0x16, 0x00 } }, 0x0C }	// Brass
+};
+
+static const uint8 s_opOffsets[9] = { 0x00, 0x01, 0x02, 0x08, 0x09, 0x0A, 0x10, 0x11, 0x12 };
+
+// F-numbers of a chromatic octave
+static const uint16 s_notes[12] = {
+	0x157, 0x16B, 0x181, 0x198, 0x1B0, 0x1CA, 0x1E5, 0x202, 0x220, 0x241, 0x263, 0x287
+};
+
+class SongBuilder {
+public:
+	SongBuilder(Common::Array<RegisterWrite> &song, bool opl3) : _song(song), _opl3(opl3), _wait(0) {}
+
+	void write(uint16 reg, uint8 val) {
+		RegisterWrite w = { _wait, reg, val };
+		_song.push_back(w);
+		_wait = 0;
+	}
+
+	void wait(uint32 samples) { _wait += samples; }
+
+	void setInstrument(uint16 bank, uint channel, const Instrument &instrument) {
+		for (uint op = 0; op < 2; ++op) {
+			const uint16 offset = bank + s_opOffsets[channel] + op * 3;
+			write(0x20 + offset, instrument.op[op][0]);
+			write(0x40 + offset, instrument.op[op][1]);
+			write(0x60 + offset, instrument.op[op][2]);
+			write(0x80 + offset, instrument.op[op][3]);
+			write(0xE0 + offset, instrument.op[op][4]);
+		}
+		write(bank + 0xC0 + channel, instrument.c0 | (_opl3 ? 0x30 : 0));
+	}
+
+	void noteOn(uint16 bank, uint channel, uint note) {
+		const uint16 fnum = s_notes[note % 12];
+		const uint8 block = 2 + (note / 12) % 5;
+		write(bank + 0xA0 + channel, fnum & 0xFF);
+		write(bank + 0xB0 + channel, 0x20 | (block << 2) | (fnum >> 8));
+	}
+
+	void noteOff(uint16 bank, uint channel, uint note) {
+		const uint16 fnum = s_notes[note % 12];
+		const uint8 block = 2 + (note / 12) % 5;
+		write(bank + 0xB0 + channel, (block << 2) | (fnum >> 8));
+	}
+
+private:
+	Common::Array<RegisterWrite> &_song;
+	bool _opl3;
+	uint32 _wait;
+};
+
+class OPLPlayback : public Benchmark {
+public:
+	enum Type {
+		kMelodic,		///< Nine melodic OPL2 channels
+		kRhythm,		///< Six melodic OPL2 channels and the percussion mode
+		kFourOp			///< OPL3 with four operator channels and panning
+	};
+
+	OPLPlayback(const char *name, Type type, bool reference)
+		: Benchmark("opl", name), _type(type), _reference(reference) {}
+
+	void setUp() {
+		DBOPL::InitTables();
+		_chip.referenceSynth = _reference;
+		_chip.Setup(kRate);
+
+		const bool opl3 = _type == kFourOp;
+		SongBuilder song(_song, opl3);
+		if (opl3) {
+			song.write(0x105, 1);
+			song.write(0x104, 0x07);
+		}
+		song.write(0x01, 0x20);
+		song.write(0xBD, _type == kRhythm ? 0xE0 : 0xC0);
+
+		// Voices playing random notes of a scale, keyed off before the next
+		// note. The four operator channels use the same instrument for both
+		// halves.
+		const uint voices = _type == kRhythm ? 6 : 9;
+		const uint banks = opl3 ? 2 : 1;
+		for (uint bank = 0; bank < banks; ++bank) {
+			for (uint i = 0; i < voices; ++i)
+				song.setInstrument(bank * 0x100, i, s_instruments[i % ARRAYSIZE(s_instruments)]);
+		}
+
+		uint32 seed = 1;
+		uint notes[2][9];
+		memset(notes, 0, sizeof(notes));
+		for (uint tick = 0; tick < kSongTicks; ++tick) {
+			for (uint bank = 0; bank < banks; ++bank) {
+				for (uint i = 0; i < voices; ++i) {
+					// Four operator channels are keyed through the first channel
+					if (bank == 0 && opl3 && i >= 3 && i < 6)
+						continue;
+					if (random(seed) % 8)
+						continue;
+					const uint16 reg = bank * 0x100;
+					if (notes[bank][i])
+						song.noteOff(reg, i, notes[bank][i]);
+					notes[bank][i] = 12 + random(seed) % 36;
+					song.noteOn(reg, i, notes[bank][i]);
+				}
+			}
+
+			if (_type == kRhythm)
+				song.write(0xBD, 0xE0 | (1 << (tick & 3)) | ((tick & 1) ? 0x10 : 0));
+
+			song.wait(kTickSamples);
+		}
+
+		// Key everything off again, so every run sounds the same
+		for (uint bank = 0; bank < banks; ++bank) {
+			for (uint i = 0; i < voices; ++i) {
+				if (notes[bank][i])
+					song.noteOff(bank * 0x100, i, notes[bank][i]);
+			}
+		}
+		song.wait(kTickSamples);
+		song.write(0xBD, 0xC0);
+	}
+
+	void run() {
+		uint32 sum = 0;
+		for (uint i = 0; i < _song.size(); ++i) {
+			uint32 wait = _song[i].wait;
+			while (wait > 0) {
+				const uint32 samples = MIN<uint32>(wait, kBufferSamples);
+				if (_chip.opl3Active) {
+					_chip.GenerateBlock3(samples, _buffer);
+				} else {
+					_chip.GenerateBlock2(samples, _buffer);
+				}
+				sum += _buffer[0];
+				wait -= samples;
+			}
+			_chip.WriteReg(_song[i].reg, _song[i].val);
+		}
+		consume(sum);
+	}
+
+	void tearDown() { _song.clear(); }
+
+	// As 16 bit samples, like the OPL emulator outputs them
+	uint32 getBytesPerRun() const { return (kSongTicks + 1) * kTickSamples * (_type == kFourOp ? 4 : 2); }
+
+private:
+	Type _type;
+	bool _reference;
+	DBOPL::Chip _chip;
+	Common::Array<RegisterWrite> _song;
+	int32 _buffer[kBufferSamples * 2];
+};
+
+} // End of anonymous namespace
+
+void addOPLSuite() {
+	addBenchmark(new OPLPlayback("opl2_melodic", OPLPlayback::kMelodic, false));
+	addBenchmark(new OPLPlayback("opl2_melodic_reference", OPLPlayback::kMelodic, true));
+	addBenchmark(new OPLPlayback("opl2_rhythm", OPLPlayback::kRhythm, false));
+	addBenchmark(new OPLPlayback("opl2_rhythm_reference", OPLPlayback::kRhythm, true));
+	addBenchmark(new OPLPlayback("opl3_four_op", OPLPlayback::kFourOp, false));
+	addBenchmark(new OPLPlayback("opl3_four_op_reference", OPLPlayback::kFourOp, true));
+}
+
+} // End of namespace Bench
+
+#else
+
+namespace Bench {
+
+void addOPLSuite() {
+}
+
+} // End of namespace Bench
+
+#endif
@@ -0,0 +1,207 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/archive.h"
+#include "common/memstream.h"
+#include "common/str-array.h"
+
+/**
+ * Archive holding a fixed set of empty members. Optionally it does not list
+ * them, like archives which can only be asked for specific members.
+ */
+class TestArchive : public Common::Archive {
+public:
+	TestArchive(const char *id, bool listable = true) : _id(id), _listable(listable) {}
+
+	void addFile(const Common::String &name) { _files.push_back(name); }
+
+	virtual bool hasFile(const Common::String &name) const {
+		for (uint i = 0; i < _files.size(); ++i) {
+			if (_files[i].equalsIgnoreCase(name))
+				return true;
+		}
+		return false;
+	}
+
+	virtual int listMembers(Common::ArchiveMemberList &list) const {
+		if (!_listable)
+			return 0;
+		for (uint i = 0; i < _files.size(); ++i)
+			list.push_back(Common::ArchiveMemberPtr(new Common::GenericArchiveMember(_files[i], this)));
+		return _files.size();
+	}
+
+	virtual const Common::ArchiveMemberPtr getMember(const Common::String &name) const {
+		return Common::ArchiveMemberPtr(new Common::GenericArchiveMember(name, this));
+	}
+
+	virtual Common::SeekableReadStream *createReadStreamForMember(const Common::String &name) const {
+		if (!hasFile(name))
+			return 0;
+		// Identify the archive by the stream size
+		return new Common::MemoryReadStream((const byte *)_id, strlen(_id));
+	}
+
+	Common::StringArray _files;
+
+private:
+	const char *_id;
+	bool _listable;
+};
+
+class SearchSetTestSuite : public CxxTest::TestSuite
+{
+	public:
+	void test_priority_order() {
+		Common::SearchSet set;
+		TestArchive *low = new TestArchive("l");
+		TestArchive *high = new TestArchive("hh");
+		low->addFile("a.dat");
+		low->addFile("b.dat");
+		high->addFile("A.DAT");
+		set.add("low", low, 0);
+		set.add("high", high, 10);
+
+		TS_ASSERT(set.hasFile("a.dat"));
+		TS_ASSERT(set.hasFile("B.dat"));
+		TS_ASSERT(!set.hasFile("c.dat"));
+
+		Common::SeekableReadStream *stream = set.createReadStreamForMember("a.dat");
+		TS_ASSERT(stream);
+		TS_ASSERT_EQUALS(stream->size(), 2);
+		delete stream;
+
+		// Changing the priorities has to be picked up by the index
+		set.setPriority("low", 20);
+		stream = set.createReadStreamForMember("a.dat");
+		TS_ASSERT(stream);
+		TS_ASSERT_EQUALS(stream->size(), 1);
+		delete stream;
+	}
+
+	void test_add_remove() {
+		Common::SearchSet set;
+		TestArchive *first = new TestArchive("f");
+		first->addFile("first.dat");
+		set.add("first", first);
+		TS_ASSERT(!set.hasFile("second.dat"));
+
+		TestArchive *second = new TestArchive("s");
+		second->addFile("second.dat");
+		set.add("second", second);
+		TS_ASSERT(set.hasFile("second.dat"));
+
+		set.remove("second");
+		TS_ASSERT(!set.hasFile("second.dat"));
+		TS_ASSERT(set.hasFile("first.dat"));
+	}
+
+	void test_incremental_index() {
+		Common::SearchSet set;
+		TestArchive *a = new TestArchive("aa");
+		a->addFile("shared.dat");
+		a->addFile("a.dat");
+		set.add("a", a);
+		TS_ASSERT(set.hasFile("a.dat"));
+
+		// Added after the index was built, with the same priority
+		TestArchive *b = new TestArchive("b");
+		b->addFile("shared.dat");
+		b->addFile("b.dat");
+		set.add("b", b);
+
+		TestArchive *c = new TestArchive("ccc");
+		c->addFile("shared.dat");
+		set.add("c", c, 5);
+
+		Common::SeekableReadStream *stream = set.createReadStreamForMember("shared.dat");
+		TS_ASSERT(stream);
+		TS_ASSERT_EQUALS(stream->size(), 3);
+		delete stream;
+
+		set.remove("c");
+		stream = set.createReadStreamForMember("shared.dat");
+		TS_ASSERT(stream);
+		TS_ASSERT_EQUALS(stream->size(), 2);
+		delete stream;
+
+		set.remove("a");
+		set.resetArchiveStats();
+		stream = set.createReadStreamForMember("shared.dat");
+		TS_ASSERT(stream);
+		TS_ASSERT_EQUALS(stream->size(), 1);
+		delete stream;
+		TS_ASSERT(!set.hasFile("a.dat"));
+		TS_ASSERT(set.hasFile("b.dat"));
+
+		// Only the archive from the index has been asked
+		Common::Array<Common::SearchSet::ArchiveStats> stats = set.getArchiveStats();
+		TS_ASSERT_EQUALS(stats.size(), 1u);
+		TS_ASSERT_EQUALS(stats[0].misses, 0u);
+	}
+
+	void test_unlisted_archive() {
+		Common::SearchSet set;
+		TestArchive *listed = new TestArchive("ll");
+		TestArchive *unlisted = new TestArchive("u", false);
+		listed->addFile("x.dat");
+		unlisted->addFile("x.dat");
+		unlisted->addFile("y.dat");
+		set.add("listed", listed, 0);
+		set.add("unlisted", unlisted, 5);
+
+		TS_ASSERT(set.hasFile("y.dat"));
+
+		// The unlisted archive has the higher priority and has to win
+		Common::SeekableReadStream *stream = set.createReadStreamForMember("x.dat");
+		TS_ASSERT(stream);
+		TS_ASSERT_EQUALS(stream->size(), 1);
+		delete stream;
+	}
+
+	void test_stale_member() {
+		Common::SearchSet set;
+		TestArchive *high = new TestArchive("hh");
+		TestArchive *low = new TestArchive("l");
+		high->addFile("z.dat");
+		low->addFile("z.dat");
+		set.add("high", high, 10);
+		set.add("low", low, 0);
+
+		TS_ASSERT(set.hasFile("z.dat"));
+
+		// A member vanishing behind the back of the index is still found
+		// in the other archive
+		high->_files.clear();
+		Common::SeekableReadStream *stream = set.createReadStreamForMember("z.dat");
+		TS_ASSERT(stream);
+		TS_ASSERT_EQUALS(stream->size(), 1);
+		delete stream;
+	}
+
+	void test_stats() {
+		Common::SearchSet set;
+		TestArchive *high = new TestArchive("hh");
+		TestArchive *low = new TestArchive("l");
+		high->addFile("other.dat");
+		low->addFile("file.dat");
+		set.add("high", high, 10);
+		set.add("low", low, 0);
+
+		set.hasFile("file.dat");
+		set.hasFile("file.dat");
+		set.hasFile("sub/file.dat");
+
+		Common::Array<Common::SearchSet::ArchiveStats> stats = set.getArchiveStats();
+		TS_ASSERT_EQUALS(stats.size(), 2u);
+		TS_ASSERT_EQUALS(stats[0].name, "high");
+		// The first archive is only asked for the path, which bypasses the index
+		TS_ASSERT_EQUALS(stats[0].lookups, 1u);
+		TS_ASSERT_EQUALS(stats[0].misses, 1u);
+		TS_ASSERT_EQUALS(stats[1].lookups, 3u);
+		TS_ASSERT_EQUALS(stats[1].misses, 1u);
+
+		set.resetArchiveStats();
+		stats = set.getArchiveStats();
+		TS_ASSERT_EQUALS(stats[1].lookups, 0u);
+	}
+};
@@ -0,0 +1,57 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memstream.h"
+#include "common/trace.h"
+
+class TraceTestSuite : public CxxTest::TestSuite {
+	public:
+	void test_buffer_wrap() {
+		Common::TraceBuffer buffer("test", 2, 4);
+
+		// Nothing is recorded before the buffer has been reset
+		buffer.add("cat", "a", 'B', 1);
+		TS_ASSERT_EQUALS(buffer.getCount(), 0u);
+
+		buffer.reset();
+		for (uint i = 0; i < 6; ++i)
+			buffer.add("cat", "a", (i & 1) ? 'E' : 'B', i);
+
+		TS_ASSERT_EQUALS(buffer.getCount(), 4u);
+		TS_ASSERT_EQUALS(buffer.getDropped(), 2u);
+		TS_ASSERT_EQUALS(buffer.getEvent(0).timestamp, 2u);
+		TS_ASSERT_EQUALS(buffer.getEvent(0).phase, 'B');
+		TS_ASSERT_EQUALS(buffer.getEvent(3).timestamp, 5u);
+		TS_ASSERT_EQUALS(buffer.getEvent(3).phase, 'E');
+
+		buffer.reset();
+		TS_ASSERT_EQUALS(buffer.getCount(), 0u);
+	}
+
+	void test_export_chrome_json() {
+		TraceMan.start();
+		TS_ASSERT(TraceMan.isEnabled());
+
+		Common::TraceBuffer *buffer = TraceMan.getMainBuffer();
+		buffer->add("test", "frame", 'B', 1000);
+		buffer->add("test", "\"quoted\"", 'B', 1010);
+		buffer->add("test", "\"quoted\"", 'E', 1020);
+		buffer->add("test", "frame", 'E', 1500);
+		// More than 71 minutes later, which doesn't fit into 32 bits
+		buffer->add("test", "late", 'B', (uint64)5000000 * 1000 + 1007);
+
+		TraceMan.stop();
+		TS_ASSERT(!TraceMan.isEnabled());
+
+		Common::MemoryWriteStreamDynamic stream(DisposeAfterUse::YES);
+		TraceMan.exportChromeJSON(stream);
+		const Common::String json((const char *)stream.getData(), stream.size());
+
+		TS_ASSERT(json.hasPrefix("{\"traceEvents\":["));
+		TS_ASSERT(json.hasSuffix("]}\n"));
+		TS_ASSERT(json.contains("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"main\"}}"));
+		TS_ASSERT(json.contains("{\"name\":\"frame\",\"cat\":\"test\",\"ph\":\"B\",\"ts\":0,\"pid\":1,\"tid\":1}"));
+		TS_ASSERT(json.contains("{\"name\":\"\\\"quoted\\\"\",\"cat\":\"test\",\"ph\":\"E\",\"ts\":20,\"pid\":1,\"tid\":1}"));
+		TS_ASSERT(json.contains("{\"name\":\"frame\",\"cat\":\"test\",\"ph\":\"E\",\"ts\":500,\"pid\":1,\"tid\":1}"));
+		TS_ASSERT(json.contains("{\"name\":\"late\",\"cat\":\"test\",\"ph\":\"B\",\"ts\":5000000007,\"pid\":1,\"tid\":1}"));
+	}
+};
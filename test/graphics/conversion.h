@@ -0,0 +1,103 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/conversion.h"
+#include "graphics/pixelformat.h"
+
+static const Graphics::PixelFormat conversionTestFormats[] = {
+	Graphics::PixelFormat(2, 5, 6, 5, 0, 11,  5,  0,  0),
+	Graphics::PixelFormat(2, 5, 6, 5, 0,  0,  5, 11,  0),
+	Graphics::PixelFormat(2, 5, 5, 5, 0, 10,  5,  0,  0),
+	Graphics::PixelFormat(2, 5, 5, 5, 1, 10,  5,  0, 15),
+	Graphics::PixelFormat(2, 5, 5, 5, 1, 11,  6,  1,  0),
+	Graphics::PixelFormat(2, 4, 4, 4, 4, 12,  8,  4,  0),
+	Graphics::PixelFormat(4, 8, 8, 8, 0, 16,  8,  0,  0),
+	Graphics::PixelFormat(4, 8, 8, 8, 8, 16,  8,  0, 24),
+	Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16,  8,  0),
+	Graphics::PixelFormat(4, 8, 8, 8, 8,  0,  8, 16, 24),
+	Graphics::PixelFormat(4, 8, 8, 8, 8,  8, 16, 24,  0)
+};
+
+class ConversionTestSuite : public CxxTest::TestSuite {
+	enum {
+		kWidth = 7,
+		kHeight = 5,
+		kPadding = 3
+	};
+
+	static uint32 readPixel(const byte *p, uint bpp) {
+		return (bpp == 2) ? *(const uint16 *)p : *(const uint32 *)p;
+	}
+
+	static void fillSource(byte *buf, uint size) {
+		uint32 seed = 0x12345678;
+		for (uint i = 0; i < size; ++i) {
+			seed = seed * 1103515245 + 12345;
+			buf[i] = seed >> 24;
+		}
+	}
+
+	// Checks every converted pixel against a conversion through the
+	// generic PixelFormat helpers.
+	static bool checkRect(const byte *dst, uint dstPitch, const Graphics::PixelFormat &dstFmt,
+	                      const byte *src, uint srcPitch, const Graphics::PixelFormat &srcFmt) {
+		for (uint y = 0; y < kHeight; ++y) {
+			for (uint x = 0; x < kWidth; ++x) {
+				byte a, r, g, b;
+				srcFmt.colorToARGB(readPixel(src + y * srcPitch + x * srcFmt.bytesPerPixel, srcFmt.bytesPerPixel), a, r, g, b);
+				const uint32 expected = dstFmt.ARGBToColor(a, r, g, b);
+				if (readPixel(dst + y * dstPitch + x * dstFmt.bytesPerPixel, dstFmt.bytesPerPixel) != expected)
+					return false;
+			}
+		}
+		return true;
+	}
+
+public:
+	void test_pitches() {
+		byte src[(kWidth + kPadding) * kHeight * 4];
+		byte dst[(kWidth + kPadding) * kHeight * 4];
+		fillSource(src, sizeof(src));
+
+		for (uint i = 0; i < ARRAYSIZE(conversionTestFormats); ++i) {
+			for (uint j = 0; j < ARRAYSIZE(conversionTestFormats); ++j) {
+				const Graphics::PixelFormat &srcFmt = conversionTestFormats[i];
+				const Graphics::PixelFormat &dstFmt = conversionTestFormats[j];
+
+				// Identical formats are copied verbatim, including unused bits
+				if (srcFmt == dstFmt)
+					continue;
+
+				for (uint padding = 0; padding <= kPadding; padding += kPadding) {
+					const uint srcPitch = (kWidth + padding) * srcFmt.bytesPerPixel;
+					const uint dstPitch = (kWidth + padding) * dstFmt.bytesPerPixel;
+
+					TS_ASSERT(Graphics::crossBlit(dst, src, dstPitch, srcPitch, kWidth, kHeight, dstFmt, srcFmt));
+					TS_ASSERT(checkRect(dst, dstPitch, dstFmt, src, srcPitch, srcFmt));
+				}
+			}
+		}
+	}
+
+	void test_in_place() {
+		byte src[kWidth * kHeight * 4];
+		byte buf[kWidth * kHeight * 4];
+		fillSource(src, sizeof(src));
+
+		for (uint i = 0; i < ARRAYSIZE(conversionTestFormats); ++i) {
+			for (uint j = 0; j < ARRAYSIZE(conversionTestFormats); ++j) {
+				const Graphics::PixelFormat &srcFmt = conversionTestFormats[i];
+				const Graphics::PixelFormat &dstFmt = conversionTestFormats[j];
+
+				// Identical formats are copied verbatim, including unused bits
+				if (srcFmt == dstFmt)
+					continue;
+				const uint srcPitch = kWidth * srcFmt.bytesPerPixel;
+				const uint dstPitch = kWidth * dstFmt.bytesPerPixel;
+
+				memcpy(buf, src, sizeof(buf));
+				TS_ASSERT(Graphics::crossBlit(buf, buf, dstPitch, srcPitch, kWidth, kHeight, dstFmt, srcFmt));
+				TS_ASSERT(checkRect(buf, dstPitch, dstFmt, src, srcPitch, srcFmt));
+			}
+		}
+	}
+};
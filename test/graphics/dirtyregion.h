@@ -0,0 +1,99 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/dirtyregion.h"
+
+class DirtyRegionTestSuite : public CxxTest::TestSuite {
+	// Checks that the rects cover exactly the pixels set in the mask
+	static bool checkCoverage(const Common::Array<Common::Rect> &rects, const bool *mask, int w, int h) {
+		for (int y = 0; y < h; ++y) {
+			for (int x = 0; x < w; ++x) {
+				int count = 0;
+				for (uint i = 0; i < rects.size(); ++i)
+					count += rects[i].contains(x, y) ? 1 : 0;
+				if (count > 1 || (count == 1) != mask[y * w + x])
+					return false;
+			}
+		}
+		return true;
+	}
+
+public:
+	void test_empty() {
+		Graphics::DirtyRegion region(320, 200);
+		TS_ASSERT(region.isEmpty());
+		TS_ASSERT_EQUALS(region.getRects().size(), 0u);
+
+		region.addRect(Common::Rect(400, 10, 500, 20));
+		region.addRect(Common::Rect(10, 10, 10, 20));
+		TS_ASSERT(region.isEmpty());
+	}
+
+	void test_single_rect() {
+		Graphics::DirtyRegion region(320, 200);
+		region.addRect(Common::Rect(5, 7, 20, 9));
+		TS_ASSERT(!region.isEmpty());
+
+		const Common::Array<Common::Rect> &rects = region.getRects();
+		TS_ASSERT_EQUALS(rects.size(), 1u);
+		TS_ASSERT_EQUALS(rects[0], Common::Rect(5, 7, 20, 9));
+	}
+
+	void test_merge_across_tiles() {
+		Graphics::DirtyRegion region(320, 200);
+		region.addRect(Common::Rect(10, 20, 150, 120));
+
+		const Common::Array<Common::Rect> &rects = region.getRects();
+		TS_ASSERT_EQUALS(rects.size(), 1u);
+		TS_ASSERT_EQUALS(rects[0], Common::Rect(10, 20, 150, 120));
+	}
+
+	void test_clip_and_invalidate() {
+		Graphics::DirtyRegion region(320, 200);
+		region.addRect(Common::Rect(-10, -10, 5, 5));
+		TS_ASSERT_EQUALS(region.getRects()[0], Common::Rect(0, 0, 5, 5));
+
+		region.addRect(Common::Rect(-1, -1, 400, 300));
+		TS_ASSERT(region.isFullyDirty());
+		TS_ASSERT_EQUALS(region.getRects().size(), 1u);
+		TS_ASSERT_EQUALS(region.getRects()[0], Common::Rect(320, 200));
+
+		region.clear();
+		TS_ASSERT(region.isEmpty());
+		TS_ASSERT(!region.isFullyDirty());
+		TS_ASSERT_EQUALS(region.getRects().size(), 0u);
+	}
+
+	void test_coverage() {
+		// Area not a multiple of the tile size
+		const int w = 100, h = 70;
+		Graphics::DirtyRegion region(w, h);
+		bool mask[w * h];
+		memset(mask, 0, sizeof(mask));
+
+		const Common::Rect added[] = {
+			Common::Rect(0, 0, 3, 3),
+			Common::Rect(31, 31, 33, 33),
+			Common::Rect(60, 40, 100, 70),
+			Common::Rect(90, 2, 95, 4)
+		};
+
+		for (uint i = 0; i < ARRAYSIZE(added); ++i)
+			region.addRect(added[i]);
+
+		// The tiles grow to the bounding boxes of their parts
+		const Common::Array<Common::Rect> &rects = region.getRects();
+		for (uint i = 0; i < rects.size(); ++i)
+			for (int y = rects[i].top; y < rects[i].bottom; ++y)
+				for (int x = rects[i].left; x < rects[i].right; ++x)
+					mask[y * w + x] = true;
+
+		for (uint i = 0; i < ARRAYSIZE(added); ++i)
+			for (int y = added[i].top; y < added[i].bottom; ++y)
+				for (int x = added[i].left; x < added[i].right; ++x)
+					TS_ASSERT(mask[y * w + x]);
+
+		TS_ASSERT(checkCoverage(rects, mask, w, h));
+		TS_ASSERT(rects[rects.size() - 1].bottom <= h);
+		TS_ASSERT(rects[rects.size() - 1].right <= w);
+	}
+};
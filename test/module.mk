@@ -5,8 +5,8 @@
 #
 ######################################################################
 
-TESTS        := $(srcdir)/test/common/*.h $(srcdir)/test/audio/*.h
-TEST_LIBS    := audio/libaudio.a common/libcommon.a
+TESTS        := $(srcdir)/test/common/*.h $(srcdir)/test/audio/*.h $(srcdir)/test/graphics/*.h
+TEST_LIBS    := audio/libaudio.a graphics/libgraphics.a common/libcommon.a
 
 #
 TEST_FLAGS   := --runner=StdioPrinter --no-std --no-eh --include=$(srcdir)/test/cxxtest_mingw.h
@@ -34,9 +34,55 @@ test/runner.cpp: $(TESTS)
 	@mkdir -p test
 	$(srcdir)/test/cxxtest/cxxtestgen.py $(TEST_FLAGS) -o $@ $+
 
+# Micro benchmarks, run them with e.g.
+# make bench BENCH_FLAGS="--json --filter=audio/"
+BENCH_SRCS   := $(srcdir)/test/bench/bench.cpp $(srcdir)/test/bench/common.cpp \
+                $(srcdir)/test/bench/graphics.cpp $(srcdir)/test/bench/audio.cpp \
+                $(srcdir)/test/bench/opl.cpp
+
+bench: test/bench/bench
+	./test/bench/bench $(BENCH_FLAGS)
+test/bench/bench: $(BENCH_SRCS) $(TEST_LIBS)
+	@mkdir -p test/bench
+	$(QUIET_LINK)$(CXX) $(TEST_CXXFLAGS) $(CPPFLAGS) -o $@ $+ $(TEST_LDFLAGS)
+
+# Read throughput of the stdio and the memory mapped file streams, e.g.
+# make bench-fs BENCH_FILE=/path/to/some/large/file
+bench-fs: test/bench/fs-stream
+	./test/bench/fs-stream $(BENCH_FILE)
+test/bench/fs-stream: $(srcdir)/test/bench/fs-stream.cpp backends/libbackends.a common/libcommon.a
+	@mkdir -p test/bench
+	$(QUIET_LINK)$(CXX) $(TEST_CXXFLAGS) $(CPPFLAGS) -o $@ $+ $(TEST_LDFLAGS)
+
+# Throughput of Graphics::crossBlit for common pixel format pairs
+bench-crossblit: test/bench/crossblit
+	./test/bench/crossblit
+test/bench/crossblit: $(srcdir)/test/bench/crossblit.cpp graphics/libgraphics.a common/libcommon.a
+	@mkdir -p test/bench
+	$(QUIET_LINK)$(CXX) $(TEST_CXXFLAGS) $(CPPFLAGS) -o $@ $+ $(TEST_LDFLAGS)
+
+# Renders an OPL register dump recorded with --opl-capture, e.g.
+# make opl-replay OPL_DUMP=adlib0.opl OPL_WAV=adlib0.wav
+opl-replay: test/bench/opl-replay
+	./test/bench/opl-replay $(OPL_DUMP) $(OPL_WAV)
+test/bench/opl-replay: $(srcdir)/test/bench/opl-replay.cpp audio/libaudio.a common/libcommon.a
+	@mkdir -p test/bench
+	$(QUIET_LINK)$(CXX) $(TEST_CXXFLAGS) $(CPPFLAGS) -o $@ $+ $(TEST_LDFLAGS)
+
+# Render speed of the MT-32 emulator playing a capture of a game's MIDI output,
+# e.g. make mt32-render MT32_ROMS=/path/to/roms MT32_MIDI=intro.mid MT32_WAV=intro.wav
+# MT32_FLAGS=--compare also checks that the block rendering matches rendering
+# one sample at a time.
+mt32-render: test/bench/mt32-render
+	./test/bench/mt32-render $(MT32_FLAGS) $(MT32_ROMS) $(MT32_MIDI) $(MT32_WAV)
+test/bench/mt32-render: $(srcdir)/test/bench/mt32-render.cpp audio/softsynth/mt32/libmt32.a audio/libaudio.a common/libcommon.a
+	@mkdir -p test/bench
+	$(QUIET_LINK)$(CXX) $(TEST_CXXFLAGS) $(CPPFLAGS) -o $@ $+ $(TEST_LDFLAGS)
+
 
 clean: clean-test
 clean-test:
-	-$(RM) test/runner.cpp test/runner
+	-$(RM) test/runner.cpp test/runner test/bench/bench test/bench/fs-stream test/bench/crossblit \
+	        test/bench/opl-replay test/bench/mt32-render
 
-.PHONY: test clean-test
+.PHONY: test bench bench-fs bench-crossblit opl-replay mt32-render clean-test
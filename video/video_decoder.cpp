@@ -27,6 +27,7 @@
 
 #include "common/rational.h"
 #include "common/file.h"
+#include "common/perfcounters.h"
 #include "common/system.h"
 
 #include "graphics/palette.h"
@@ -166,6 +167,8 @@ Graphics::PixelFormat VideoDecoder::getPixelFormat() const {
 }
 
 const Graphics::Surface *VideoDecoder::decodeNextFrame() {
+	Common::PerfTimer timer(Common::kPerfVideoDecode);
+
 	_needsUpdate = false;
 
 	readNextPacket();